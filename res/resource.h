@@ -13,6 +13,19 @@
 #define IDC_EDIT_LINE_SEGM_COUNT        1005
 #define IDC_STATIC_HELP_CONTROLS        1005
 #define IDC_HELP_CONTROLS               1005
+#define IDC_EDIT_FRAME_RATE             1006
+#define IDC_EDIT_EVAL_FRAME_RATE        1007
+#define IDC_CHECK_PROGRESSIVE           1008
+#define IDC_CHECK_EQUIPOTENTIALS        1009
+#define IDC_EDIT_LINE_SPACING           1010
+#define IDC_CHECK_EVEN_SPACING          1011
+#define IDC_CHECK_FLUX_SEEDING          1012
+#define IDC_CHECK_SINK_SEEDING          1013
+#define IDC_CHECK_SYMMETRY              1014
+#define IDC_CHECK_PERIODIC              1015
+#define IDC_EDIT_CELL_W                 1016
+#define IDC_EDIT_CELL_H                 1017
+#define IDC_CHECK_DETERMINISTIC         1018
 #define ID_SETTINGS                     40001
 #define ID_HELP                         40002
 #define ID_EXIT                         40003
@@ -27,14 +40,30 @@
 #define ID_SCENE_LOADADD                40012
 #define ID_SCENE_CLEAR                  40013
 #define ID_SCENE_SCREENSHOT             40014
+#define ID_EDIT_UNDO                    40019
+#define ID_EDIT_REDO                    40020
+#define IDM_MAIN_MENU_STATISTICS        40021
+#define IDM_MAIN_MENU_BENCHMARK         40022
+#define ID_SCENE_HEATMAP                40023
+#define ID_SCENE_EXPORT_HEATMAP         40024
+#define ID_SCENE_LIC                    40025
+#define ID_SCENE_EXPORT_LIC             40026
+#define ID_SCENE_BOUNDARY_LINE          40027
+#define ID_SCENE_BOUNDARY_CIRCLE        40028
+#define ID_SCENE_BOUNDARY_REMOVE        40029
+#define ID_SCENE_ADD_SEGMENT            40030
+#define ID_SCENE_ADD_ARC                40031
+#define ID_SCENE_ADD_DISK               40032
+#define ID_SCENE_ADD_DIPOLE             40033
+#define ID_SCENE_ADD_QUADRUPOLE         40034
 
 // Next default values for new objects
 // 
 #ifdef APSTUDIO_INVOKED
 #ifndef APSTUDIO_READONLY_SYMBOLS
 #define _APS_NEXT_RESOURCE_VALUE        110
-#define _APS_NEXT_COMMAND_VALUE         40019
-#define _APS_NEXT_CONTROL_VALUE         1006
+#define _APS_NEXT_COMMAND_VALUE         40035
+#define _APS_NEXT_CONTROL_VALUE         1019
 #define _APS_NEXT_SYMED_VALUE           101
 #endif
 #endif
@@ -1,7 +1,7 @@
 /* FILE NAME   : 'anim.cpp'
  * PURPOSE     : Animation module implementation file.
  * PROGRAMMER  : Fedor Borodulin.
- * LAST UPDATE : 10.04.2023.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : Module namespace 'prj'.
  */
 
@@ -17,23 +17,66 @@ namespace prj
   anim::anim( void )
   {
     /* Get time frequency */
-    QueryPerformanceFrequency((LARGE_INTEGER *)&RenderTimeFreq);
+    QueryPerformanceFrequency((LARGE_INTEGER *)&TimeFreq);
 
     /* Configure threads pool */
     ThreadsPool.SetFunction([this]( thread_data *Data ) -> bool
       {
-        if (Data->LineData->size() >= Data->LineData->capacity())
-          return true;
+        if (Data->LineData->size() < Data->LineData->capacity())
+        {
+          const auto &Pt {Data->LineData->emplace_back(Data->IsCoarse ? Data->LineEval.Next1() : Data->LineEval.Next3())};
 
-        Data->LineData->emplace_back(Data->LineEval.Next3());
+          /* Evenly spaced line stops near other line, seeded lines are traced only inside region of interest */
+          if (Data->SpacingId != 0 && Data->LineEval.Continue)
+          {
+            if (!Spacing.Mark(Pt, Data->SpacingId))
+            {
+              Data->LineEval.Continue = false;
+              Data->LineEval.Reason = phys::line_end::Separation;
+            }
+            else if (!Data->Source.IsValid() && !EvalRoi.IsInside(Pt))
+              Data->LineEval.Continue = false;
+          }
 
-        if (Data->LineEval.Continue)
-        {
-          ThreadsDataUpdated = true;
-          return false;
+          /* Far field ray end is doubled to keep last bezier segment straight */
+          if (Data->LineEval.Reason == phys::line_end::FarField && Data->LineData->size() < Data->LineData->capacity())
+            Data->LineData->push_back(Pt);
+
+          /* Suspend full precision line out of region of interest (evaluation state is saved),
+           * far field rays are suspended on region bounds to be extended after frame move.
+           * Lines from negative charges are reversed after tracing and replicated lines are transformed,
+           * so they are never suspended. Lattice lines are drawn in all visible cells, so they are traced completely */
+          if (!Data->IsCoarse && Data->Source.IsValid() && !Data->IsSink && Symmetry.GetOrder() == 1 &&
+              Periodic == nullptr &&
+              ((Data->LineEval.Continue && !EvalRoi.IsInside(Pt)) || Data->LineEval.Reason == phys::line_end::FarField))
+          {
+            std::lock_guard<std::mutex> Lock {SuspendMutex};
+
+            RegisterLineEnd(*Data);
+            Data->IsRay = Data->LineEval.Reason == phys::line_end::FarField;
+            Data->LineEval.Resume();
+            SuspendQueue.push_back(*Data);
+            ThreadsDataUpdated = true;
+            Scheduler.Notify();
+            return true;
+          }
+
+          if (Data->LineEval.Continue)
+          {
+            /* Wake main loop once per rendered frame */
+            if (!ThreadsDataUpdated.load(std::memory_order_relaxed) && !ThreadsDataUpdated.exchange(true))
+              Scheduler.Notify();
+            return false;
+          }
         }
-        else
-          return true;
+
+        /* Line is finished - main loop may store results */
+        if (Data->LineEval.Continue)
+          Data->LineEval.Reason = phys::line_end::Length;
+        RegisterLineEnd(*Data);
+
+        Scheduler.Notify();
+        return true;
       });
 
     /* Launch window */
@@ -44,7 +87,8 @@ namespace prj
   /* Animation default destructor */
   anim::~anim( void )
   {
-    // Nothing for manual delete
+    /* Threads use members declared after pool, so they are stopped before any member destruction */
+    ThreadsPool.Terminate();
   } /* End of destructor */
 
   /* Window creation callback.
@@ -86,6 +130,9 @@ namespace prj
 
       OldW = win::W, OldH = win::H;
     }
+
+    /* Main loop is not running during window sizing, so redraw here */
+    Render();
   } /* End of 'anim::Resize' function */
 
   /* Window closing callback.
@@ -97,6 +144,9 @@ namespace prj
   {
     WasInit = FALSE;
 
+    /* Stop lines tracing */
+    ThreadsPool.Terminate();
+
     return TRUE;
   } /* End of 'anim::Close' function */
 
@@ -107,8 +157,11 @@ namespace prj
     ThreadsPool.Terminate();
     ThreadsDataUpdated = TRUE;
 
-    /* Clear charges pool */
-    Charges.clear();
+    /* Clear charges pool, lines and boundary */
+    Charges.Clear();
+    ChargeLines.Clear();
+    SelectedCharge = {};
+    Boundary = {};
   } /* End of 'anim::ClearScene' function */
 
   /* Charge adding function
@@ -118,13 +171,36 @@ namespace prj
    */
   void anim::AddCharge( coordd Coord )
   {
-    Charges.push_back({Coord, MinCharge, MinChargeSize});
-    SelectedCharge = &Charges.back();
+    /* Threads use charges pool, so stop them before change */
+    ThreadsPool.Terminate();
+    SelectedCharge = Charges.Add({Coord, MinCharge, MinChargeSize});
+    ChargeGrab = {0, 0};
     InputState = input_state::Charge;
 
     SetReevaluation();
   } /* End of 'anim::AddCharge' function */
 
+  /* Extended charge source adding function (source is placed in frame center).
+   * ARGUMENTS:
+   *   - Source type:
+   *       phys::source_type Type;
+   */
+  void anim::AddSource( phys::source_type Type )
+  {
+    const bool IsMulti {Type == phys::source_type::Dipole || Type == phys::source_type::Quadrupole};
+    phys::source_shape Shape {Type, IsMulti ? 0 : (Right - Left) / 8};
+
+    /* Arc is upper half circle */
+    if (Type == phys::source_type::Arc)
+      Shape.Angle = M_PI / 2, Shape.Sweep = M_PI / 2;
+
+    /* Threads use charges pool, so stop them before change */
+    ThreadsPool.Terminate();
+    Charges.Add({{(Left + Right) / 2, (Top + Bottom) / 2}, 10, IsMulti ? MinChargeSize : MinChargeSize * 0.5, Shape});
+
+    SetReevaluation();
+  } /* End of 'anim::AddSource' function */
+
   /* Charge at position selecting
    * ARGUMENTS:
    *   - Charge position:
@@ -134,23 +210,27 @@ namespace prj
    */
   bool anim::SelectCharge( coordd Coord )
   {
-    SelectedCharge = nullptr;
+    SelectedCharge = {};
+
+    /* Picking radius (square root of size) never exceeds charge reach (doubled size) by more than 1/8 */
+    std::vector<size_t> Near {};
 
-    for (auto &Elm : Charges)
+    Charges.FindNear(Coord, 0.125, Near);
+    for (const size_t i : Near)
     {
+      const auto &Elm {Charges[i]};
       const auto Size = Elm.Size;
-      const dbl
-        DX {Elm.Coord.X - Coord.X},
-        DY {Elm.Coord.Y - Coord.Y};
+      const dbl Dist {phys::SourceDistance(Elm, Coord)};
 
-      if (DX * DX + DY * DY <= Size)
+      if (Dist * Dist <= Size)
       {
-        SelectedCharge = &Elm;
+        SelectedCharge = Charges.Handle(i);
+        ChargeGrab = {Elm.Coord.X - Coord.X, Elm.Coord.Y - Coord.Y};
         break;
       }
     }
 
-    bool Found = SelectedCharge != nullptr;
+    bool Found = SelectedCharge.IsValid();
 
     InputState = Found ? input_state::Charge : input_state::None;
     return Found;
@@ -167,6 +247,41 @@ namespace prj
       AddCharge(Coord);
   } /* End of 'anim::SelectAddCharge' function */
 
+  /* Grounded conductor boundary near position selecting function.
+   * ARGUMENTS:
+   *   - Cursor position:
+   *       coordd Coord;
+   * RETURNS:
+   *   (bool) true if boundary is grabbed.
+   */
+  bool anim::SelectBoundary( coordd Coord )
+  {
+    /* Boundary is grabbed within few pixels from it */
+    const dbl Tolerance {(Right - Left) / W * 6};
+
+    if (IsPeriodic || !Boundary.IsValid() || abs(Boundary.Distance(Coord)) > Tolerance)
+      return false;
+
+    BoundaryGrab = {Boundary.Point.X - Coord.X, Boundary.Point.Y - Coord.Y};
+    InputState = input_state::Boundary;
+    return true;
+  } /* End of 'anim::SelectBoundary' function */
+
+  /* Grounded conductor boundary setting function (none - boundary is removed).
+   * ARGUMENTS:
+   *   - New boundary:
+   *       const phys::boundary &NewBoundary;
+   */
+  void anim::SetBoundary( const phys::boundary &NewBoundary )
+  {
+    if (NewBoundary == Boundary)
+      return;
+
+    /* Evaluators use boundary copy made at evaluation start, so threads are not stopped here */
+    Boundary = NewBoundary;
+    Reeval = TRUE;
+  } /* End of 'anim::SetBoundary' function */
+
   /* Reevaluation setting function */
   void anim::SetReevaluation( void )
   {
@@ -180,14 +295,171 @@ namespace prj
     }
   } /* End of 'anim::SetReevaluation' function */
 
+  /* Current scene committing to history function */
+  void anim::CommitHistory( void )
+  {
+    History.Commit(Charges, Boundary);
+  } /* End of 'anim::CommitHistory' function */
+
+  /* Scene restoring from history function
+   * ARGUMENTS:
+   *   - Stored scene state (may be nullptr):
+   *       const scene_history::scene_state *State;
+   */
+  void anim::RestoreHistory( const scene_history::scene_state *State )
+  {
+    if (State == nullptr)
+      return;
+
+    /* Threads use charges pool, so stop them before change */
+    ThreadsPool.Terminate();
+
+    Charges.Clear();
+    ChargeLines.Clear();
+    for (const auto &Elm : State->Charges)
+      Charges.Add({Elm->Coord, Elm->Charge, Elm->Size, Elm->Shape});
+    Boundary = State->Boundary;
+
+    SelectedCharge = {};
+    InputState = input_state::None;
+
+    SetReevaluation();
+  } /* End of 'anim::RestoreHistory' function */
+
+  /* Evaluation statistics text getting function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (std::string) Statistics report.
+   */
+  std::string anim::GetStatistics( void ) const
+  {
+    const auto &CacheStats {LinesCache.GetStats()};
+    const auto [UndoDepth, RedoDepth] {History.GetDepth()};
+    const auto &FrameStats {Scheduler.GetStats()};
+    const auto [FrameRate, EvalFrameRate] {Scheduler.GetFrameRates()};
+    const auto &ContoursStats {Contours.GetStats()};
+    const auto &HeatmapStats {Heatmap.GetStats()};
+    const auto &LicStats {Lic.GetStats()};
+    const auto &SpacingStats {Spacing.GetStats()};
+    static const CHAR *HeatmapModes[(UINT)phys::heatmap_mode::Count] {"off", "field length", "potential"};
+    size_t RealTerms {0}, ReciprocalTerms {0};
+    CHAR Buf[0x1400];
+
+    if (Periodic != nullptr)
+      Periodic->GetTerms(RealTerms, ReciprocalTerms);
+
+    /* Lines termination statistics by reason */
+    auto Ends = [this]( phys::line_end Reason ) -> size_t
+      {
+        return LineEnds[(size_t)Reason].load();
+      };
+    auto AvgSteps = [this]( phys::line_end Reason ) -> dbl
+      {
+        const size_t Cnt {LineEnds[(size_t)Reason].load()};
+
+        return Cnt == 0 ? 0.0 : (dbl)LineSteps[(size_t)Reason].load() / Cnt;
+      };
+    size_t TotalSteps {0};
+
+    for (const auto &Steps : LineSteps)
+      TotalSteps += Steps.load();
+
+    sprintf(Buf,
+            "Lines cache:\n"
+            "  - Hits: %zu, misses: %zu (hit rate %.1f%%)\n"
+            "  - Entries: %zu, evictions: %zu\n"
+            "  - Memory held: %.2f MB\n"
+            "\nHistory:\n"
+            "  - Undo steps: %zu, redo steps: %zu\n"
+            "\nFrames (target %.0f fps interactive, %.0f fps evaluation):\n"
+            "  - Rendered: %zu, render time avg %.2f ms, max %.2f ms\n"
+            "  - Interval between frames avg %.2f ms\n"
+            "  - Wakeups: input %zu, work %zu (of %zu notifications), timer %zu\n"
+            "  - Idle (zero CPU) waits: %zu\n"
+            "\nProgressive evaluation (%s, every %zu line coarse):\n"
+            "  - Time to first lines: last %.2f ms, avg %.2f ms, max %.2f ms\n"
+            "  - Edits: %zu, over %.0f ms budget: %zu\n"
+            "\nRegion of interest tracing:\n"
+            "  - Suspended lines: %zu (in %zu tiles), resumed: %zu, region moves: %zu\n"
+            "\nLines termination (lines / average steps), null points: %zu:\n"
+            "  - Negative charge: %zu / %.0f, far field ray: %zu / %.0f\n"
+            "  - Null point: %zu / %.0f, stall: %zu / %.0f\n"
+            "  - Points limit: %zu / %.0f, left region: %zu / %.0f\n"
+            "  - Too close to other line: %zu / %.0f, grounded boundary: %zu / %.0f\n"
+            "  - Total steps: %zu\n"
+            "\nSeeds placement (%s): last %.3f ms\n"
+            "  - Steps by strategy: positive charges %zu, negative charges %zu, evenly spaced %zu\n"
+            "  - Negative charges lines (%s): seeds %zu, matched to arrived lines %zu, duplicates dropped %zu\n"
+            "\nSymmetry replication (%s): last scene group order %zu (%d-fold rotations, %s)\n"
+            "  - Symmetric scenes: %zu, lines traced %zu, replicated %zu\n"
+            "\nPeriodic cell (%s, %.2f x %.2f):\n"
+            "  - Ewald sum builds: %zu, last %.3f ms, terms per point: %zu short range + %zu long range\n"
+            "\nEvenly spaced lines (%s, separation %.3f):\n"
+            "  - Seeded lines: %zu (of %zu candidates) in %zu rounds\n"
+            "\nEquipotential lines (%s):\n"
+            "  - Updates: full %zu, single charge %zu, last %.2f ms\n"
+            "  - Samples: %zu, segments: %zu, polylines: %zu\n"
+            "\nHeatmap (%s):\n"
+            "  - Passes: %zu, tiles refined: %zu, tiles reused on pan: %zu\n"
+            "  - Pixels evaluated: %zu, last pass %.2f ms\n"
+            "\nLIC texture (%s, target %.0f ms, resolution 1/%d):\n"
+            "  - Updates: %zu, last %.2f ms (field %.2f ms, convolution %.2f ms)\n"
+            "  - Pixels: %zu, streamlines: %zu\n",
+            CacheStats.Hits, CacheStats.Misses, CacheStats.HitRate() * 100,
+            CacheStats.Entries, CacheStats.Evictions,
+            CacheStats.Bytes / (1024.0 * 1024.0),
+            UndoDepth, RedoDepth,
+            FrameRate, EvalFrameRate,
+            FrameStats.Frames, FrameStats.FrameTimeAvg, FrameStats.FrameTimeMax,
+            FrameStats.FrameIntervalAvg,
+            FrameStats.InputWakeups, FrameStats.WorkWakeups, FrameStats.Notifications, FrameStats.TimerWakeups,
+            FrameStats.IdleWaits,
+            Progressive ? "on" : "off", CoarseLinesDiv,
+            ProgressiveStats.FirstLinesLast, ProgressiveStats.FirstLinesAvg, ProgressiveStats.FirstLinesMax,
+            ProgressiveStats.Edits, FirstLinesBudget, ProgressiveStats.OverBudget,
+            RoiStats.Suspended, SuspendedTiles.size() + SuspendedRays.size(), RoiStats.Resumed, RoiStats.Moves,
+            Nulls.size(),
+            Ends(phys::line_end::Charge), AvgSteps(phys::line_end::Charge),
+            Ends(phys::line_end::FarField), AvgSteps(phys::line_end::FarField),
+            Ends(phys::line_end::Null), AvgSteps(phys::line_end::Null),
+            Ends(phys::line_end::Stall), AvgSteps(phys::line_end::Stall),
+            Ends(phys::line_end::Length), AvgSteps(phys::line_end::Length),
+            Ends(phys::line_end::None), AvgSteps(phys::line_end::None),
+            Ends(phys::line_end::Separation), AvgSteps(phys::line_end::Separation),
+            Ends(phys::line_end::Boundary), AvgSteps(phys::line_end::Boundary), TotalSteps,
+            FluxSeeding ? "flux weighted" : "uniform angles", SeedingTime,
+            StrategySteps[0].load(), StrategySteps[1].load(), StrategySteps[2].load(),
+            SinkSeeding ? "on" : "off", SinksStats.Seeds, SinksStats.Matched, SinksStats.Duplicates,
+            SymmetryReplication ? "on" : "off", Symmetry.GetOrder(), Symmetry.Rotations, Symmetry.HasReflections ? "mirrors" : "no mirrors",
+            SymmetryStats.Scenes, SymmetryStats.Traced, SymmetryStats.Replicated,
+            Periodic != nullptr ? "on" : "off", CellW, CellH,
+            PeriodicStats.Builds, PeriodicStats.BuildTime, RealTerms, ReciprocalTerms,
+            EvenSpacing ? "on" : "off", Spacing.GetSeparation(),
+            SpacingStats.Seeds, SpacingStats.Candidates, SeedRounds,
+            DrawEquipotentials ? "on" : "off",
+            ContoursStats.FullUpdates, ContoursStats.IncrementalUpdates, ContoursStats.LastTime,
+            ContoursStats.Samples, ContoursStats.Segments, ContoursStats.Polylines,
+            HeatmapModes[(UINT)Heatmap.GetMode()],
+            HeatmapStats.Passes, HeatmapStats.TilesEvaluated, HeatmapStats.TilesReused,
+            HeatmapStats.Pixels, HeatmapStats.LastTime,
+            LicMode ? "on" : "off", LicFrameBudget, std::max(LicScale, 1),
+            LicStats.Updates, LicStats.LastTime, LicStats.FieldTime, LicStats.ConvolutionTime,
+            LicStats.Pixels, LicStats.Streamlines);
+
+    return Buf;
+  } /* End of 'anim::GetStatistics' function */
+
   /* Animation state responce function */
   void anim::Responce( void )
   {
     if (!WasInit)
       return;
 
-    /* Check window client area */
+    Input.InputResponce();
+
+    /* Check window client area (only on clicks and wheel) */
     BOOL IsClientArea {false};
+    if (Input.KeysClick[VK_LBUTTON] || Input.KeysClick[VK_RBUTTON] || Input.Mdz != 0)
     {
       POINT pt;
       GetCursorPos(&pt);
@@ -197,8 +469,6 @@ namespace prj
         IsClientArea = true;
     }
 
-    Input.InputResponce();
-
     if (Input.Keys[VK_MENU] && Input.KeysClick['\r'])
       FlipFullScreen();
 
@@ -215,8 +485,8 @@ namespace prj
         {
           if (Input.Keys[VK_CONTROL])
             SelectAddCharge({MX, MY});
-          else
-            SelectCharge({MX, MY});
+          else if (!SelectCharge({MX, MY}))
+            SelectBoundary({MX, MY});
 
           break;
         }
@@ -236,8 +506,18 @@ namespace prj
     case prj::anim::input_state::Charge:
       if (Input.KeysUnclick[VK_LBUTTON])
       {
-        SelectedCharge = nullptr;
+        SelectedCharge = {};
         InputState = input_state::None;
+
+        /* Charge editing is finished */
+        CommitHistory();
+      }
+      break;
+    case prj::anim::input_state::Boundary:
+      if (Input.KeysUnclick[VK_LBUTTON])
+      {
+        InputState = input_state::None;
+        CommitHistory();
       }
       break;
     default:
@@ -293,42 +573,105 @@ namespace prj
     case prj::anim::input_state::Charge:
       if (Input.KeysClick[VK_DELETE])
       {
-        Charges.remove_if([&]( const phys::charge &Ref ) -> bool { return &Ref == SelectedCharge; });
+        /* Threads use charges pool, so stop them before change */
+        ThreadsPool.Terminate();
+        Charges.Remove(SelectedCharge);
 
-        SelectedCharge = nullptr;
+        SelectedCharge = {};
         InputState = input_state::None;
+        CommitHistory();
 
         Reeval = TRUE;
         break;
       }
 
-      if (Input.Mdz)
+      /* Charge is edited by copy, pool keeps its kernels mirror in sync on change */
+      if (Charges.Get(SelectedCharge) == nullptr)
+      {
+        InputState = input_state::None;
+        break;
+      }
+
       {
-        auto Old {SelectedCharge->Charge}, New {Old + Input.Mdz * 0.25};
-        const auto Min {std::copysign(MinCharge, Old)};
+        phys::charge Elm {*Charges.Get(SelectedCharge)};
+        bool IsChanged {false};
+
+        /* Wheel with Ctrl scales extended source, with Shift rotates it or multipole axis (by 15 degrees) */
+        if (Input.Mdz && phys::IsExtended(Elm) &&
+            ((Input.Keys[VK_CONTROL] && !phys::IsMultipole(Elm)) || Input.Keys[VK_SHIFT]))
+        {
+          auto &Shape {Elm.Shape};
+
+          if (Input.Keys[VK_CONTROL] && !Input.Keys[VK_SHIFT])
+            Shape.Extent = std::max(Shape.Extent * pow(1.1, Input.Mdz), Elm.Size * 2);
+          else
+            Shape.Angle = remainder(Shape.Angle + Input.Mdz * M_PI / 12, 2 * M_PI);
 
-        if (std::signbit(Old) != std::signbit(New - Min))
-          New = -Min;
+          IsChanged = true;
+        }
+        else if (Input.Mdz)
+        {
+          auto Old {Elm.Charge}, New {Old + Input.Mdz * 0.25};
+          const auto Min {std::copysign(MinCharge, Old)};
+
+          /* Multipole moment sign is its axis direction, so it is kept (axis is rotated instead) */
+          if (phys::IsMultipole(Elm))
+            New = std::signbit(Old) == std::signbit(New - Min) ? New : Min;
+          else if (std::signbit(Old) != std::signbit(New - Min))
+            New = -Min;
+
+          if (Old != New)
+          {
+            Elm.Charge = New;
+
+            /* Extended source thickness does not depend on its total charge */
+            if (!phys::IsExtended(Elm))
+              Elm.Size = pow(abs(New), SizePow) * SizeCoeff;
 
-        if (Old != New)
+            IsChanged = true;
+          }
+        }
+
+        if (MX + ChargeGrab.X != Elm.Coord.X ||
+            MY + ChargeGrab.Y != Elm.Coord.Y)
         {
-          SelectedCharge->Charge = New;
-          SelectedCharge->Size = pow(abs(New), SizePow) * SizeCoeff;
+          if (Input.Keys['A'])
+            Elm.Coord = {round((MX + ChargeGrab.X) * 1.) * 1.,
+                         round((MY + ChargeGrab.Y) * 1.) * 1.};
+          else
+            Elm.Coord = {MX + ChargeGrab.X, MY + ChargeGrab.Y};
 
-          Reeval = TRUE;
+          IsChanged = true;
         }
+
+        if (IsChanged)
+          Charges.Set(SelectedCharge, Elm), Reeval = TRUE;
+      }
+      break;
+    case prj::anim::input_state::Boundary:
+      if (Input.KeysClick[VK_DELETE])
+      {
+        SetBoundary({});
+        InputState = input_state::None;
+        CommitHistory();
+        break;
       }
 
-      if (MX != SelectedCharge->Coord.X ||
-          MY != SelectedCharge->Coord.Y)
       {
-        if (Input.Keys['A'])
-          SelectedCharge->Coord = {round(MX * 1.) * 1.,
-                                   round(MY * 1.) * 1.};
-        else
-          SelectedCharge->Coord = {MX, MY};
+        phys::boundary New {Boundary};
 
-        Reeval = TRUE;
+        /* Wheel rotates line (by 15 degrees) or scales circle */
+        if (Input.Mdz != 0 && New.Type == phys::boundary_type::Line)
+        {
+          const dbl Angle {atan2(New.Normal.Y, New.Normal.X) + Input.Mdz * M_PI / 12};
+
+          New = phys::boundary::Line(New.Point, {cos(Angle), sin(Angle)});
+        }
+        else if (Input.Mdz != 0)
+          New.Radius *= pow(1.1, Input.Mdz);
+
+        New.Point = {MX + BoundaryGrab.X, MY + BoundaryGrab.Y};
+        SetBoundary(New);
       }
       break;
     default:
@@ -336,60 +679,37 @@ namespace prj
     }
 
     if (Reeval)
-    {
-      /* Stop all threads */
-      ThreadsPool.Terminate();
+      Evaluate();
 
-      /* Init lines */
-      for (auto &Elm : Charges)
-      {
-        Elm.Lines.clear();
-
-        if (Elm.Charge < 0)
-          continue;
+    Reeval = FALSE;
 
-        dbl CntF {round(LinesPerCharge * abs(Elm.Charge))};
-        size_t Cnt {(size_t)CntF};
-        Elm.Lines.reserve(Cnt);
+    /* Switch evaluation passes and store finished results */
+    UpdateEvaluation();
 
-        for (int i = 0; i < Cnt; i++)
-        {
-          dbl Angle {(M_PI * (i << 1)) / CntF};
-          coordd Base {Elm.Coord.X + Elm.Size * cos(Angle) * 2.0,
-                       Elm.Coord.Y + Elm.Size * sin(Angle) * 2.0};
+    /* Resume suspended lines if frame is moved out of region of interest */
+    UpdateRoi();
 
-          auto &Line {Elm.Lines.emplace_back()};
+    /* Update background texture or refine heatmap */
+    UpdateLic();
+    UpdateHeatmap();
 
-          Line.reserve(LineEvalLength);
-          Line.push_back(coordf {(flt)Elm.Coord.X, (flt)Elm.Coord.Y});
-          Line.push_back(coordf {(flt)Base.X, (flt)Base.Y});
+    /* Trace lines in current frame first (threads are restarted only if frame or selection changed priorities) */
+    if (EvalPass != eval_pass::Done)
+      UpdatePriorities();
 
-          ThreadsPool.AddTask(phys::ef_force_line {Base, LineLengthCoeff, Charges}, &Line);
-        }
-      }
+    /* Input is polled with frame rate only while mouse drags something or wheel is scrolled
+     * (selected, but not moved charge or boundary waits for input messages) */
+    const bool IsDragging {(Input.Mdx != 0 || Input.Mdy != 0) &&
+                           ((InputState == input_state::Move && Input.Keys[VK_RBUTTON]) ||
+                            ((InputState == input_state::Charge || InputState == input_state::Boundary) && Input.Keys[VK_LBUTTON]))};
 
-      /* Start threads */
-      ThreadsPool.Run();
-
-      ThreadsDataUpdated = true;
-      Redraw = true;
-    }
-
-    Reeval = FALSE;
-
-    /* Not more 24 frames per second can be rendered */
-    UINT64 Time;
-    QueryPerformanceCounter((LARGE_INTEGER *)&Time);
+    IsInteractive = IsDragging || Input.Mdz != 0;
 
+    /* Frames are rendered only if something changed and not more often than target frame rate */
     Redraw = Redraw || ThreadsDataUpdated;
 
-    if (24 * (Time - RenderTime) >= RenderTimeFreq)
-    {
+    if (Redraw && Scheduler.IsFrameTime(IsInteractive))
       Render();
-
-      Redraw = FALSE;
-      RenderTime = Time;
-    }
   } /* End of 'anim::Responce' function */
 
   /* Render function */
@@ -398,40 +718,207 @@ namespace prj
     if (!WasInit)
       return;
 
+    Scheduler.FrameBegin();
+    Redraw = FALSE;
+
     /* Update lines data */
     if (ThreadsDataUpdated)
     {
       ThreadsDataUpdated = false;
 
-      std::vector<std::pair<const coordf *, size_t>> Lines;
+      std::vector<std::pair<const coordf *, size_t>> Lines, Equipotentials;
+
+      for (size_t i = 0; i < Charges.Size(); i++)
+        if (const auto *Traced {ChargeLines.Find(Charges.Handle(i))}; Traced != nullptr)
+          for (auto &Line : *Traced)
+            Lines.emplace_back(Line.data(), Line.size());
+      for (const auto &Line : SpaceLines)
+        Lines.emplace_back(Line.data(), Line.size());
 
-      for (const auto &ChargeData : Charges)
-        for (auto &Line : ChargeData.Lines)
-          Lines.emplace_back(Line.data(), Line.size());
+      for (const auto &Line : Contours.GetLines())
+        Equipotentials.emplace_back(Line.data(), Line.size());
+
+      /* Lattice lines copies are drawn in cells where lines box is visible */
+      LinesMin = {std::numeric_limits<flt>::max(), std::numeric_limits<flt>::max()};
+      LinesMax = {-std::numeric_limits<flt>::max(), -std::numeric_limits<flt>::max()};
+      for (const auto &[Pts, Count] : Lines)
+        for (size_t i = 0; i < Count; i++)
+        {
+          LinesMin = {std::min(LinesMin.X, Pts[i].X), std::min(LinesMin.Y, Pts[i].Y)};
+          LinesMax = {std::max(LinesMax.X, Pts[i].X), std::max(LinesMax.Y, Pts[i].Y)};
+        }
 
       /* Send update */
-      Renderer.UpdateData(Lines, true);
+      Renderer.UpdateData(Lines, Equipotentials, true);
     }
 
     std::vector<std::pair<coordf, std::pair<flt, flt>>> ChargesBulk {};
+    std::vector<coordf> ChargeShifts {{0, 0}}, LineShifts {};
 
-    ChargesBulk.reserve(Charges.size());
-    for (const auto &ChargeData : Charges)
+    /* Charges images in visible lattice cells */
+    if (Periodic != nullptr && !Charges.IsEmpty())
     {
-      const auto &Pos {ChargeData.Coord};
-      const auto &Size {ChargeData.Size};
-      const auto &Charge {ChargeData.Charge};
+      coordf Min {(flt)Charges[0].Coord.X, (flt)Charges[0].Coord.Y}, Max {Min};
+
+      for (const auto &Elm : Charges)
+      {
+        const dbl Radius {phys::SourceRadius(Elm.Shape) + Elm.Size};
+
+        Min = {std::min(Min.X, (flt)(Elm.Coord.X - Radius)), std::min(Min.Y, (flt)(Elm.Coord.Y - Radius))};
+        Max = {std::max(Max.X, (flt)(Elm.Coord.X + Radius)), std::max(Max.Y, (flt)(Elm.Coord.Y + Radius))};
+      }
+
+      GetCellShifts(Min, Max, ChargeShifts);
+      if (LinesMin.X <= LinesMax.X)
+        GetCellShifts(LinesMin, LinesMax, LineShifts);
+    }
+
+    /* Extended sources are drawn as outlines on doubled thickness, their charge entries only place labels */
+    constexpr size_t OutlinePoints {64};
+    std::vector<std::pair<std::vector<coordf>, flt>> Sources {};
+
+    /* Only charges reaching frame are drawn (lattice images of all charges are drawn in shifted cells) */
+    std::vector<size_t> Visible {};
 
-      ChargesBulk.emplace_back(coordf {(flt)Pos.X, (flt)Pos.Y}, std::make_pair(Charge, Size));
+    if (Periodic == nullptr)
+      Charges.FindInBox({Left, Bottom}, {Right, Top}, Visible);
+    else
+    {
+      Visible.resize(Charges.Size());
+      std::iota(Visible.begin(), Visible.end(), 0);
     }
 
+    ChargesBulk.reserve(Visible.size() * ChargeShifts.size());
+    for (const auto &Shift : ChargeShifts)
+      for (const size_t Index : Visible)
+      {
+        const auto &ChargeData {Charges[Index]};
+        const auto &Pos {ChargeData.Coord};
+        const auto &Size {ChargeData.Size};
+        const auto &Charge {ChargeData.Charge};
+
+        if (!phys::IsExtended(ChargeData))
+        {
+          ChargesBulk.emplace_back(coordf {(flt)Pos.X + Shift.X, (flt)Pos.Y + Shift.Y}, std::make_pair(Charge, Size));
+          continue;
+        }
+
+        /* Multipole is drawn as sectors of its poles signs (half disks for dipole, quarters for quadrupole) */
+        if (phys::IsMultipole(ChargeData))
+        {
+          const bool IsDipole {ChargeData.Shape.Type == phys::source_type::Dipole};
+          const INT Sectors {IsDipole ? 2 : 4};
+          const dbl Width {2 * M_PI / Sectors};
+
+          for (INT s = 0; s < Sectors; s++)
+          {
+            auto &[Outline, OutlineCharge] {Sources.emplace_back()};
+            const dbl From {ChargeData.Shape.Angle + Width * (s - 0.5)};
+
+            Outline.reserve(OutlinePoints / Sectors + 2);
+            Outline.push_back({(flt)Pos.X + Shift.X, (flt)Pos.Y + Shift.Y});
+            for (size_t i = 0; i <= OutlinePoints / Sectors; i++)
+            {
+              const dbl Angle {From + Width * i / (OutlinePoints / Sectors)};
+
+              Outline.push_back({(flt)(Pos.X + Size * cos(Angle)) + Shift.X, (flt)(Pos.Y + Size * sin(Angle)) + Shift.Y});
+            }
+            OutlineCharge = (flt)(s % 2 == 0 ? Charge : -Charge);
+          }
+
+          ChargesBulk.emplace_back(coordf {(flt)Pos.X + Shift.X, (flt)Pos.Y + Shift.Y}, std::make_pair(Charge, 0.0));
+          continue;
+        }
+
+        auto &[Outline, OutlineCharge] {Sources.emplace_back()};
+        coordd Base;
+
+        Outline.reserve(OutlinePoints);
+        for (size_t i = 0; i < OutlinePoints; i++)
+        {
+          const coordd P {phys::SourceContour(ChargeData, 2 * M_PI * i / OutlinePoints, Size, Base)};
+
+          Outline.push_back({(flt)P.X + Shift.X, (flt)P.Y + Shift.Y});
+        }
+        OutlineCharge = (flt)Charge;
+
+        /* Arc label is placed over arc middle */
+        const auto &Shape {ChargeData.Shape};
+        const coordd Label
+        {
+          Shape.Type == phys::source_type::Arc ?
+            coordd {Pos.X + Shape.Extent * cos(Shape.Angle), Pos.Y + Shape.Extent * sin(Shape.Angle)} : Pos
+        };
+
+        ChargesBulk.emplace_back(coordf {(flt)Label.X + Shift.X, (flt)Label.Y + Shift.Y}, std::make_pair(Charge, Size));
+      }
+
     std::pair<std::pair<coordf, std::pair<flt, flt>> *, size_t>
       TmpCharges {ChargesBulk.data(), ChargesBulk.size()};
 
+    /* Grounded conductor outline (half plane is cut with square around frame, circle is polygon) */
+    std::vector<coordf> Conductor {};
+
+    if (Boundary.IsValid() && !IsPeriodic)
+      if (Boundary.Type == phys::boundary_type::Line)
+      {
+        const coordd
+          Center {(Left + Right) * 0.5, (Top + Bottom) * 0.5},
+          Base {Boundary.Project(Center)},
+          N {Boundary.Normal},
+          T {-N.Y, N.X};
+        const dbl Size {hypot(Right - Left, Top - Bottom) + abs(Boundary.Distance(Center))};
+
+        for (const auto &[U, V] : {std::pair {1.0, 0.0}, {-1.0, 0.0}, {-1.0, -1.0}, {1.0, -1.0}})
+          Conductor.push_back({(flt)(Base.X + (T.X * U + N.X * V) * Size), (flt)(Base.Y + (T.Y * U + N.Y * V) * Size)});
+      }
+      else
+      {
+        constexpr INT Segments {128};
+
+        for (INT i = 0; i < Segments; i++)
+          Conductor.push_back({(flt)(Boundary.Point.X + Boundary.Radius * cos(2 * M_PI * i / Segments)),
+                               (flt)(Boundary.Point.Y + Boundary.Radius * sin(2 * M_PI * i / Segments))});
+      }
+
     /* Call renderer */
-    Renderer.Render(TmpCharges, {(flt)Left, (flt)Top}, {(flt)Right, (flt)Bottom});
+    Renderer.Render(TmpCharges, {(flt)Left, (flt)Top}, {(flt)Right, (flt)Bottom}, LineShifts, Conductor, Sources);
+
+    Scheduler.FrameEnd();
   } /* End of 'anim::Render' function */
 
+  /* Lattice cells shifts, which content box intersects frame, evaluation function.
+   * ARGUMENTS:
+   *   - Cell content bounding box:
+   *       const coordf &Min, &Max;
+   *   - Shifts (out, cleared):
+   *       std::vector<coordf> &Shifts;
+   */
+  void anim::GetCellShifts( const coordf &Min, const coordf &Max, std::vector<coordf> &Shifts ) const
+  {
+    Shifts.clear();
+    if (Periodic == nullptr)
+      return;
+
+    const auto &Cell {Periodic->GetCell()};
+
+    /* Cells range along axis (limited around frame center for far zoomed out frame) */
+    auto Range = [this]( dbl From, dbl To, dbl BoxMin, dbl BoxMax, dbl Size ) -> std::pair<INT, INT>
+      {
+        const dbl Center {floor(((From + To) * 0.5 - (BoxMin + BoxMax) * 0.5) / Size)};
+
+        return {(INT)std::max(ceil((From - BoxMax) / Size), Center - MaxDrawnCells / 2),
+                (INT)std::min(floor((To - BoxMin) / Size), Center + MaxDrawnCells / 2)};
+      };
+
+    const auto [X0, X1] {Range(Left, Right, Min.X, Max.X, Cell.W)};
+    const auto [Y0, Y1] {Range(Bottom, Top, Min.Y, Max.Y, Cell.H)};
+
+    for (INT y = Y0; y <= Y1; y++)
+      for (INT x = X0; x <= X1; x++)
+        Shifts.push_back({(flt)(x * Cell.W), (flt)(y * Cell.H)});
+  } /* End of 'anim::GetCellShifts' function */
+
   /* Background erasion callback.
    * ARGUMENTS:
    *   - Draw context:
@@ -451,7 +938,8 @@ namespace prj
    */
   void anim::Paint( HDC hDC )
   {
-    // No action - all drawing in render
+    /* Window content is invalidated only by system, no frames are scheduled */
+    Render();
   } /* End of 'anim::Paint' function */
 
   /* Values updating function */
@@ -465,6 +953,33 @@ namespace prj
 
     if (Anim->LineEvalLength != LineEvalLength)
       Anim->LineEvalLength = LineEvalLength, Anim->SetReevaluation();
+
+    Anim->Scheduler.SetFrameRates(FrameRate, EvalFrameRate);
+    Anim->Progressive = Progressive;
+
+    if (Anim->DrawEquipotentials != DrawEquipotentials)
+      Anim->DrawEquipotentials = DrawEquipotentials, Anim->SetReevaluation();
+
+    if (Anim->EvenSpacing != EvenSpacing)
+      Anim->EvenSpacing = EvenSpacing, Anim->SetReevaluation();
+
+    if (Anim->LineSpacing != LineSpacing)
+      Anim->LineSpacing = LineSpacing, Anim->SetReevaluation();
+
+    if (Anim->FluxSeeding != FluxSeeding)
+      Anim->FluxSeeding = FluxSeeding, Anim->SetReevaluation();
+
+    if (Anim->SinkSeeding != SinkSeeding)
+      Anim->SinkSeeding = SinkSeeding, Anim->SetReevaluation();
+
+    if (Anim->SymmetryReplication != SymmetryReplication)
+      Anim->SymmetryReplication = SymmetryReplication, Anim->SetReevaluation();
+
+    if (Anim->IsPeriodic != IsPeriodic || Anim->CellW != CellW || Anim->CellH != CellH)
+      Anim->IsPeriodic = IsPeriodic, Anim->CellW = CellW, Anim->CellH = CellH, Anim->SetReevaluation();
+
+    if (Anim->DeterministicTracing != DeterministicTracing)
+      Anim->DeterministicTracing = DeterministicTracing, Anim->SetReevaluation();
   } /* End of 'anim::eval_settings::Apply' function */
 
   /* Dialog window process functions custom data external storage */
@@ -505,6 +1020,32 @@ namespace prj
                                           std::to_string(((eval_settings *)lParam)->LineLengthCoeff).c_str());
                           SetDlgItemTextA(hWnd, IDC_EDIT_LINE_SEGM_COUNT,
                                           std::to_string(((eval_settings *)lParam)->LineEvalLength).c_str());
+                          SetDlgItemTextA(hWnd, IDC_EDIT_FRAME_RATE,
+                                          std::to_string(((eval_settings *)lParam)->FrameRate).c_str());
+                          SetDlgItemTextA(hWnd, IDC_EDIT_EVAL_FRAME_RATE,
+                                          std::to_string(((eval_settings *)lParam)->EvalFrameRate).c_str());
+                          CheckDlgButton(hWnd, IDC_CHECK_PROGRESSIVE,
+                                         ((eval_settings *)lParam)->Progressive ? BST_CHECKED : BST_UNCHECKED);
+                          CheckDlgButton(hWnd, IDC_CHECK_EQUIPOTENTIALS,
+                                         ((eval_settings *)lParam)->DrawEquipotentials ? BST_CHECKED : BST_UNCHECKED);
+                          SetDlgItemTextA(hWnd, IDC_EDIT_LINE_SPACING,
+                                          std::to_string(((eval_settings *)lParam)->LineSpacing).c_str());
+                          CheckDlgButton(hWnd, IDC_CHECK_EVEN_SPACING,
+                                         ((eval_settings *)lParam)->EvenSpacing ? BST_CHECKED : BST_UNCHECKED);
+                          CheckDlgButton(hWnd, IDC_CHECK_FLUX_SEEDING,
+                                         ((eval_settings *)lParam)->FluxSeeding ? BST_CHECKED : BST_UNCHECKED);
+                          CheckDlgButton(hWnd, IDC_CHECK_SINK_SEEDING,
+                                         ((eval_settings *)lParam)->SinkSeeding ? BST_CHECKED : BST_UNCHECKED);
+                          CheckDlgButton(hWnd, IDC_CHECK_SYMMETRY,
+                                         ((eval_settings *)lParam)->SymmetryReplication ? BST_CHECKED : BST_UNCHECKED);
+                          CheckDlgButton(hWnd, IDC_CHECK_PERIODIC,
+                                         ((eval_settings *)lParam)->IsPeriodic ? BST_CHECKED : BST_UNCHECKED);
+                          SetDlgItemTextA(hWnd, IDC_EDIT_CELL_W,
+                                          std::to_string(((eval_settings *)lParam)->CellW).c_str());
+                          SetDlgItemTextA(hWnd, IDC_EDIT_CELL_H,
+                                          std::to_string(((eval_settings *)lParam)->CellH).c_str());
+                          CheckDlgButton(hWnd, IDC_CHECK_DETERMINISTIC,
+                                         ((eval_settings *)lParam)->DeterministicTracing ? BST_CHECKED : BST_UNCHECKED);
                           break;
                         case WM_CLOSE:
                           EndDialog(hWnd, 1);
@@ -557,6 +1098,83 @@ namespace prj
                                 ((anim::eval_settings *)DialogsDataMap[hWnd])->LineEvalLength = NewVal;
                               }
                             }
+
+                            symbols = GetDlgItemTextA(hWnd, IDC_EDIT_FRAME_RATE, Buf, sizeof (Buf) - 1); Buf[symbols] = 0;
+
+                            if (symbols > 0 && symbols < sizeof (Buf))
+                            {
+                              dbl NewVal = 0;
+                              if (sscanf(Buf, "%lf", &NewVal) == 1 && NewVal > 0)
+                              {
+                                NewVal = std::clamp(NewVal, 1.0, 240.0);
+                                ((anim::eval_settings *)DialogsDataMap[hWnd])->FrameRate = NewVal;
+                              }
+                            }
+
+                            symbols = GetDlgItemTextA(hWnd, IDC_EDIT_EVAL_FRAME_RATE, Buf, sizeof (Buf) - 1); Buf[symbols] = 0;
+
+                            if (symbols > 0 && symbols < sizeof (Buf))
+                            {
+                              dbl NewVal = 0;
+                              if (sscanf(Buf, "%lf", &NewVal) == 1 && NewVal > 0)
+                              {
+                                NewVal = std::clamp(NewVal, 1.0, 240.0);
+                                ((anim::eval_settings *)DialogsDataMap[hWnd])->EvalFrameRate = NewVal;
+                              }
+                            }
+
+                            symbols = GetDlgItemTextA(hWnd, IDC_EDIT_LINE_SPACING, Buf, sizeof (Buf) - 1); Buf[symbols] = 0;
+
+                            if (symbols > 0 && symbols < sizeof (Buf))
+                            {
+                              dbl NewVal = 0;
+                              if (sscanf(Buf, "%lf", &NewVal) == 1 && NewVal > 0)
+                              {
+                                NewVal = std::clamp(NewVal, 0.005, 0.25);
+                                ((anim::eval_settings *)DialogsDataMap[hWnd])->LineSpacing = NewVal;
+                              }
+                            }
+
+                            symbols = GetDlgItemTextA(hWnd, IDC_EDIT_CELL_W, Buf, sizeof (Buf) - 1); Buf[symbols] = 0;
+
+                            if (symbols > 0 && symbols < sizeof (Buf))
+                            {
+                              dbl NewVal = 0;
+                              if (sscanf(Buf, "%lf", &NewVal) == 1 && NewVal > 0)
+                              {
+                                NewVal = std::clamp(NewVal, 0.5, 1000.0);
+                                ((anim::eval_settings *)DialogsDataMap[hWnd])->CellW = NewVal;
+                              }
+                            }
+
+                            symbols = GetDlgItemTextA(hWnd, IDC_EDIT_CELL_H, Buf, sizeof (Buf) - 1); Buf[symbols] = 0;
+
+                            if (symbols > 0 && symbols < sizeof (Buf))
+                            {
+                              dbl NewVal = 0;
+                              if (sscanf(Buf, "%lf", &NewVal) == 1 && NewVal > 0)
+                              {
+                                NewVal = std::clamp(NewVal, 0.5, 1000.0);
+                                ((anim::eval_settings *)DialogsDataMap[hWnd])->CellH = NewVal;
+                              }
+                            }
+
+                            ((anim::eval_settings *)DialogsDataMap[hWnd])->Progressive =
+                              IsDlgButtonChecked(hWnd, IDC_CHECK_PROGRESSIVE) == BST_CHECKED;
+                            ((anim::eval_settings *)DialogsDataMap[hWnd])->DrawEquipotentials =
+                              IsDlgButtonChecked(hWnd, IDC_CHECK_EQUIPOTENTIALS) == BST_CHECKED;
+                            ((anim::eval_settings *)DialogsDataMap[hWnd])->EvenSpacing =
+                              IsDlgButtonChecked(hWnd, IDC_CHECK_EVEN_SPACING) == BST_CHECKED;
+                            ((anim::eval_settings *)DialogsDataMap[hWnd])->FluxSeeding =
+                              IsDlgButtonChecked(hWnd, IDC_CHECK_FLUX_SEEDING) == BST_CHECKED;
+                            ((anim::eval_settings *)DialogsDataMap[hWnd])->SinkSeeding =
+                              IsDlgButtonChecked(hWnd, IDC_CHECK_SINK_SEEDING) == BST_CHECKED;
+                            ((anim::eval_settings *)DialogsDataMap[hWnd])->SymmetryReplication =
+                              IsDlgButtonChecked(hWnd, IDC_CHECK_SYMMETRY) == BST_CHECKED;
+                            ((anim::eval_settings *)DialogsDataMap[hWnd])->IsPeriodic =
+                              IsDlgButtonChecked(hWnd, IDC_CHECK_PERIODIC) == BST_CHECKED;
+                            ((anim::eval_settings *)DialogsDataMap[hWnd])->DeterministicTracing =
+                              IsDlgButtonChecked(hWnd, IDC_CHECK_DETERMINISTIC) == BST_CHECKED;
                           }
                             ((anim::eval_settings *)DialogsDataMap[hWnd])->Apply();
                             EndDialog(hWnd, 0);
@@ -596,11 +1214,21 @@ namespace prj
                                           "  - Right Mouse Button - move 'camera'.\n"
                                           "  - Left Mouse Button - select charge.\n"
                                           "  - Ctrl + Left Mouse Button - select charge or add new.\n"
+                                          "  - Ctrl + Z / Ctrl + Y - undo / redo scene edit.\n"
+                                          "  - Ctrl + H - background heatmap (none / field / potential).\n"
+                                          "  - Ctrl + I - field texture (LIC) instead of lines.\n"
                                           "\nControls (charge selected):\n"
                                           "  - Moving mouse - move charge.\n"
                                           "  - Mouse wheel - charge value.\n"
+                                          "  - Ctrl + Mouse wheel - extended source size.\n"
+                                          "  - Shift + Mouse wheel - extended source or multipole rotation.\n"
                                           "  - Delete or backspace - delete charge.\n"
-                                          "  - Hold 'A' - coordinates align.");
+                                          "  - Hold 'A' - coordinates align.\n"
+                                          "\nControls (boundary selected, add it in 'Scene' menu):\n"
+                                          "  - Left Mouse Button on boundary - select it.\n"
+                                          "  - Moving mouse - move boundary.\n"
+                                          "  - Mouse wheel - rotate line / scale circle.\n"
+                                          "  - Delete - remove boundary.");
                         }
                           break;
                         case WM_CLOSE:
@@ -625,6 +1253,9 @@ namespace prj
     case ID_SCENE_LOAD:
       ClearScene();
 
+      /* Loaded scene is periodic only if its file has cell */
+      IsPeriodic = false;
+
       [[fallthrough]];
     case ID_SCENE_LOADADD:
     {
@@ -661,7 +1292,66 @@ namespace prj
             if (abs(Charge) < MinCharge)
               Charge = std::copysign(MinCharge, Charge);
 
-            Charges.push_back({coordd {X, Y}, Charge, pow(abs(Charge), SizePow) * SizeCoeff});
+            /* Optional extended source shape after coordinates */
+            phys::source_shape Shape {};
+            const CHAR *Str;
+
+            if ((Str = strstr(Line, "segment=")) != nullptr)
+            {
+              Shape.Type = phys::source_type::Segment;
+              WasError = sscanf(Str, "segment=%lf, %lf", &Shape.Extent, &Shape.Angle) != 2;
+            }
+            else if ((Str = strstr(Line, "arc=")) != nullptr)
+            {
+              Shape.Type = phys::source_type::Arc;
+              WasError = sscanf(Str, "arc=%lf, %lf, %lf", &Shape.Extent, &Shape.Angle, &Shape.Sweep) != 3;
+            }
+            else if ((Str = strstr(Line, "disk=")) != nullptr)
+            {
+              Shape.Type = phys::source_type::Disk;
+              WasError = sscanf(Str, "disk=%lf", &Shape.Extent) != 1;
+            }
+            else if ((Str = strstr(Line, "dipole=")) != nullptr)
+            {
+              Shape.Type = phys::source_type::Dipole;
+              WasError = sscanf(Str, "dipole=%lf", &Shape.Angle) != 1;
+            }
+            else if ((Str = strstr(Line, "quadrupole=")) != nullptr)
+            {
+              Shape.Type = phys::source_type::Quadrupole;
+              WasError = sscanf(Str, "quadrupole=%lf", &Shape.Angle) != 1;
+            }
+
+            const bool IsMulti {Shape.Type == phys::source_type::Dipole || Shape.Type == phys::source_type::Quadrupole};
+
+            if (WasError || (Shape.Type != phys::source_type::Point && !IsMulti && !(Shape.Extent > 0)))
+            {
+              WasError = true;
+              break;
+            }
+
+            if (Shape.Type == phys::source_type::Point)
+              Charges.Add({coordd {X, Y}, Charge, pow(abs(Charge), SizePow) * SizeCoeff});
+            else if (IsMulti)
+              Charges.Add({coordd {X, Y}, Charge, MinChargeSize, Shape});
+            else
+              Charges.Add({coordd {X, Y}, Charge, MinChargeSize * 0.5, Shape});
+          }
+
+          /* Optional periodic cell and grounded boundary lines after charges */
+          while (!WasError && Cnt == 0 && File.getline(Line, sizeof (Line)))
+          {
+            dbl NX, NY;
+
+            if (sscanf(Line, "cell=%lf, %lf", &X, &Y) == 2)
+            {
+              if (X > 0 && Y > 0)
+                IsPeriodic = true, CellW = X, CellH = Y;
+            }
+            else if (sscanf(Line, "boundary=line %lf, %lf, %lf, %lf", &X, &Y, &NX, &NY) == 4)
+              SetBoundary(phys::boundary::Line({X, Y}, {NX, NY}));
+            else if (sscanf(Line, "boundary=circle %lf, %lf, %lf", &X, &Y, &NX) == 3)
+              SetBoundary(phys::boundary::Circle({X, Y}, NX));
           }
         }
         else
@@ -675,13 +1365,15 @@ namespace prj
         else
           SetReevaluation();
 
+        CommitHistory();
+
       }
 
       InputState = input_state::None;
     }
       return;
     case ID_SCENE_SAVE:
-      if (Charges.size() != 0)
+      if (Charges.Size() != 0)
       {
         InputState = input_state::Dialog;
 
@@ -695,10 +1387,43 @@ namespace prj
         {
           std::ofstream File {FileName.lpstrFile};
 
-          File << Charges.size() << '\n';
+          File << Charges.Size() << '\n';
 
           for (auto &Elm : Charges)
-            File << "charge=" << Elm.Charge << " coord=" << Elm.Coord.X << ", " << Elm.Coord.Y << '\n';
+          {
+            File << "charge=" << Elm.Charge << " coord=" << Elm.Coord.X << ", " << Elm.Coord.Y;
+
+            switch (Elm.Shape.Type)
+            {
+            case phys::source_type::Segment:
+              File << " segment=" << Elm.Shape.Extent << ", " << Elm.Shape.Angle;
+              break;
+            case phys::source_type::Arc:
+              File << " arc=" << Elm.Shape.Extent << ", " << Elm.Shape.Angle << ", " << Elm.Shape.Sweep;
+              break;
+            case phys::source_type::Disk:
+              File << " disk=" << Elm.Shape.Extent;
+              break;
+            case phys::source_type::Dipole:
+              File << " dipole=" << Elm.Shape.Angle;
+              break;
+            case phys::source_type::Quadrupole:
+              File << " quadrupole=" << Elm.Shape.Angle;
+              break;
+            default:
+              break;
+            }
+            File << '\n';
+          }
+
+          if (IsPeriodic)
+            File << "cell=" << CellW << ", " << CellH << '\n';
+
+          if (Boundary.Type == phys::boundary_type::Line)
+            File << "boundary=line " << Boundary.Point.X << ", " << Boundary.Point.Y << ", " <<
+              Boundary.Normal.X << ", " << Boundary.Normal.Y << '\n';
+          else if (Boundary.Type == phys::boundary_type::Circle)
+            File << "boundary=circle " << Boundary.Point.X << ", " << Boundary.Point.Y << ", " << Boundary.Radius << '\n';
         }
 
         InputState = input_state::None;
@@ -756,9 +1481,131 @@ namespace prj
         InputState = input_state::None;
       }
       return;
+    case ID_SCENE_HEATMAP:
+      Heatmap.SetMode((phys::heatmap_mode)(((UINT)Heatmap.GetMode() + 1) % (UINT)phys::heatmap_mode::Count));
+      Heatmap.Invalidate(Charges, Periodic.get(), EvalBoundary);
+      Redraw = true;
+      return;
+    case ID_SCENE_EXPORT_HEATMAP:
+      if (Heatmap.GetMode() != phys::heatmap_mode::None)
+      {
+        InputState = input_state::Dialog;
+
+        CHAR FileNameBuf[0x400] {};
+        OPENFILENAME FileName {sizeof (OPENFILENAME), hWnd, hInstance};
+        FileName.lpstrFile = FileNameBuf;
+        FileName.nMaxFile = (sizeof (FileNameBuf) / sizeof (*FileNameBuf)) - 1;
+        FileName.lpstrFilter = "Portalble Network Graphic\0*.png*\0\0";
+        FileName.lpstrDefExt = "png";
+
+        if (GetSaveFileName(&FileName))
+        {
+          /* Headless rasterization with export resolution */
+          const phys::heatmap_view View {GetHeatmapView(W * ExportScale, H * ExportScale)};
+          const auto Pixels {phys::heatmap::Rasterize(Charges, Heatmap.GetMode(), View, Periodic.get(), EvalBoundary)};
+
+          try
+          {
+            img::SaveAsPng(FileNameBuf, View.Width, View.Height, Pixels.data());
+          }
+          catch ( std::runtime_error & ) {}
+        }
+
+        InputState = input_state::None;
+      }
+      return;
+    case ID_SCENE_LIC:
+      LicMode = !LicMode;
+      SetReevaluation();
+      return;
+    case ID_SCENE_EXPORT_LIC:
+    {
+      InputState = input_state::Dialog;
+
+      CHAR FileNameBuf[0x400] {};
+      OPENFILENAME FileName {sizeof (OPENFILENAME), hWnd, hInstance};
+      FileName.lpstrFile = FileNameBuf;
+      FileName.nMaxFile = (sizeof (FileNameBuf) / sizeof (*FileNameBuf)) - 1;
+      FileName.lpstrFilter = "Portalble Network Graphic\0*.png*\0\0";
+      FileName.lpstrDefExt = "png";
+
+      if (GetSaveFileName(&FileName))
+      {
+        /* Headless texture with export resolution */
+        const phys::heatmap_view View {GetHeatmapView(W * ExportScale, H * ExportScale)};
+        phys::lic Exporter {};
+
+        Exporter.Update(Charges, View, Periodic.get(), EvalBoundary);
+
+        try
+        {
+          img::SaveAsPng(FileNameBuf, View.Width, View.Height, Exporter.GetPixels().data());
+        }
+        catch ( std::runtime_error & ) {}
+      }
+
+      InputState = input_state::None;
+    }
+      return;
+    case ID_SCENE_BOUNDARY_LINE:
+      SetBoundary(phys::boundary::Line({(Left + Right) / 2, Bottom + (Top - Bottom) / 4}, {0, 1}));
+      CommitHistory();
+      return;
+    case ID_SCENE_BOUNDARY_CIRCLE:
+      SetBoundary(phys::boundary::Circle({(Left + Right) / 2, (Top + Bottom) / 2}, (Right - Left) / 8));
+      CommitHistory();
+      return;
+    case ID_SCENE_BOUNDARY_REMOVE:
+      SetBoundary({});
+      CommitHistory();
+      return;
+    case ID_SCENE_ADD_SEGMENT:
+      AddSource(phys::source_type::Segment);
+      CommitHistory();
+      return;
+    case ID_SCENE_ADD_ARC:
+      AddSource(phys::source_type::Arc);
+      CommitHistory();
+      return;
+    case ID_SCENE_ADD_DISK:
+      AddSource(phys::source_type::Disk);
+      CommitHistory();
+      return;
+    case ID_SCENE_ADD_DIPOLE:
+      AddSource(phys::source_type::Dipole);
+      CommitHistory();
+      return;
+    case ID_SCENE_ADD_QUADRUPOLE:
+      AddSource(phys::source_type::Quadrupole);
+      CommitHistory();
+      return;
     case ID_SCENE_CLEAR:
       ClearScene();
+      CommitHistory();
+      return;
+    case ID_EDIT_UNDO:
+      if (InputState == input_state::None)
+        RestoreHistory(History.Undo());
+      return;
+    case ID_EDIT_REDO:
+      if (InputState == input_state::None)
+        RestoreHistory(History.Redo());
       return;
+    case IDM_MAIN_MENU_STATISTICS:
+      InputState = input_state::Dialog;
+      MessageBoxA(hWnd, GetStatistics().c_str(), "Statistics", MB_OK);
+      InputState = input_state::None;
+      return;
+    case IDM_MAIN_MENU_BENCHMARK:
+    {
+      InputState = input_state::Dialog;
+
+      const std::string Report {RunBenchmarks()};
+
+      MessageBoxA(hWnd, Report.c_str(), "Benchmark", MB_OK);
+      InputState = input_state::None;
+      return;
+    }
     }
   } /* End of 'anim::OnMenuButton' function */
 } /* end of 'prj' namespace */
@@ -1,7 +1,7 @@
 /* FILE NAME   : 'anim.h'
  * PURPOSE     : Animation module header file.
  * PROGRAMMER  : Fedor Borodulin.
- * LAST UPDATE : 07.04.2023.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : Module namespace 'prj'.
  */
 
@@ -13,9 +13,18 @@
 #include "win/win.h"
 #include "render/render.h"
 #include "input/input.h"
+#include "scene_history.h"
+#include "frame_scheduler.h"
 
 #include "utility/physics/ef_force_lines.h"
+#include "utility/physics/ef_equipotentials.h"
+#include "utility/physics/ef_heatmap.h"
+#include "utility/physics/ef_lic.h"
+#include "utility/physics/ef_spacing.h"
+#include "utility/physics/ef_symmetry.h"
+#include "utility/physics/ef_ewald.h"
 #include "utility/threads_pool/threads_pool.hpp"
+#include "utility/lru_cache/lru_cache.hpp"
 
 /* Project namespace */
 namespace prj
@@ -42,6 +51,64 @@ namespace prj
     dbl LinesPerCharge {6}, LineLengthCoeff {0.18};
     size_t LineEvalLength {2'000};
 
+    /* Progressive (coarse lines first, then refinement) evaluation flag */
+    bool Progressive {true};
+
+    /* Coarse pass parameters: every 'CoarseLinesDiv' seed is traced with 'CoarseStepMul' times longer step */
+    size_t CoarseLinesDiv {2};
+    dbl CoarseStepMul {4};
+
+    /* Coarse lines divider of current edit passes (adapted divider is used from next edit) */
+    size_t PassDiv {2};
+
+    /* Time to first visible lines after edit budget (in ms) */
+    dbl FirstLinesBudget {16};
+
+    /* Region of interest margin (in frame sizes) and suspended lines tile size (in world units) */
+    dbl RoiMargin {0.5}, RoiTileSize {8};
+
+    /* Field null point neighbourhood radius (in line steps) */
+    dbl NullRadiusCoeff {2};
+
+    /* Equipotential lines drawing flag, potential step between lines and lines count on each side of zero */
+    bool DrawEquipotentials {false};
+    dbl EquipotentialStep {0.1};
+    size_t EquipotentialLevels {40};
+
+    /* Background (heatmap or LIC texture) export resolution (in window sizes) */
+    INT ExportScale {2};
+
+    /* Seeds at equal flux quantiles on charge seed circle (otherwise uniform angles) flag */
+    bool FluxSeeding {true};
+
+    /* Lines from negative charges (traced against field where no other line came) flag */
+    bool SinkSeeding {false};
+
+    /* Evenly spaced lines (occupancy grid seeding) flag, lines separation (in frame widths) and seeding rounds limit */
+    bool EvenSpacing {false};
+    dbl LineSpacing {0.03};
+    size_t MaxSeedRounds {32};
+
+    /* Symmetric scene lines replication (only fundamental domain seeds are traced) flag,
+     * charges position tolerance and far field rays length around symmetry center (lines are not limited by frame) */
+    bool SymmetryReplication {true};
+    dbl SymmetryTolerance {1e-6}, SymmetryBounds {1e4};
+
+    /* Periodic boundary conditions (scene charges are one cell of infinite lattice with cell corner at origin) flag,
+     * cell size and maximal drawn cells count along each axis */
+    bool IsPeriodic {false};
+    dbl CellW {12}, CellH {12};
+    INT MaxDrawnCells {32};
+
+    /* Bit-reproducible lines tracing (fixed charges summation order, see 'phys::ef_force_line::SetDeterministic') flag.
+     * Evenly spaced lines depend on tasks interleaving, so they are traced by single thread in insertion order
+     * and are reproducible while frame is not moved during tracing */
+    bool DeterministicTracing {false};
+
+    /* Line integral convolution texture mode (replaces lines tracing) and its frame time target (in ms) */
+    bool LicMode {false};
+    dbl LicFrameBudget {33};
+
     /* Scene clearing function */
     void ClearScene( void );
 
@@ -52,6 +119,13 @@ namespace prj
      */
     void AddCharge( coordd Coord );
 
+    /* Extended charge source adding function (source is placed in frame center).
+     * ARGUMENTS:
+     *   - Source type:
+     *       phys::source_type Type;
+     */
+    void AddSource( phys::source_type Type );
+
     /* Charge at position selecting
      * ARGUMENTS:
      *   - Charge position:
@@ -68,6 +142,22 @@ namespace prj
      */
     void SelectAddCharge( coordd Coord );
 
+    /* Grounded conductor boundary near position selecting function.
+     * ARGUMENTS:
+     *   - Cursor position:
+     *       coordd Coord;
+     * RETURNS:
+     *   (bool) true if boundary is grabbed.
+     */
+    bool SelectBoundary( coordd Coord );
+
+    /* Grounded conductor boundary setting function (none - boundary is removed).
+     * ARGUMENTS:
+     *   - New boundary:
+     *       const phys::boundary &NewBoundary;
+     */
+    void SetBoundary( const phys::boundary &NewBoundary );
+
     /* Reevaluation and redrawing flags */
     BOOL Reeval {FALSE}, Redraw {TRUE};
 
@@ -86,24 +176,278 @@ namespace prj
       dbl LinesPerCharge;
       dbl LineLengthCoeff;
       size_t LineEvalLength;
+      dbl FrameRate, EvalFrameRate;
+      bool Progressive;
+      bool DrawEquipotentials;
+      bool EvenSpacing;
+      dbl LineSpacing;
+      bool FluxSeeding;
+      bool SinkSeeding;
+      bool SymmetryReplication;
+      bool IsPeriodic;
+      dbl CellW, CellH;
+      bool DeterministicTracing;
 
       /* Default constructor */
       eval_settings( anim &Anim ) :
         Anim {&Anim},
         LinesPerCharge {Anim.LinesPerCharge},
         LineLengthCoeff {Anim.LineLengthCoeff},
-        LineEvalLength {Anim.LineEvalLength}
+        LineEvalLength {Anim.LineEvalLength},
+        FrameRate {Anim.Scheduler.GetFrameRates().first},
+        EvalFrameRate {Anim.Scheduler.GetFrameRates().second},
+        Progressive {Anim.Progressive},
+        DrawEquipotentials {Anim.DrawEquipotentials},
+        EvenSpacing {Anim.EvenSpacing},
+        LineSpacing {Anim.LineSpacing},
+        FluxSeeding {Anim.FluxSeeding},
+        SinkSeeding {Anim.SinkSeeding},
+        SymmetryReplication {Anim.SymmetryReplication},
+        IsPeriodic {Anim.IsPeriodic},
+        CellW {Anim.CellW},
+        CellH {Anim.CellH},
+        DeterministicTracing {Anim.DeterministicTracing}
       { }
 
       /* Values updating function */
       void Apply( void );
     }; /* end of 'eval_settings' class */
 
-    /* Charges pool */
-    std::list<phys::charge> Charges {};
+    /* Charges pool and force lines of every charge (line starts in source point, then seed) */
+    phys::charge_pool Charges {};
+    phys::charge_lines ChargeLines {};
+
+    /* Current selected charge (invalid handle - none) and its grab offset from cursor */
+    phys::charge_handle SelectedCharge {};
+    coordd ChargeGrab {0, 0};
+
+    /* Grounded conductor boundary (ignored with periodic boundary conditions) and its grab offset from cursor */
+    phys::boundary Boundary {};
+    coordd BoundaryGrab {0, 0};
+
+    /* Scene edits history */
+    scene_history History {};
+
+    /* Traced lines of all charges (in charges pool order, evenly spaced seeded lines are last) */
+    using lines_set = std::vector<std::vector<std::vector<coordf>>>;
+
+    /* Traced lines cache by evaluation hash (64 MB limit) */
+    util::lru_cache<UINT64, lines_set> LinesCache {64ull << 20};
+
+    /* Currently traced lines evaluation hash */
+    UINT64 TracedHash {0};
+
+    /* Evaluation passes enum */
+    enum class eval_pass : UINT
+    {
+      Full,   /* All lines with full precision (not progressive mode) */
+      Coarse, /* Part of lines with low precision */
+      Fill,   /* Rest of lines with full precision */
+      Refine, /* Coarse lines retracing with full precision */
+      Sinks,  /* Lines from negative charges tracing */
+      Seed,   /* Evenly spaced lines seeded in space left empty by previous round */
+      Resume, /* Suspended lines tracing after region of interest change */
+      Done    /* Evaluation finished */
+    } EvalPass {eval_pass::Done};
+
+    /* Refined coarse lines staging storage (line to replace and new points) */
+    std::list<std::pair<std::vector<coordf> *, std::vector<coordf>>> RefineLines {};
+
+    /* Time counter frequency and last edit evaluation start time */
+    UINT64 TimeFreq {1}, EvalStartTime {0};
+
+    /* Progressive evaluation statistics */
+    struct progressive_stats
+    {
+      size_t Edits {0}, OverBudget {0};
+      dbl FirstLinesLast {0}, FirstLinesAvg {0}, FirstLinesMax {0};
+    } ProgressiveStats {};
+
+    /* Lines evaluation region of interest structure */
+    struct roi
+    {
+      dbl Left, Top, Right, Bottom;
+
+      /* Point inside region check function.
+       * ARGUMENTS:
+       *   - Point:
+       *       const coordf &Pt;
+       * RETURNS:
+       *   (bool) true if point is inside.
+       */
+      bool IsInside( const coordf &Pt ) const
+      {
+        return Pt.X >= Left && Pt.X <= Right && Pt.Y >= Bottom && Pt.Y <= Top;
+      } /* End of 'IsInside' function */
+    }; /* end of 'roi' structure */
+
+    /* Current evaluation region of interest (changed only while threads are paused) */
+    roi EvalRoi {};
+
+    /* Region of interest statistics */
+    struct roi_stats
+    {
+      size_t Suspended {0}, Resumed {0}, Moves {0};
+    } RoiStats {};
+
+    /* Scene with evaluation settings hash evaluation function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) Hash value.
+     */
+    UINT64 EvalHash( void ) const;
+
+    /* Evaluation starting (after scene edit) function */
+    void Evaluate( void );
+
+    /* Evaluation pass starting function.
+     * ARGUMENTS:
+     *   - Pass to start:
+     *       eval_pass Pass;
+     */
+    void StartPass( eval_pass Pass );
+
+    /* Evaluation passes switching function (called every responce) */
+    void UpdateEvaluation( void );
+
+    /* Negative charges lines pass starting function.
+     * Seeds in sectors where lines from positive charges arrived are dropped before tracing.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (bool) true if any line was seeded.
+     */
+    bool SeedSinks( void );
+
+    /* Negative charges lines pass finishing function.
+     * Lines which reached positive charge near its own seed are dropped as duplicates,
+     * other are reversed to field direction.
+     */
+    void FinishSinks( void );
+
+    /* Evenly spaced lines seeding round starting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (bool) true if any line was seeded.
+     */
+    bool SeedSpace( void );
+
+    /* Equipotential lines update function.
+     * ARGUMENTS:
+     *   - Contours region:
+     *       const roi &Region;
+     */
+    void UpdateContours( const roi &Region );
+
+    /* Heatmap view for current frame getting function.
+     * ARGUMENTS:
+     *   - Pixels size:
+     *       INT W, H;
+     * RETURNS:
+     *   (phys::heatmap_view) View.
+     */
+    phys::heatmap_view GetHeatmapView( INT W, INT H ) const;
+
+    /* Background heatmap refinement and sending to renderer function (called every responce) */
+    void UpdateHeatmap( void );
+
+    /* LIC texture evaluation and sending to renderer function (called every responce) */
+    void UpdateLic( void );
+
+    /* Line evaluation task adding function.
+     * ARGUMENTS:
+     *   - Line source charge handle:
+     *       phys::charge_handle Source;
+     *   - Line seed angle:
+     *       dbl Angle;
+     *   - Line points storage:
+     *       std::vector<coordf> &Line;
+     *   - Coarse evaluation flag:
+     *       bool IsCoarse;
+     *   - Evenly spaced line identifier (0 if line is not limited by other lines):
+     *       UINT32 SpacingId;
+     */
+    void AddLineTask( phys::charge_handle Source, dbl Angle, std::vector<coordf> &Line, bool IsCoarse, UINT32 SpacingId = 0 );
+
+    /* Evenly spaced line evaluation tasks (both directions from seed) adding function.
+     * ARGUMENTS:
+     *   - Seed position:
+     *       const coordd &Seed;
+     *   - Evenly spaced line identifier:
+     *       UINT32 SpacingId;
+     */
+    void AddSeedTasks( const coordd &Seed, UINT32 SpacingId );
+
+    /* Line evaluation task priority evaluation function.
+     * Lines of selected charge go first, then lines of charges in current frame.
+     * ARGUMENTS:
+     *   - Line source charge handle (invalid - evenly spaced line seed):
+     *       phys::charge_handle Source;
+     * RETURNS:
+     *   (flt) Priority (greater are traced first).
+     */
+    flt LinePriority( phys::charge_handle Source ) const;
 
-    /* Current selected charge */
-    phys::charge *SelectedCharge {nullptr};
+    /* Line evaluation tasks reprioritization (after frame or selection change) function */
+    void UpdatePriorities( void );
+
+    /* Line evaluation threads count getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (size_t) Threads count for pool run (0 - auto).
+     */
+    size_t TracingThreads( void ) const;
+
+    /* Region of interest around current frame evaluation function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (roi) Frame with margin.
+     */
+    roi GetFrameRoi( void ) const;
+
+    /* Region of interest updating (after frame move) and suspended lines resuming function */
+    void UpdateRoi( void );
+
+    /* Suspended by threads lines queue to tiles storage moving function */
+    void CollectSuspended( void );
+
+    /* Suspended lines tile key evaluation function.
+     * ARGUMENTS:
+     *   - Tile coordinates:
+     *       INT TileX, TileY;
+     * RETURNS:
+     *   (UINT64) Tile key.
+     */
+    static UINT64 TileKey( INT TileX, INT TileY )
+    {
+      return ((UINT64)(UINT)TileX << 32) | (UINT)TileY;
+    } /* End of 'TileKey' function */
+
+    /* Current scene committing to history function */
+    void CommitHistory( void );
+
+    /* Scene restoring from history function
+     * ARGUMENTS:
+     *   - Stored scene state (may be nullptr):
+     *       const scene_history::scene_state *State;
+     */
+    void RestoreHistory( const scene_history::scene_state *State );
+
+    /* Finished traced lines storing to cache function */
+    void StoreLinesCache( void );
+
+    /* Evaluation statistics text getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (std::string) Statistics report.
+     */
+    std::string GetStatistics( void ) const;
+
+    /* Evaluation kernels benchmarks on current scene running function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (std::string) Benchmarks report.
+     */
+    std::string RunBenchmarks( void );
 
     /* Input actions state enum */
     enum class input_state : UINT
@@ -111,31 +455,149 @@ namespace prj
       None,
       Move,
       Charge,
+      Boundary,
       Dialog
     } InputState {input_state::None};
 
     /* Input data field */
     input Input {win::hWnd, win::MouseWheel};
 
+    /* Frames scheduler (must outlive threads pool, which notifies it) */
+    frame_scheduler Scheduler {};
+
+    /* Interactive input processing (frames are rendered with interactive frame rate) flag */
+    bool IsInteractive {false};
+
     /* Line threaded evaluation data */
     struct thread_data
     {
       phys::ef_force_line LineEval;
       std::vector<coordf> *LineData;
+      phys::charge_handle Source;
+      bool IsSink;
+      bool IsCoarse;
+      UINT32 SpacingId;
+      bool IsRay {false}; /* Suspended far field ray (line is finished on region bounds) */
 
       /* Default constructor */
       thread_data( void ) = default;
 
       /* Constructor from data */
-      thread_data( phys::ef_force_line &&Line, std::vector<coordf> *LinePts ) :
-        LineEval {Line}, LineData {LinePts}
+      thread_data( phys::ef_force_line &&Line, std::vector<coordf> *LinePts, phys::charge_handle Source, bool IsSink,
+                   bool IsCoarse = false, UINT32 SpacingId = 0 ) :
+        LineEval {Line}, LineData {LinePts}, Source {Source}, IsSink {IsSink}, IsCoarse {IsCoarse}, SpacingId {SpacingId}
       { }
     }; /* end of 'thread_data' structure */
 
     util::threads_pool<thread_data, 8> ThreadsPool;
 
+    /* Lines which left region of interest (filled by threads) */
+    std::vector<thread_data> SuspendQueue {};
+    std::mutex SuspendMutex {};
+
+    /* Lines termination counters and their evaluated steps by reason ('None' - line left region of interest) */
+    std::atomic_size_t
+      LineEnds[(size_t)phys::line_end::Count] {},
+      LineSteps[(size_t)phys::line_end::Count] {};
+
+    /* Lines evaluated steps by seeding strategy (from positive charges, from negative charges, evenly spaced seeds) */
+    std::atomic_size_t StrategySteps[3] {};
+
+    /* Line evaluation end registration function.
+     * ARGUMENTS:
+     *   - Line evaluation data:
+     *       thread_data &Data;
+     */
+    void RegisterLineEnd( thread_data &Data )
+    {
+      auto &LineEval {Data.LineEval};
+
+      LineEnds[(size_t)LineEval.Reason]++;
+      LineSteps[(size_t)LineEval.Reason] += LineEval.Steps;
+      StrategySteps[!Data.Source.IsValid() ? 2 : Data.IsSink ? 1 : 0] += LineEval.Steps;
+      LineEval.Steps = 0;
+    } /* End of 'RegisterLineEnd' function */
+
+    /* Current scene field null points (changed only while threads are stopped) */
+    std::vector<coordd> Nulls {};
+
+    /* Current scene lines seed angles for every charge (in charges pool order) and their placement time (in ms) */
+    std::vector<std::vector<dbl>> SeedAnglesSet {};
+    dbl SeedingTime {0};
+
+    /* Negative charges lines statistics */
+    struct sinks_stats
+    {
+      size_t Seeds {0}, Matched {0}, Duplicates {0};
+    } SinksStats {};
+
+    /* Current scene symmetry group (trivial if replication is off) */
+    phys::symmetry Symmetry {};
+
+    /* Symmetry replication statistics */
+    struct symmetry_stats
+    {
+      size_t Scenes {0}, Traced {0}, Replicated {0};
+    } SymmetryStats {};
+
+    /* Current scene lattice evaluator (nullptr if periodic boundary conditions are off, changed only while threads are stopped) */
+    std::unique_ptr<phys::ewald_sum> Periodic {};
+
+    /* Current scene lines environment (far field parameters, packed charges and sinks shared by all lines,
+     * changed only while threads are stopped) */
+    phys::line_environment LineEnv {};
+
+    /* Periodic lattice statistics (lattice evaluators builds and their build time in ms) */
+    struct periodic_stats
+    {
+      size_t Builds {0};
+      dbl BuildTime {0};
+    } PeriodicStats {};
+
+    /* Current scene boundary passed to evaluators (none for lattice, changed only while threads are stopped) */
+    phys::boundary EvalBoundary {};
+
+    /* Traced lines bounding box (for lattice cells lines copies drawing) */
+    coordf LinesMin {0, 0}, LinesMax {0, 0};
+
+    /* Lattice cells shifts, which content box intersects frame, evaluation function.
+     * ARGUMENTS:
+     *   - Cell content bounding box:
+     *       const coordf &Min, &Max;
+     *   - Shifts (out, cleared):
+     *       std::vector<coordf> &Shifts;
+     */
+    void GetCellShifts( const coordf &Min, const coordf &Max, std::vector<coordf> &Shifts ) const;
+
+    /* Evenly spaced lines occupancy grid (over frame at evaluation start) */
+    phys::line_spacing Spacing {};
+
+    /* Evenly spaced seeded lines (forward and backward halves by pairs), first line of last round and rounds count */
+    std::deque<std::vector<coordf>> SpaceLines {};
+    size_t SeededFrom {0}, SeedRounds {0};
+
+    /* Suspended lines with saved evaluation state by world tile of their last point */
+    std::unordered_map<UINT64, std::vector<thread_data>> SuspendedTiles {};
+
+    /* Suspended far field rays by world tile of their last point (their lines are complete in region, so they do not block lines caching) */
+    std::unordered_map<UINT64, std::vector<thread_data>> SuspendedRays {};
+
+    /* Equipotential lines evaluator */
+    phys::equipotentials Contours {};
+
+    /* Background heatmap rasterizer, its last composed pixels and their size */
+    phys::heatmap Heatmap {};
+    std::vector<DWORD> HeatmapPixels {};
+    INT HeatmapW {0}, HeatmapH {0};
+
+    /* LIC texture, its resolution divider (0 <=> not sent to renderer), evaluation cost and scene change flag */
+    phys::lic Lic {};
+    INT LicScale {0};
+    dbl LicMsPerPixel {0};
+    bool IsLicChanged {false};
+
     /* Lines data by threads update flag */
-    bool ThreadsDataUpdated = false;
+    std::atomic_bool ThreadsDataUpdated {false};
 
     /* Renderer class */
     render Renderer;
@@ -203,6 +665,31 @@ namespace prj
      */
     void Idle( void ) final { Responce(); }
 
+    /* Idle waiting timeout getting callback.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (DWORD) Milliseconds to wait for messages before next 'Idle' call.
+     */
+    DWORD IdleTimeout( void ) final
+    {
+      return Scheduler.GetTimeout(IsInteractive, Redraw || ThreadsDataUpdated);
+    } /* End of 'IdleTimeout' function */
+
+    /* Idle waiting wake event getting callback.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (HANDLE) Event object which interrupts waiting.
+     */
+    HANDLE IdleWakeEvent( void ) final { return Scheduler.GetWakeEvent(); }
+
+    /* Idle waiting finish callback.
+     * ARGUMENTS:
+     *   - Waiting result:
+     *       DWORD WaitResult;
+     * RETURNS: None.
+     */
+    void Wakeup( DWORD WaitResult ) final { Scheduler.Wakeup(WaitResult); }
+
     /* WM_COMMAND window message handle function.
      * ARGUMENTS:
      *   - Menu button ID:
@@ -215,9 +702,6 @@ namespace prj
     /* Animation state responce function */
     void Responce( void );
 
-    /* Render frequency control */
-    UINT64 RenderTime = 0, RenderTimeFreq;
-
     /* Render function */
     void Render( void );
   }; /* end of 'anim' class */
@@ -0,0 +1,1028 @@
+/* FILE NAME   : 'anim_eval.cpp'
+ * PURPOSE     : Animation module.
+ *               Force lines evaluation control implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj'.
+ */
+
+#include <pch.h>
+
+#include "anim.h"
+#include "utility/physics/ef_nulls.h"
+#include "utility/physics/ef_field.h"
+#include "utility/physics/ef_seeding.h"
+#include "utility/physics/ef_ewald.h"
+#include "utility/cpu_isa/cpu_isa.h"
+
+/* Project namespace */
+namespace prj
+{
+  /* Nearest seed angle searching function.
+   * ARGUMENTS:
+   *   - Seed angles (not empty):
+   *       const std::vector<dbl> &Seeds;
+   *   - Angle:
+   *       dbl Angle;
+   *   - Angular distance to nearest seed (out):
+   *       dbl &Distance;
+   * RETURNS:
+   *   (size_t) Nearest seed index.
+   */
+  static size_t NearestSeed( const std::vector<dbl> &Seeds, dbl Angle, dbl &Distance )
+  {
+    size_t Nearest {0};
+
+    Distance = std::numeric_limits<dbl>::max();
+    for (size_t i = 0; i < Seeds.size(); i++)
+    {
+      const dbl Delta {abs(remainder(Angle - Seeds[i], 2 * M_PI))};
+
+      if (Delta < Distance)
+        Distance = Delta, Nearest = i;
+    }
+
+    return Nearest;
+  } /* End of 'NearestSeed' function */
+
+  /* Line end at charge (or at its lattice image) check function.
+   * ARGUMENTS:
+   *   - Line end and previous point:
+   *       const coordf &End, &Prev;
+   *   - Charge:
+   *       const phys::charge &Elm;
+   *   - Lattice evaluator (nullptr - charges are isolated):
+   *       const phys::ewald_sum *Periodic;
+   *   - Arrival seed contour parameter (out, set only for ended line):
+   *       dbl &Param;
+   * RETURNS:
+   *   (bool) true if line ends at charge center (at nearest point of extended source).
+   */
+  static bool IsLineEnd( const coordf &End, const coordf &Prev, const phys::charge &Elm, const phys::ewald_sum *Periodic, dbl &Param )
+  {
+    dbl DX {End.X - Elm.Coord.X}, DY {End.Y - Elm.Coord.Y};
+
+    if (Periodic != nullptr)
+      Periodic->Wrap(DX, DY);
+
+    /* Extended source line ends on source, arrival point is projected to seed contour */
+    if (phys::IsExtended(Elm))
+    {
+      const coordd Local {Elm.Coord.X + DX, Elm.Coord.Y + DY};
+
+      if (phys::SourceDistance(Elm, Local) >= Elm.Size * 1e-2)
+        return false;
+
+      Param = phys::SourceParam(Elm, {Local.X + Prev.X - End.X, Local.Y + Prev.Y - End.Y}, Elm.Size * 2);
+      return true;
+    }
+
+    /* Image center is stored in single precision after cell shift */
+    if (Periodic == nullptr ? End.X != (flt)Elm.Coord.X || End.Y != (flt)Elm.Coord.Y : hypot(DX, DY) >= Elm.Size * 1e-3)
+      return false;
+
+    Param = atan2(Prev.Y - End.Y, Prev.X - End.X);
+    return true;
+  } /* End of 'IsLineEnd' function */
+
+  /* Charge where line ends finding function.
+   * Only charges near line end are tested, lattice images are not placed in charges grid, so all charges are tested in lattice mode.
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const phys::charge_pool &Charges;
+   *   - Line end and previous point:
+   *       const coordf &End, &Prev;
+   *   - Charge sign (positive - sources, negative - sinks):
+   *       dbl Sign;
+   *   - Lattice evaluator (nullptr - charges are isolated):
+   *       const phys::ewald_sum *Periodic;
+   *   - Tested charges indices storage:
+   *       std::vector<size_t> &Near;
+   *   - Arrival seed contour parameter (out, set only for ended line):
+   *       dbl &Param;
+   * RETURNS:
+   *   (size_t) Charge index in pool order (charges count if line does not end at charge).
+   */
+  static size_t FindLineEnd( const phys::charge_pool &Charges, const coordf &End, const coordf &Prev, dbl Sign,
+                             const phys::ewald_sum *Periodic, std::vector<size_t> &Near, dbl &Param )
+  {
+    if (Periodic == nullptr)
+      Charges.FindNear({End.X, End.Y}, 0, Near);
+    else
+    {
+      Near.resize(Charges.Size());
+      std::iota(Near.begin(), Near.end(), 0);
+    }
+
+    for (const size_t Index : Near)
+      if (Charges[Index].Charge * Sign > 0 && IsLineEnd(End, Prev, Charges[Index], Periodic, Param))
+        return Index;
+
+    return Charges.Size();
+  } /* End of 'FindLineEnd' function */
+
+  /* Scene with evaluation settings hash evaluation function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (UINT64) Hash value.
+   */
+  UINT64 anim::EvalHash( void ) const
+  {
+    UINT64 Hash {scene_history::Hash(Charges, IsPeriodic ? phys::boundary {} : Boundary)};
+
+    Hash = HashBytes(&LinesPerCharge, sizeof(LinesPerCharge), Hash);
+    Hash = HashBytes(&LineLengthCoeff, sizeof(LineLengthCoeff), Hash);
+    Hash = HashBytes(&EvenSpacing, sizeof(EvenSpacing), Hash);
+    Hash = HashBytes(&FluxSeeding, sizeof(FluxSeeding), Hash);
+    Hash = HashBytes(&SinkSeeding, sizeof(SinkSeeding), Hash);
+    Hash = HashBytes(&SymmetryReplication, sizeof(SymmetryReplication), Hash);
+    Hash = HashBytes(&DeterministicTracing, sizeof(DeterministicTracing), Hash);
+
+    /* Lattice lines depend on cell */
+    if (IsPeriodic)
+    {
+      Hash = HashBytes(&CellW, sizeof(CellW), Hash);
+      Hash = HashBytes(&CellH, sizeof(CellH), Hash);
+    }
+
+    /* Evenly spaced lines depend on frame (spacing grid origin, extent and separation) */
+    if (EvenSpacing)
+    {
+      const dbl Frame[] {Left, Bottom, Right, Top, (Right - Left) * LineSpacing};
+
+      Hash = HashBytes(Frame, sizeof(Frame), Hash);
+    }
+
+    return HashBytes(&LineEvalLength, sizeof(LineEvalLength), Hash);
+  } /* End of 'anim::EvalHash' function */
+
+  /* Finished traced lines storing to cache function */
+  void anim::StoreLinesCache( void )
+  {
+    lines_set Set {};
+    size_t Bytes {sizeof(lines_set)};
+
+    Set.reserve(Charges.Size() + 1);
+    for (size_t i = 0; i < Charges.Size(); i++)
+    {
+      auto &Lines {Set.emplace_back()};
+      const auto *ChargeLinesSet {ChargeLines.Find(Charges.Handle(i))};
+
+      if (ChargeLinesSet == nullptr)
+        continue;
+
+      Lines.reserve(ChargeLinesSet->size());
+      for (const auto &Line : *ChargeLinesSet)
+      {
+        Lines.emplace_back(Line.begin(), Line.end());
+        Bytes += sizeof(Line) + Line.size() * sizeof(coordf);
+      }
+
+      Bytes += sizeof(Lines);
+    }
+
+    auto &Lines {Set.emplace_back()};
+
+    Lines.reserve(SpaceLines.size());
+    for (const auto &Line : SpaceLines)
+    {
+      Lines.emplace_back(Line.begin(), Line.end());
+      Bytes += sizeof(Line) + Line.size() * sizeof(coordf);
+    }
+
+    LinesCache.Put(TracedHash, std::move(Set), Bytes);
+  } /* End of 'anim::StoreLinesCache' function */
+
+  /* Line evaluation task adding function.
+   * ARGUMENTS:
+   *   - Line source charge handle:
+   *       phys::charge_handle Source;
+   *   - Line seed angle (seed contour parameter for extended source):
+   *       dbl Angle;
+   *   - Line points storage:
+   *       std::vector<coordf> &Line;
+   *   - Coarse evaluation flag:
+   *       bool IsCoarse;
+   *   - Evenly spaced line identifier (0 if line is not limited by other lines):
+   *       UINT32 SpacingId;
+   */
+  void anim::AddLineTask( phys::charge_handle Source, dbl Angle, std::vector<coordf> &Line, bool IsCoarse, UINT32 SpacingId )
+  {
+    const auto &Elm {*Charges.Get(Source)};
+
+    /* Line starts in nearest source point (charge center for point charge) */
+    coordd Start;
+    const coordd Base {phys::SourceContour(Elm, Angle, Elm.Size * 2.0, Start)};
+
+    /* Coarse lines have same length with less points */
+    const dbl StepMul {IsCoarse ? CoarseStepMul : 1.0};
+
+    Line.clear();
+    Line.reserve(std::max<size_t>((size_t)(LineEvalLength / StepMul), 2));
+    Line.push_back(coordf {(flt)Start.X, (flt)Start.Y});
+    Line.push_back(coordf {(flt)Base.X, (flt)Base.Y});
+
+    phys::ef_force_line LineEval {Base, LineLengthCoeff * StepMul, Charges, LineEnv};
+
+    /* Lines from negative charges are traced against field */
+    if (Elm.Charge < 0)
+      LineEval.SetBackward();
+
+    /* Far field rays end on region of interest bounds, lines stop near field null points.
+     * Replicated lines are traced completely, so their rays end far around symmetry center */
+    if (Symmetry.GetOrder() > 1)
+      LineEval.SetBounds({Symmetry.Center.X - SymmetryBounds, Symmetry.Center.Y - SymmetryBounds},
+                         {Symmetry.Center.X + SymmetryBounds, Symmetry.Center.Y + SymmetryBounds});
+    else
+      LineEval.SetBounds({EvalRoi.Left, EvalRoi.Bottom}, {EvalRoi.Right, EvalRoi.Top});
+    LineEval.SetNulls(&Nulls, LineLengthCoeff * NullRadiusCoeff);
+    LineEval.SetPeriodic(Periodic.get());
+    if (DeterministicTracing)
+      LineEval.SetDeterministic();
+    ThreadsPool.AddTask(std::move(LineEval), &Line, Source, Elm.Charge < 0, IsCoarse, SpacingId);
+  } /* End of 'anim::AddLineTask' function */
+
+  /* Evenly spaced line evaluation tasks (both directions from seed) adding function.
+   * ARGUMENTS:
+   *   - Seed position:
+   *       const coordd &Seed;
+   *   - Evenly spaced line identifier:
+   *       UINT32 SpacingId;
+   */
+  void anim::AddSeedTasks( const coordd &Seed, UINT32 SpacingId )
+  {
+    /* Backward half is reversed after round, so both halves keep field direction */
+    for (const bool IsBackward : {false, true})
+    {
+      auto &Line {SpaceLines.emplace_back()};
+
+      Line.reserve(std::max<size_t>(LineEvalLength, 2));
+      Line.push_back(coordf {(flt)Seed.X, (flt)Seed.Y});
+
+      phys::ef_force_line LineEval {Seed, LineLengthCoeff, Charges, LineEnv};
+
+      if (IsBackward)
+        LineEval.SetBackward();
+      LineEval.SetBounds({EvalRoi.Left, EvalRoi.Bottom}, {EvalRoi.Right, EvalRoi.Top});
+      LineEval.SetNulls(&Nulls, LineLengthCoeff * NullRadiusCoeff);
+      LineEval.SetPeriodic(Periodic.get());
+      if (DeterministicTracing)
+        LineEval.SetDeterministic();
+      ThreadsPool.AddTask(std::move(LineEval), &Line, phys::charge_handle {}, false, false, SpacingId);
+    }
+  } /* End of 'anim::AddSeedTasks' function */
+
+  /* Line evaluation task priority evaluation function.
+   * ARGUMENTS:
+   *   - Line source charge handle:
+   *       phys::charge_handle Source;
+   * RETURNS:
+   *   (flt) Priority (greater are traced first).
+   */
+  flt anim::LinePriority( phys::charge_handle Source ) const
+  {
+    /* Seeded lines are always in frame */
+    if (!Source.IsValid())
+      return 1;
+
+    if (Source == SelectedCharge)
+      return 2;
+
+    const auto *Elm {Charges.Get(Source)};
+
+    if (Elm == nullptr)
+      return 0;
+
+    const dbl Radius {phys::SourceRadius(Elm->Shape) + Elm->Size};
+
+    if (Elm->Coord.X + Radius >= Left && Elm->Coord.X - Radius <= Right &&
+        Elm->Coord.Y + Radius >= Bottom && Elm->Coord.Y - Radius <= Top)
+      return 1;
+
+    return 0;
+  } /* End of 'anim::LinePriority' function */
+
+  /* Line evaluation tasks reprioritization (after frame or selection change) function */
+  void anim::UpdatePriorities( void )
+  {
+    /* Single thread deterministic tracing keeps insertion order (pool restart changes interleaving) */
+    if (TracingThreads() == 1)
+      return;
+
+    /* Only task source is read, it is not changed by threads */
+    ThreadsPool.SetPriorities([this]( const thread_data &Data ) -> flt
+      {
+        return LinePriority(Data.Source);
+      });
+  } /* End of 'anim::UpdatePriorities' function */
+
+  /* Line evaluation threads count getting function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (size_t) Threads count for pool run (0 - auto).
+   */
+  size_t anim::TracingThreads( void ) const
+  {
+    /* Evenly spaced lines stop on other lines, so their points depend on threads interleaving */
+    return DeterministicTracing && EvenSpacing ? 1 : 0;
+  } /* End of 'anim::TracingThreads' function */
+
+  /* Region of interest around current frame evaluation function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (roi) Frame with margin.
+   */
+  anim::roi anim::GetFrameRoi( void ) const
+  {
+    const dbl
+      MarginX {(Right - Left) * RoiMargin},
+      MarginY {(Top - Bottom) * RoiMargin};
+
+    return {Left - MarginX, Top + MarginY, Right + MarginX, Bottom - MarginY};
+  } /* End of 'anim::GetFrameRoi' function */
+
+  /* Suspended by threads lines queue to tiles storage moving function */
+  void anim::CollectSuspended( void )
+  {
+    std::lock_guard<std::mutex> Lock {SuspendMutex};
+
+    for (auto &Data : SuspendQueue)
+    {
+      const auto &Pt {Data.LineData->back()};
+
+      (Data.IsRay ? SuspendedRays : SuspendedTiles)[TileKey((INT)floor(Pt.X / RoiTileSize), (INT)floor(Pt.Y / RoiTileSize))].push_back(std::move(Data));
+    }
+
+    RoiStats.Suspended += SuspendQueue.size();
+    SuspendQueue.clear();
+  } /* End of 'anim::CollectSuspended' function */
+
+  /* Region of interest updating (after frame move) and suspended lines resuming function */
+  void anim::UpdateRoi( void )
+  {
+    /* Passes restart threads pool, so suspended lines are resumed only between edits */
+    if (EvalPass != eval_pass::Done && EvalPass != eval_pass::Resume)
+      return;
+
+    /* Region is moved only when frame reaches half of margin */
+    const roi Inner {GetFrameRoi()};
+    const dbl
+      HalfMarginX {(Right - Left) * RoiMargin * 0.5},
+      HalfMarginY {(Top - Bottom) * RoiMargin * 0.5};
+
+    if (Left - HalfMarginX >= EvalRoi.Left && Right + HalfMarginX <= EvalRoi.Right &&
+        Bottom - HalfMarginY >= EvalRoi.Bottom && Top + HalfMarginY <= EvalRoi.Top)
+      return;
+
+    /* Threads read region of interest */
+    if (EvalPass == eval_pass::Done)
+      ThreadsPool.Terminate();
+    else
+      ThreadsPool.Pause();
+
+    CollectSuspended();
+
+    EvalRoi = Inner;
+    RoiStats.Moves++;
+
+    UpdateContours(EvalRoi);
+
+    /* Resume lines and far field rays from tiles intersecting new region */
+    size_t Resumed {0};
+
+    for (auto *Tiles : {&SuspendedTiles, &SuspendedRays})
+      for (auto It {Tiles->begin()}; It != Tiles->end();)
+      {
+        const dbl
+          TileX {(dbl)(INT)(It->first >> 32) * RoiTileSize},
+          TileY {(dbl)(INT)(It->first & 0xFFFFFFFF) * RoiTileSize};
+
+        if (TileX + RoiTileSize < EvalRoi.Left || TileX > EvalRoi.Right ||
+            TileY + RoiTileSize < EvalRoi.Bottom || TileY > EvalRoi.Top)
+        {
+          ++It;
+          continue;
+        }
+
+        for (auto &Data : It->second)
+        {
+          Data.LineEval.SetBounds({EvalRoi.Left, EvalRoi.Bottom}, {EvalRoi.Right, EvalRoi.Top});
+          ThreadsPool.AddTask(std::move(Data));
+        }
+
+        Resumed += It->second.size();
+        It = Tiles->erase(It);
+      }
+
+    RoiStats.Resumed += Resumed;
+
+    if (Resumed != 0)
+      EvalPass = eval_pass::Resume;
+
+    if (EvalPass == eval_pass::Resume)
+    {
+      UpdatePriorities();
+      ThreadsPool.Run(TracingThreads());
+    }
+  } /* End of 'anim::UpdateRoi' function */
+
+  /* Evaluation pass starting function.
+   * ARGUMENTS:
+   *   - Pass to start:
+   *       eval_pass Pass;
+   */
+  void anim::StartPass( eval_pass Pass )
+  {
+    /* Remove previous pass tasks */
+    ThreadsPool.Terminate();
+
+    EvalPass = Pass;
+    if (Pass == eval_pass::Done)
+      return;
+
+    /* Lines are traced only around current frame */
+    EvalRoi = GetFrameRoi();
+
+    /* Coarse seeds are every 'CoarseLinesDiv' seed, other are added on fill pass.
+     * Fill and refine passes use divider of coarse pass, so they match its lines and reserved storage */
+    if (Pass == eval_pass::Coarse)
+      PassDiv = CoarseLinesDiv;
+
+    const size_t Div {Pass == eval_pass::Full ? 1 : PassDiv};
+
+    if (Pass == eval_pass::Full || Pass == eval_pass::Coarse)
+    {
+      SpaceLines.clear();
+      SeededFrom = 0, SeedRounds = 0;
+
+      /* Evenly spaced lines density is controlled in current frame */
+      if (EvenSpacing)
+        Spacing.Reset({Left, Bottom}, {Right, Top}, (Right - Left) * LineSpacing, LineLengthCoeff * 0.5, Charges);
+    }
+
+    auto ChargeSeeds {SeedAnglesSet.cbegin()};
+
+    for (size_t c = 0; c < Charges.Size(); c++)
+    {
+      const phys::charge_handle Handle {Charges.Handle(c)};
+      const auto &Elm {Charges[c]};
+      auto &Lines {ChargeLines[Handle]};
+
+      if (Pass == eval_pass::Full || Pass == eval_pass::Coarse)
+        Lines.clear();
+
+      /* Seed angles are placed once per edit (all passes use same seeds) */
+      if (ChargeSeeds == SeedAnglesSet.cend())
+        break;
+
+      const auto &Seeds {*ChargeSeeds++};
+      const size_t Cnt {Seeds.size()};
+
+      /* Lines from negative charges are traced on separate pass */
+      if (Elm.Charge < 0)
+        continue;
+
+      /* Threads hold pointers to lines, so storage is never reallocated during evaluation */
+      Lines.reserve(Cnt);
+
+      for (size_t i = 0, CoarseIndex = 0; i < Cnt; i++)
+      {
+        const dbl Angle {Seeds[i]};
+        const bool IsCoarseSeed {i % Div == 0};
+
+        switch (Pass)
+        {
+        case eval_pass::Full:
+          AddLineTask(Handle, Angle, Lines.emplace_back(), false, EvenSpacing ? Spacing.NewLine() : 0);
+          break;
+        case eval_pass::Coarse:
+          if (IsCoarseSeed)
+            AddLineTask(Handle, Angle, Lines.emplace_back(), true);
+          break;
+        case eval_pass::Fill:
+          if (!IsCoarseSeed)
+            AddLineTask(Handle, Angle, Lines.emplace_back(), false);
+          break;
+        case eval_pass::Refine:
+          /* Coarse lines are first in charge lines */
+          if (IsCoarseSeed)
+          {
+            auto &Staged {RefineLines.emplace_back(&Lines[CoarseIndex++], std::vector<coordf> {})};
+
+            AddLineTask(Handle, Angle, Staged.second, false);
+          }
+          break;
+        default:
+          break;
+        }
+      }
+    }
+
+    /* Start threads with visible lines first */
+    UpdatePriorities();
+    ThreadsPool.Run(TracingThreads());
+  } /* End of 'anim::StartPass' function */
+
+  /* Evaluation starting (after scene edit) function */
+  void anim::Evaluate( void )
+  {
+    /* Stop all threads */
+    ThreadsPool.Terminate();
+    RefineLines.clear();
+
+    /* Suspended lines belong to previous scene */
+    CollectSuspended();
+    SuspendedTiles.clear();
+    SuspendedRays.clear();
+
+    /* Lattice evaluator (reciprocal terms depend on all charges) */
+    if (IsPeriodic && CellW > 0 && CellH > 0)
+    {
+      UINT64 Start, End;
+
+      QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+      Periodic = std::make_unique<phys::ewald_sum>(Charges, phys::periodic_cell {CellW, CellH});
+      QueryPerformanceCounter((LARGE_INTEGER *)&End);
+
+      PeriodicStats.Builds++;
+      PeriodicStats.BuildTime = (End - Start) * 1000.0 / TimeFreq;
+    }
+    else
+      Periodic.reset();
+
+    /* Grounded boundary images are not periodic, so boundary is ignored in lattice mode */
+    EvalBoundary = Periodic == nullptr ? Boundary : phys::boundary {};
+    LineEnv = phys::line_environment {Charges, EvalBoundary};
+
+    const UINT64 Hash {EvalHash()};
+    const auto *Cached {LinesCache.Find(Hash)};
+
+    /* Texture mode shows field without lines */
+    if (LicMode)
+    {
+      ChargeLines.Clear();
+      SpaceLines.clear();
+
+      EvalPass = eval_pass::Done;
+      IsLicChanged = true;
+    }
+    /* Take lines from cache if this scene was already evaluated */
+    else if (Cached != nullptr && Cached->size() == Charges.Size() + 1)
+    {
+      auto CachedLines {Cached->begin()};
+
+      for (size_t i = 0; i < Charges.Size(); i++)
+        ChargeLines[Charges.Handle(i)] = *CachedLines++;
+      SpaceLines.assign(CachedLines->begin(), CachedLines->end());
+
+      EvalPass = eval_pass::Done;
+    }
+    else
+    {
+      QueryPerformanceCounter((LARGE_INTEGER *)&EvalStartTime);
+
+      /* Null points pre-pass */
+      Nulls = phys::FindNulls(Charges, Periodic.get(), EvalBoundary);
+
+      /* Symmetry pre-pass (negative charges and evenly spaced lines depend on tracing order, so they are not replicated,
+       * lattice lines cross cells and boundary images break charges symmetry, so they are not replicated too) */
+      Symmetry = SymmetryReplication && !SinkSeeding && !EvenSpacing && Periodic == nullptr && !EvalBoundary.IsValid() ?
+        phys::FindSymmetry(Charges, SymmetryTolerance) : phys::symmetry {};
+
+      /* Seeds placement pre-pass (negative charges are seeded only for lines traced against field) */
+      {
+        std::vector<size_t> Counts {};
+        UINT64 Start, End;
+
+        QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+
+        Counts.reserve(Charges.Size());
+        for (const auto &Elm : Charges)
+          Counts.push_back(Elm.Charge < 0 && !SinkSeeding ? 0 : (size_t)round(LinesPerCharge * abs(Elm.Charge)));
+        if (Periodic != nullptr || EvalBoundary.IsValid())
+          SeedAnglesSet = phys::SeedAngles(Charges, Counts, FluxSeeding, {}, Periodic.get(), EvalBoundary);
+        else
+          SeedAnglesSet = phys::SymmetricSeedAngles(Charges, Symmetry, Counts, FluxSeeding);
+
+        QueryPerformanceCounter((LARGE_INTEGER *)&End);
+        SeedingTime = (End - Start) * 1000.0 / TimeFreq;
+      }
+
+      if (Symmetry.GetOrder() > 1)
+      {
+        SymmetryStats.Scenes++;
+        for (const auto &Seeds : SeedAnglesSet)
+          SymmetryStats.Traced += Seeds.size();
+      }
+
+      TracedHash = Hash;
+
+      /* Evenly spaced and replicated lines are taken from complete lines, so they are traced without progressive passes */
+      StartPass(Progressive && !EvenSpacing && Symmetry.GetOrder() == 1 ? eval_pass::Coarse : eval_pass::Full);
+    }
+
+    UpdateContours(GetFrameRoi());
+    Heatmap.Invalidate(Charges, Periodic.get(), EvalBoundary);
+
+    ThreadsDataUpdated = true;
+    Redraw = true;
+  } /* End of 'anim::Evaluate' function */
+
+  /* Evaluation passes switching function (called every responce) */
+  void anim::UpdateEvaluation( void )
+  {
+    if (EvalPass == eval_pass::Done || !ThreadsPool.IsDone())
+      return;
+
+    /* All lines which left region of interest are queued after threads finish */
+    CollectSuspended();
+
+    switch (EvalPass)
+    {
+    case eval_pass::Coarse:
+    {
+      /* Show coarse lines immediately */
+      ThreadsDataUpdated = true;
+      Render();
+
+      UINT64 Time;
+      QueryPerformanceCounter((LARGE_INTEGER *)&Time);
+
+      auto &Stats {ProgressiveStats};
+      const dbl FirstLines {(Time - EvalStartTime) * 1000.0 / TimeFreq};
+
+      Stats.FirstLinesLast = FirstLines;
+      Stats.FirstLinesAvg = Stats.Edits == 0 ? FirstLines : Stats.FirstLinesAvg + (FirstLines - Stats.FirstLinesAvg) * 0.1;
+      Stats.FirstLinesMax = std::max(Stats.FirstLinesMax, FirstLines);
+      Stats.Edits++;
+
+      /* Adapt coarse lines count to time budget (current edit passes keep their divider) */
+      if (FirstLines > FirstLinesBudget)
+      {
+        Stats.OverBudget++;
+        CoarseLinesDiv = std::min<size_t>(CoarseLinesDiv * 2, 64);
+      }
+      else if (FirstLines < FirstLinesBudget * 0.25 && CoarseLinesDiv > 1)
+        CoarseLinesDiv /= 2;
+
+      StartPass(eval_pass::Fill);
+      break;
+    }
+    case eval_pass::Fill:
+      StartPass(eval_pass::Refine);
+      break;
+    case eval_pass::Refine:
+    {
+      /* Replace coarse lines with refined ones */
+      std::unordered_map<std::vector<coordf> *, std::vector<coordf> *> Staging {};
+
+      for (auto &[Line, Refined] : RefineLines)
+      {
+        Line->swap(Refined);
+        Staging.emplace(&Refined, Line);
+      }
+
+      /* Suspended refined lines continue in place of coarse ones */
+      if (!Staging.empty())
+        for (auto *Tiles : {&SuspendedTiles, &SuspendedRays})
+          for (auto &[Key, Tile] : *Tiles)
+            for (auto &Data : Tile)
+              if (auto It {Staging.find(Data.LineData)}; It != Staging.end())
+                Data.LineData = It->second;
+
+      RefineLines.clear();
+    }
+
+      [[fallthrough]];
+    case eval_pass::Full:
+      /* Fundamental domain lines are copied to whole scene */
+      if (EvalPass == eval_pass::Full)
+        SymmetryStats.Replicated += phys::ReplicateLines(Charges, ChargeLines, Symmetry);
+
+      /* Lines from negative charges are traced only where no other line came */
+      if (SinkSeeding && SeedSinks())
+        break;
+
+      [[fallthrough]];
+    case eval_pass::Sinks:
+      if (EvalPass == eval_pass::Sinks)
+        FinishSinks();
+
+      [[fallthrough]];
+    case eval_pass::Seed:
+      /* Next evenly spaced lines round is seeded from lines of previous one */
+      if (EvenSpacing && SeedSpace())
+        break;
+
+      [[fallthrough]];
+    case eval_pass::Resume:
+      StartPass(eval_pass::Done);
+
+      /* Only completely traced scenes are cached (far field rays are complete up to region bounds,
+       * cached scene keeps them as traced) */
+      if (SuspendedTiles.empty())
+        StoreLinesCache();
+
+      ThreadsDataUpdated = true;
+      break;
+    default:
+      break;
+    }
+  } /* End of 'anim::UpdateEvaluation' function */
+
+  /* Negative charges lines pass starting function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (bool) true if any line was seeded.
+   */
+  bool anim::SeedSinks( void )
+  {
+    std::vector<std::vector<bool>> IsMatched {};
+
+    IsMatched.reserve(SeedAnglesSet.size());
+    for (const auto &Seeds : SeedAnglesSet)
+      IsMatched.emplace_back(Seeds.size(), false);
+
+    /* Lines from positive charges end exactly at negative charge center, previous point gives arrival angle */
+    std::vector<size_t> Near {};
+
+    for (size_t c = 0; c < Charges.Size(); c++)
+      if (const auto *Lines {ChargeLines.Find(Charges.Handle(c))}; Charges[c].Charge > 0 && Lines != nullptr)
+        for (const auto &Line : *Lines)
+        {
+          if (Line.size() < 2)
+            continue;
+
+          const coordf &End {Line.back()}, &Prev {Line[Line.size() - 2]};
+          dbl Param;
+          const size_t Index {FindLineEnd(Charges, End, Prev, -1, Periodic.get(), Near, Param)};
+
+          /* Arrived line represents seed of nearest sector */
+          if (Index < SeedAnglesSet.size() && !SeedAnglesSet[Index].empty())
+          {
+            dbl Distance;
+
+            IsMatched[Index][NearestSeed(SeedAnglesSet[Index], Param, Distance)] = true;
+          }
+        }
+
+    /* Not matched seeds are traced */
+    size_t Added {0}, Index {0};
+
+    ThreadsPool.Terminate();
+    for (; Index < Charges.Size(); Index++)
+    {
+      const phys::charge_handle Handle {Charges.Handle(Index)};
+
+      if (Charges[Index].Charge < 0 && Index < SeedAnglesSet.size())
+      {
+        const auto &Seeds {SeedAnglesSet[Index]};
+        auto &Lines {ChargeLines[Handle]};
+
+        /* Threads hold pointers to lines, so storage is never reallocated during evaluation */
+        Lines.clear();
+        Lines.reserve(Seeds.size());
+
+        for (size_t i = 0; i < Seeds.size(); i++)
+          if (IsMatched[Index][i])
+            SinksStats.Matched++;
+          else
+          {
+            AddLineTask(Handle, Seeds[i], Lines.emplace_back(), false, EvenSpacing ? Spacing.NewLine() : 0);
+            Added++;
+          }
+
+        SinksStats.Seeds += Seeds.size();
+      }
+    }
+
+    if (Added == 0)
+      return false;
+
+    EvalPass = eval_pass::Sinks;
+    UpdatePriorities();
+    ThreadsPool.Run(TracingThreads());
+    return true;
+  } /* End of 'anim::SeedSinks' function */
+
+  /* Negative charges lines pass finishing function */
+  void anim::FinishSinks( void )
+  {
+    /* Line which reached positive charge near its seed is already traced from that seed */
+    std::vector<size_t> Near {};
+
+    auto IsDuplicate = [this, &Near]( const std::vector<coordf> &Line ) -> bool
+      {
+        if (Line.size() < 2)
+          return false;
+
+        const coordf &End {Line.back()}, &Prev {Line[Line.size() - 2]};
+        dbl Param;
+        const size_t Index {FindLineEnd(Charges, End, Prev, 1, Periodic.get(), Near, Param)};
+
+        if (Index >= SeedAnglesSet.size() || SeedAnglesSet[Index].empty())
+          return false;
+
+        const auto &Seeds {SeedAnglesSet[Index]};
+        dbl Distance;
+
+        NearestSeed(Seeds, Param, Distance);
+        return Distance < M_PI / (2 * Seeds.size());
+      };
+
+    for (size_t i = 0; i < Charges.Size(); i++)
+      if (Charges[i].Charge < 0)
+      {
+        auto &Lines {ChargeLines[Charges.Handle(i)]};
+
+        SinksStats.Duplicates += std::erase_if(Lines, IsDuplicate);
+
+        /* Lines are drawn in field direction */
+        for (auto &Line : Lines)
+          std::reverse(Line.begin(), Line.end());
+      }
+
+    ThreadsDataUpdated = true;
+  } /* End of 'anim::FinishSinks' function */
+
+  /* Evenly spaced lines seeding round starting function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (bool) true if any line was seeded.
+   */
+  bool anim::SeedSpace( void )
+  {
+    /* Backward halves of last round lines are reversed to field direction */
+    for (size_t i = SeededFrom + 1; i < SpaceLines.size(); i += 2)
+      std::reverse(SpaceLines[i].begin(), SpaceLines[i].end());
+
+    if ((EvalPass != eval_pass::Full && EvalPass != eval_pass::Sinks && EvalPass != eval_pass::Seed) ||
+        SeedRounds >= MaxSeedRounds)
+      return false;
+
+    /* First round is seeded aside charges lines */
+    std::vector<std::pair<coordd, UINT32>> Seeds {};
+
+    if (SeedRounds == 0)
+    {
+      for (size_t i = 0; i < Charges.Size(); i++)
+        if (const auto *Lines {ChargeLines.Find(Charges.Handle(i))}; Lines != nullptr)
+          for (const auto &Line : *Lines)
+            Spacing.FindSeeds(Line, Seeds);
+    }
+    else
+      for (size_t i = SeededFrom; i < SpaceLines.size(); i++)
+        Spacing.FindSeeds(SpaceLines[i], Seeds);
+
+    SeededFrom = SpaceLines.size();
+    if (Seeds.empty())
+      return false;
+
+    ThreadsPool.Terminate();
+
+    EvalPass = eval_pass::Seed;
+    SeedRounds++;
+
+    for (const auto &[Seed, Id] : Seeds)
+      AddSeedTasks(Seed, Id);
+
+    UpdatePriorities();
+    ThreadsPool.Run(TracingThreads());
+
+    ThreadsDataUpdated = true;
+    return true;
+  } /* End of 'anim::SeedSpace' function */
+
+  /* Equipotential lines update function.
+   * ARGUMENTS:
+   *   - Contours region:
+   *       const roi &Region;
+   */
+  void anim::UpdateContours( const roi &Region )
+  {
+    if (!DrawEquipotentials)
+    {
+      Contours.Clear();
+      return;
+    }
+
+    std::vector<dbl> Levels {};
+
+    Levels.reserve(EquipotentialLevels * 2 + 1);
+    for (INT i = -(INT)EquipotentialLevels; i <= (INT)EquipotentialLevels; i++)
+      Levels.push_back(i * EquipotentialStep);
+
+    /* Single moved charge with same region is updated incrementally */
+    Contours.SetLevels(std::move(Levels));
+    Contours.Update(Charges, {Region.Left, Region.Bottom}, {Region.Right, Region.Top}, Periodic.get(), EvalBoundary);
+
+    ThreadsDataUpdated = true;
+  } /* End of 'anim::UpdateContours' function */
+
+  /* Heatmap view for current frame getting function.
+   * ARGUMENTS:
+   *   - Pixels size:
+   *       INT W, H;
+   * RETURNS:
+   *   (phys::heatmap_view) View.
+   */
+  phys::heatmap_view anim::GetHeatmapView( INT W, INT H ) const
+  {
+    /* First pixels row is at frame 'Bottom' */
+    return {Left, Bottom, (Right - Left) / W, (Top - Bottom) / H, W, H};
+  } /* End of 'anim::GetHeatmapView' function */
+
+  /* Background heatmap refinement and sending to renderer function (called every responce) */
+  void anim::UpdateHeatmap( void )
+  {
+    /* Texture occupies background */
+    if (LicMode)
+      return;
+
+    if (Heatmap.GetMode() == phys::heatmap_mode::None)
+    {
+      if (!HeatmapPixels.empty())
+      {
+        HeatmapPixels.clear();
+        HeatmapW = HeatmapH = 0;
+        Renderer.SetBackground(nullptr, 0, 0);
+        Redraw = true;
+      }
+      return;
+    }
+
+    const phys::heatmap_view View {GetHeatmapView(W, H)};
+
+    /* One refinement pass per responce, pixels are composed again after frame move or resize */
+    const bool IsRefined {Heatmap.Update(View)};
+
+    if (!IsRefined && !Redraw && HeatmapW == W && HeatmapH == H)
+      return;
+
+    HeatmapW = W, HeatmapH = H;
+    HeatmapPixels.resize((size_t)W * H);
+    Heatmap.Compose(View, HeatmapPixels.data());
+    Renderer.SetBackground(HeatmapPixels.data(), W, H);
+    Redraw = true;
+  } /* End of 'anim::UpdateHeatmap' function */
+
+  /* LIC texture evaluation and sending to renderer function (called every responce) */
+  void anim::UpdateLic( void )
+  {
+    if (!LicMode)
+    {
+      if (LicScale != 0)
+      {
+        /* Give background back to heatmap */
+        LicScale = 0;
+        HeatmapW = HeatmapH = 0;
+        Renderer.SetBackground(nullptr, 0, 0);
+        Redraw = true;
+      }
+      return;
+    }
+
+    /* Lower resolution is used while interaction at full one would not fit frame time target */
+    INT Scale {1};
+
+    if (IsInteractive)
+      while (Scale < 4 && (dbl)W * H / (Scale * Scale) * LicMsPerPixel > LicFrameBudget)
+        Scale++;
+
+    if (!IsLicChanged && !Redraw && Scale == LicScale)
+      return;
+
+    const phys::heatmap_view View {GetHeatmapView(std::max(W / Scale, 1), std::max(H / Scale, 1))};
+
+    Lic.Update(Charges, View, Periodic.get(), EvalBoundary);
+    LicMsPerPixel = Lic.GetStats().LastTime / ((dbl)View.Width * View.Height);
+
+    Renderer.SetBackground(Lic.GetPixels().data(), View.Width, View.Height);
+    LicScale = Scale;
+    IsLicChanged = false;
+    Redraw = true;
+  } /* End of 'anim::UpdateLic' function */
+
+  /* Evaluation kernels benchmarks on current scene running function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (std::string) Benchmarks report.
+   */
+  std::string anim::RunBenchmarks( void )
+  {
+    return util::IsaReport() + "\n" +
+           phys::BenchmarkField(Charges, 1 << 18) + "\n" + phys::BenchmarkFieldScaling(Charges, 1 << 20) + "\n" +
+           phys::BenchmarkLic(Charges, W, H, LicFrameBudget) + "\n" +
+           phys::BenchmarkSeeding(Charges, LinesPerCharge) + "\n" +
+           phys::BenchmarkSources(1000, 1 << 12) + "\n" +
+           phys::BenchmarkLineSteps(1 << 16) + "\n" +
+           phys::BenchmarkDeterminism(64, 2000) + "\n" +
+           phys::BenchmarkChargeQueries(1 << 14, 1 << 12) + "\n" +
+           phys::BenchmarkSpacing(Charges, {Left, Bottom}, {Right, Top}, LinesPerCharge, LineLengthCoeff,
+                                  (Right - Left) * LineSpacing, LineEvalLength) +
+           (Periodic != nullptr ? "\n" + phys::BenchmarkEwald(Charges, Periodic->GetCell(), 1 << 12) : "") +
+           (EvalBoundary.IsValid() ? "\n" + phys::BenchmarkBoundary(Charges, EvalBoundary, 1 << 12) : "");
+  } /* End of 'anim::RunBenchmarks' function */
+} /* end of 'prj' namespace */
+
+/* END OF 'anim_eval.cpp' FILE */
@@ -0,0 +1,244 @@
+/* FILE NAME   : 'frame_scheduler.h'
+ * PURPOSE     : Animation module.
+ *               Event driven frames scheduling class handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj'.
+ */
+
+#ifndef __frame_scheduler_h__
+#define __frame_scheduler_h__
+
+#include <def.h>
+
+/* Project namespace */
+namespace prj
+{
+  /* Frames scheduler class.
+   * Main loop sleeps until input message, work notification or next frame time,
+   * without pending work it waits infinitely.
+   */
+  class frame_scheduler
+  {
+  public:
+    /* Scheduling statistics structure */
+    struct stats
+    {
+      size_t
+        Frames {0},         /* Rendered frames count */
+        InputWakeups {0},   /* Wakeups by window messages */
+        WorkWakeups {0},    /* Wakeups by work notifications */
+        TimerWakeups {0},   /* Wakeups by frame timeout */
+        IdleWaits {0},      /* Infinite (zero CPU) waits count */
+        Notifications {0};  /* Work notifications sent */
+      dbl
+        FrameTimeAvg {0},   /* Average frame render time (in ms) */
+        FrameTimeMax {0},   /* Maximal frame render time (in ms) */
+        FrameIntervalAvg {0}; /* Average interval between frames (in ms) */
+    }; /* end of 'stats' structure */
+
+  private:
+    /* Work notification event */
+    HANDLE hWakeEvent;
+
+    /* Notification is already signaled flag */
+    std::atomic_bool WakePending {false};
+
+    /* Work notifications count (notifications are sent by working threads) */
+    std::atomic<size_t> Notifications {0};
+
+    /* Time frequency, last frame start and render start time */
+    UINT64 TimeFreq {1}, LastFrame {0}, FrameStart {0};
+
+    /* Target frame rates for interactive input and for background work displaying */
+    dbl InteractiveFps {60}, WorkFps {24};
+
+    /* Statistics */
+    stats Stats {};
+
+    /* Current time getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) Performance counter value.
+     */
+    static UINT64 Now( void )
+    {
+      UINT64 Time;
+
+      QueryPerformanceCounter((LARGE_INTEGER *)&Time);
+      return Time;
+    } /* End of 'Now' function */
+
+    /* Frame period getting function.
+     * ARGUMENTS:
+     *   - Interactive input frame rate flag:
+     *       bool IsInteractive;
+     * RETURNS:
+     *   (UINT64) Period in performance counter ticks.
+     */
+    UINT64 GetPeriod( bool IsInteractive ) const
+    {
+      return (UINT64)(TimeFreq / (IsInteractive ? InteractiveFps : WorkFps));
+    } /* End of 'GetPeriod' function */
+
+  public:
+    /* Default constructor */
+    frame_scheduler( void )
+    {
+      QueryPerformanceFrequency((LARGE_INTEGER *)&TimeFreq);
+      hWakeEvent = CreateEventA(nullptr, FALSE, FALSE, nullptr);
+    } /* End of constructor */
+
+    /* Destructor */
+    ~frame_scheduler( void )
+    {
+      CloseHandle(hWakeEvent);
+    } /* End of destructor */
+
+    /* No copy/move constructor */
+    frame_scheduler( const frame_scheduler & ) = delete;
+    frame_scheduler( frame_scheduler && ) = delete;
+
+    /* Wake event getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (HANDLE) Event handle.
+     */
+    HANDLE GetWakeEvent( void ) const
+    {
+      return hWakeEvent;
+    } /* End of 'GetWakeEvent' function */
+
+    /* Work notification function (may be called from any thread).
+     * Repeated notifications before wakeup are merged.
+     */
+    void Notify( void )
+    {
+      if (!WakePending.exchange(true))
+      {
+        Notifications.fetch_add(1, std::memory_order_relaxed);
+        SetEvent(hWakeEvent);
+      }
+    } /* End of 'Notify' function */
+
+    /* Wakeup registration function.
+     * ARGUMENTS:
+     *   - Waiting result:
+     *       DWORD WaitResult;
+     */
+    void Wakeup( DWORD WaitResult )
+    {
+      if (WaitResult == WAIT_OBJECT_0)
+      {
+        WakePending = false;
+        Stats.WorkWakeups++;
+      }
+      else if (WaitResult == WAIT_OBJECT_0 + 1)
+        Stats.InputWakeups++;
+      else if (WaitResult == WAIT_TIMEOUT)
+        Stats.TimerWakeups++;
+    } /* End of 'Wakeup' function */
+
+    /* Frame rendering time check function.
+     * ARGUMENTS:
+     *   - Interactive input frame rate flag:
+     *       bool IsInteractive;
+     * RETURNS:
+     *   (bool) true if frame period is passed since last frame.
+     */
+    bool IsFrameTime( bool IsInteractive ) const
+    {
+      return Now() - LastFrame >= GetPeriod(IsInteractive);
+    } /* End of 'IsFrameTime' function */
+
+    /* Frame rendering start registration function */
+    void FrameBegin( void )
+    {
+      FrameStart = Now();
+
+      if (Stats.Frames > 0)
+      {
+        const dbl Interval {(FrameStart - LastFrame) * 1000.0 / TimeFreq};
+
+        Stats.FrameIntervalAvg += (Interval - Stats.FrameIntervalAvg) * 0.05;
+      }
+
+      LastFrame = FrameStart;
+    } /* End of 'FrameBegin' function */
+
+    /* Frame rendering end registration function */
+    void FrameEnd( void )
+    {
+      const dbl FrameTime {(Now() - FrameStart) * 1000.0 / TimeFreq};
+
+      Stats.FrameTimeAvg = Stats.Frames == 0 ? FrameTime : Stats.FrameTimeAvg + (FrameTime - Stats.FrameTimeAvg) * 0.05;
+      Stats.FrameTimeMax = std::max(Stats.FrameTimeMax, FrameTime);
+      Stats.Frames++;
+    } /* End of 'FrameEnd' function */
+
+    /* Main loop waiting timeout evaluation function.
+     * ARGUMENTS:
+     *   - Interactive input is processed (input is polled with frame rate) flag:
+     *       bool IsInteractive;
+     *   - Frame waiting for render flag:
+     *       bool IsRedrawPending;
+     * RETURNS:
+     *   (DWORD) Timeout in milliseconds (INFINITE if nothing to do).
+     */
+    DWORD GetTimeout( bool IsInteractive, bool IsRedrawPending )
+    {
+      if (!IsInteractive && !IsRedrawPending)
+      {
+        Stats.IdleWaits++;
+        return INFINITE;
+      }
+
+      const UINT64
+        Period {GetPeriod(IsInteractive)},
+        Passed {Now() - LastFrame};
+
+      if (Passed >= Period)
+        return 1;
+
+      return std::max<DWORD>(1, (DWORD)(((Period - Passed) * 1000 + TimeFreq - 1) / TimeFreq));
+    } /* End of 'GetTimeout' function */
+
+    /* Target frame rates setting function.
+     * ARGUMENTS:
+     *   - Interactive input and background work frame rates:
+     *       dbl NewInteractiveFps, NewWorkFps;
+     */
+    void SetFrameRates( dbl NewInteractiveFps, dbl NewWorkFps )
+    {
+      InteractiveFps = std::clamp(NewInteractiveFps, 1.0, 1000.0);
+      WorkFps = std::clamp(NewWorkFps, 1.0, InteractiveFps);
+    } /* End of 'SetFrameRates' function */
+
+    /* Target frame rates getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (std::pair<dbl, dbl>) Interactive input and background work frame rates.
+     */
+    std::pair<dbl, dbl> GetFrameRates( void ) const
+    {
+      return {InteractiveFps, WorkFps};
+    } /* End of 'GetFrameRates' function */
+
+    /* Statistics getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (stats) Statistics.
+     */
+    stats GetStats( void ) const
+    {
+      stats Res {Stats};
+
+      Res.Notifications = Notifications.load(std::memory_order_relaxed);
+      return Res;
+    } /* End of 'GetStats' function */
+  }; /* end of 'frame_scheduler' class */
+} /* end of 'prj' namespace */
+
+#endif /* __frame_scheduler_h__ */
+
+/* END OF 'frame_scheduler.h' FILE */
@@ -0,0 +1,220 @@
+/* FILE NAME   : 'scene_history.h'
+ * PURPOSE     : Animation module.
+ *               Scene edits undo/redo history handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj'.
+ */
+
+#ifndef __scene_history_h__
+#define __scene_history_h__
+
+#include <def.h>
+
+#include "utility/physics/ef_boundary.h"
+
+/* Project namespace */
+namespace prj
+{
+  /* Memory block hash (FNV-1a) accumulating function.
+   * ARGUMENTS:
+   *   - Memory block:
+   *       const VOID *Data;
+   *   - Memory block size:
+   *       size_t Size;
+   *   - Previous hash value (default: FNV offset basis):
+   *       UINT64 Hash;
+   * RETURNS:
+   *   (UINT64) New hash value.
+   */
+  inline UINT64 HashBytes( const VOID *Data, size_t Size, UINT64 Hash = 14695981039346656037ull )
+  {
+    for (size_t i = 0; i < Size; i++)
+      Hash = (Hash ^ ((const BYTE *)Data)[i]) * 1099511628211ull;
+
+    return Hash;
+  } /* End of 'HashBytes' function */
+
+  /* Scene edits history class */
+  class scene_history
+  {
+  public:
+    /* Single charge stored state (without traced lines) */
+    struct charge_state
+    {
+      coordd Coord;
+      dbl Charge, Size;
+      phys::source_shape Shape {};
+
+      /* Charge state hash evaluation function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (UINT64) Hash value.
+       */
+      UINT64 Hash( void ) const
+      {
+        UINT64 Res {HashBytes(&Coord, sizeof(Coord))};
+
+        Res = HashBytes(&Charge, sizeof(Charge), Res);
+        Res = HashBytes(&Size, sizeof(Size), Res);
+
+        /* Shape fields are hashed separately (structure has padding), point charges keep old hashes */
+        if (Shape.Type != phys::source_type::Point)
+        {
+          Res = HashBytes(&Shape.Type, sizeof(Shape.Type), Res);
+          Res = HashBytes(&Shape.Extent, sizeof(Shape.Extent), Res);
+          Res = HashBytes(&Shape.Angle, sizeof(Shape.Angle), Res);
+          Res = HashBytes(&Shape.Sweep, sizeof(Shape.Sweep), Res);
+        }
+        return Res;
+      } /* End of 'Hash' function */
+    }; /* end of 'charge_state' structure */
+
+    /* Whole scene stored state.
+     * Unchanged charges are shared between neighbour states.
+     */
+    struct scene_state
+    {
+      std::vector<std::shared_ptr<const charge_state>> Charges;
+      phys::boundary Boundary;
+      UINT64 Hash;
+    }; /* end of 'scene_state' structure */
+
+  private:
+    /* States sequence and current state index */
+    std::vector<std::shared_ptr<const scene_state>> States {};
+    size_t Current {0};
+
+    /* Maximal stored states count */
+    size_t MaxDepth;
+
+  public:
+    /* Default constructor (starts from empty scene).
+     * ARGUMENTS:
+     *   - Maximal stored states count (default: 256):
+     *       size_t MaxDepth;
+     */
+    scene_history( size_t MaxDepth = 256 ) : MaxDepth {std::max<size_t>(MaxDepth, 2)}
+    {
+      States.push_back(std::make_shared<const scene_state>(scene_state {{}, {}, HashBytes(nullptr, 0)}));
+    } /* End of constructor */
+
+    /* Scene state hash evaluation function.
+     * ARGUMENTS:
+     *   - Charges pool:
+     *       const phys::charge_pool &Charges;
+     *   - Grounded conductor boundary (default: none):
+     *       const phys::boundary &Boundary;
+     * RETURNS:
+     *   (UINT64) Hash value.
+     */
+    static UINT64 Hash( const phys::charge_pool &Charges, const phys::boundary &Boundary = {} )
+    {
+      UINT64 Res {HashBytes(nullptr, 0)};
+
+      for (const auto &Elm : Charges)
+      {
+        const UINT64 ElmHash {charge_state {Elm.Coord, Elm.Charge, Elm.Size, Elm.Shape}.Hash()};
+
+        Res = HashBytes(&ElmHash, sizeof(ElmHash), Res);
+      }
+
+      /* Boundary fields are hashed separately (structure has padding) */
+      if (Boundary.IsValid())
+      {
+        Res = HashBytes(&Boundary.Type, sizeof(Boundary.Type), Res);
+        Res = HashBytes(&Boundary.Point, sizeof(Boundary.Point), Res);
+        Res = HashBytes(&Boundary.Normal, sizeof(Boundary.Normal), Res);
+        Res = HashBytes(&Boundary.Radius, sizeof(Boundary.Radius), Res);
+      }
+
+      return Res;
+    } /* End of 'Hash' function */
+
+    /* New state committing function (drops all redo states).
+     * ARGUMENTS:
+     *   - Charges pool:
+     *       const phys::charge_pool &Charges;
+     *   - Grounded conductor boundary (default: none):
+     *       const phys::boundary &Boundary;
+     * RETURNS:
+     *   (bool) true if state differs from current and was stored.
+     */
+    bool Commit( const phys::charge_pool &Charges, const phys::boundary &Boundary = {} )
+    {
+      const auto &Prev {*States[Current]};
+      const UINT64 NewHash {Hash(Charges, Boundary)};
+
+      if (NewHash == Prev.Hash)
+        return false;
+
+      /* Share unchanged charges with previous state */
+      std::unordered_map<UINT64, std::shared_ptr<const charge_state>> PrevCharges {};
+
+      for (const auto &Elm : Prev.Charges)
+        PrevCharges.emplace(Elm->Hash(), Elm);
+
+      scene_state State {{}, Boundary, NewHash};
+
+      State.Charges.reserve(Charges.Size());
+      for (const auto &Elm : Charges)
+      {
+        charge_state Tmp {Elm.Coord, Elm.Charge, Elm.Size, Elm.Shape};
+
+        if (auto It {PrevCharges.find(Tmp.Hash())}; It != PrevCharges.end())
+          State.Charges.push_back(It->second);
+        else
+          State.Charges.push_back(std::make_shared<const charge_state>(Tmp));
+      }
+
+      States.resize(Current + 1);
+      States.push_back(std::make_shared<const scene_state>(std::move(State)));
+
+      if (States.size() > MaxDepth)
+        States.erase(States.begin());
+
+      Current = States.size() - 1;
+      return true;
+    } /* End of 'Commit' function */
+
+    /* Previous state getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const scene_state *) State to restore or nullptr if there is no one.
+     */
+    const scene_state *Undo( void )
+    {
+      if (Current == 0)
+        return nullptr;
+
+      return States[--Current].get();
+    } /* End of 'Undo' function */
+
+    /* Next state getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const scene_state *) State to restore or nullptr if there is no one.
+     */
+    const scene_state *Redo( void )
+    {
+      if (Current + 1 >= States.size())
+        return nullptr;
+
+      return States[++Current].get();
+    } /* End of 'Redo' function */
+
+    /* Stored states count getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (std::pair<size_t, size_t>) Undo and redo avalible steps count.
+     */
+    std::pair<size_t, size_t> GetDepth( void ) const
+    {
+      return {Current, States.size() - Current - 1};
+    } /* End of 'GetDepth' function */
+  }; /* end of 'scene_history' class */
+} /* end of 'prj' namespace */
+
+#endif /* __scene_history_h__ */
+
+/* END OF 'scene_history.h' FILE */
@@ -1,7 +1,7 @@
 /* FILE NAME   : 'def.h'
  * PURPOSE     : Global definitions and includes header file.
  * PROGRAMMER  : Fedor Borodulin.
- * LAST UPDATE : 10.04.2023.
+ * LAST UPDATE : 19.10.2026.
  */
 
 #ifndef __def_h__
@@ -20,6 +20,7 @@ using Microsoft::WRL::ComPtr;
 
 /* I/O headers */
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 #include <fstream>
 
@@ -37,15 +38,20 @@ using Microsoft::WRL::ComPtr;
 /* Data structures headers */
 #include <vector>
 #include <list>
+#include <memory>
 #include <deque>
 #include <map>
+#include <unordered_map>
 #include <string>
+#include <span>
 
 /* Auxilary functional headers */
 #include <algorithm>
+#include <numeric>
 #include <functional>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <filesystem>
 
 /* Undefine annoying standard macro-functions */
@@ -1,11 +1,13 @@
 /* FILE NAME   : 'main.cpp'
  * PURPOSE     : Entry point file.
  * PROGRAMMER  : Fedor Borodulin.
- * LAST UPDATE : 27.04.2023.
+ * LAST UPDATE : 19.10.2026.
  */
 
 #include <pch.h>
 
+#include "utility/cpu_isa/cpu_isa.h"
+
 /* The main program function.
  * ARGUMENTS:
  *   - handle of application instance:
@@ -37,6 +39,15 @@ INT WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInstance,
   system("cls");
 #endif /* !_DEBUG */
 
+  /* Vector kernels instruction set override ('-isa=sse42|avx2|avx512', for testing lower level kernels) */
+  if (const CHAR *Isa {strstr(CmdLine, "-isa=")}; Isa != nullptr)
+  {
+    CHAR Name[16] {};
+
+    sscanf(Isa + 5, "%15s", Name);
+    prj::util::SetIsa(Name);
+  }
+
   /* Animation (auto run) */
   prj::anim Anim {};
 
@@ -1,7 +1,7 @@
 /* FILE NAME   : 'render.cpp'
  * PURPOSE     : Render module implementation file.
  * PROGRAMMER  : Fedor Borodulin.
- * LAST UPDATE : 07.04.2023.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : Module namespace 'prj'.
  */
 
@@ -55,23 +55,53 @@ namespace prj
     };
   
     Factory->CreateHwndRenderTarget(&Info, &Info2, RenderTarget.ReleaseAndGetAddressOf());
+
+    /* Bitmaps belong to render target */
+    Background.Reset();
   
     /* Create brushes */
     RenderTarget->CreateSolidColorBrush(D2D1_COLOR_F {1.f, 1.f, 0.f, 1.f}, ColorBrushLines.ReleaseAndGetAddressOf());
     RenderTarget->CreateSolidColorBrush(D2D1_COLOR_F {0.f, 1.f, 0.f, 1.f}, ColorBrushLineDirs.ReleaseAndGetAddressOf());
+    RenderTarget->CreateSolidColorBrush(D2D1_COLOR_F {.55f, .6f, .75f, 1.f}, ColorBrushContours.ReleaseAndGetAddressOf());
     RenderTarget->CreateSolidColorBrush(D2D1_COLOR_F {1.f, 0.f, 0.f, 1.f}, ColorBrushPosCharge.ReleaseAndGetAddressOf());
     RenderTarget->CreateSolidColorBrush(D2D1_COLOR_F {0.f, 0.f, 1.f, 1.f}, ColorBrushNegCharge.ReleaseAndGetAddressOf());
+    RenderTarget->CreateSolidColorBrush(D2D1_COLOR_F {.45f, .45f, .5f, .6f}, ColorBrushConductor.ReleaseAndGetAddressOf());
   } /* End of 'render::Resize' function */
   
   /* Lines data update function.
    * ARGUMENTS:
    *   - Lines data:
    *       const std::vector<std::pair<const coordf *, size_t>> &Lines;
+   *   - Equipotential lines (polylines) data:
+   *       const std::vector<std::pair<const coordf *, size_t>> &Contours;
    *   - Directions drawing flag (default: false):
    *       bool DrawDirs;
    */
-  void render::UpdateData( const std::vector<std::pair<const coordf *, size_t>> &Lines, bool DrawDirs )
+  void render::UpdateData( const std::vector<std::pair<const coordf *, size_t>> &Lines,
+                           const std::vector<std::pair<const coordf *, size_t>> &Contours, bool DrawDirs )
   {
+    /* Equipotential lines are marching squares polylines, not bezier control points */
+    ContoursGeom.Reset();
+    if (!Contours.empty())
+    {
+      ComPtr<ID2D1GeometrySink> ContoursSink {};
+
+      Factory->CreatePathGeometry(ContoursGeom.GetAddressOf());
+      ContoursGeom->Open(ContoursSink.GetAddressOf());
+
+      for (auto &Elm : Contours)
+      {
+        if (Elm.first == nullptr || Elm.second < 2)
+          continue;
+
+        ContoursSink->BeginFigure(*(D2D1_POINT_2F *)Elm.first, D2D1_FIGURE_BEGIN_HOLLOW);
+        ContoursSink->AddLines((D2D1_POINT_2F *)(Elm.first + 1), (UINT32)(Elm.second - 1));
+        ContoursSink->EndFigure(D2D1_FIGURE_END_OPEN);
+      }
+
+      ContoursSink->Close();
+    }
+
     Factory->CreatePathGeometry(LinesGeom.ReleaseAndGetAddressOf());
   
     LineDirsGeom.Reset();
@@ -104,7 +134,7 @@ namespace prj
           for (size_t i {(DirFreq >> 1) + 1}; i < (Elm.second - 2); i += DirFreq)
           {
             __m128 Points {_mm_load_ps((flt *)(Elm.first + i - 1))};
-            auto Dir = _mm_permute_ps(Points, 0b11'01'10'00);
+            auto Dir = _mm_shuffle_ps(Points, Points, 0b11'01'10'00);
             Dir = _mm_hsub_ps(Dir, Dir);
   
             auto DirLen = _mm_mul_ps(Dir, Dir);
@@ -114,12 +144,12 @@ namespace prj
             Dir = _mm_mul_ps(Dir, DirLen);
             Dir = _mm_mul_ps(Dir, _mm_setr_ps(.6f, .6f, .2f, .2f));
   
-            auto Point0 {_mm_permute_ps(Points, 0b01'00'01'00)};
-            Point0 = _mm_add_ps(Point0, _mm_permute_ps(Dir, 0b01'00'01'00));
+            auto Point0 {_mm_shuffle_ps(Points, Points, 0b01'00'01'00)};
+            Point0 = _mm_add_ps(Point0, _mm_shuffle_ps(Dir, Dir, 0b01'00'01'00));
   
-            Point0 = _mm_addsub_ps(_mm_permute_ps(Point0, 0b10'11'01'00),
-                                   _mm_permute_ps(Dir, 0b11'10'10'11));
-            Point0 = _mm_permute_ps(Point0, 0b10'11'01'00);
+            Point0 = _mm_addsub_ps(_mm_shuffle_ps(Point0, Point0, 0b10'11'01'00),
+                                   _mm_shuffle_ps(Dir, Dir, 0b11'10'10'11));
+            Point0 = _mm_shuffle_ps(Point0, Point0, 0b10'11'01'00);
   
             coordf Coords[2];
             _mm_store_ps((flt *)Coords, Point0);
@@ -139,16 +169,52 @@ namespace prj
     }
   } /* End of 'render::UpdateData' function */
   
+  /* Background bitmap update function.
+   * ARGUMENTS:
+   *   - Pixels (BGRA, window size, nullptr <=> plain background):
+   *       const DWORD *Pixels;
+   *   - Pixels size:
+   *       INT W, H;
+   */
+  void render::SetBackground( const DWORD *Pixels, INT W, INT H )
+  {
+    if (Pixels == nullptr || RenderTarget == nullptr || W <= 0 || H <= 0)
+    {
+      Background.Reset();
+      return;
+    }
+
+    if (Background == nullptr || BackgroundW != W || BackgroundH != H)
+    {
+      const D2D1_BITMAP_PROPERTIES Props {{DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_IGNORE}, 96.f, 96.f};
+
+      RenderTarget->CreateBitmap(D2D1_SIZE_U {(UINT32)W, (UINT32)H}, Pixels, (UINT32)W * 4, Props,
+                                 Background.ReleaseAndGetAddressOf());
+      BackgroundW = W, BackgroundH = H;
+    }
+    else
+      Background->CopyFromMemory(nullptr, Pixels, (UINT32)W * 4);
+  } /* End of 'render::SetBackground' function */
+
   /* Render function
    * ARGUMENTS:
    *   - Charges positions and sizes:
    *       const std::pair<std::pair<coordf, std::pair<flt, flt>> *, size_t> &Charges;
    *   - Logical screen coordinates:
    *       const std::pair<flt, flt> &LeftTop, &RightBottom;
+   *   - Field lines copies shifts (periodic lattice cells, default: empty - lines are drawn once):
+   *       std::span<const coordf> LineShifts;
+   *   - Grounded conductor outline polygon (default: empty - no conductor):
+   *       std::span<const coordf> Conductor;
+   *   - Extended charge sources outline polygons with charges (default: empty - no sources):
+   *       std::span<const std::pair<std::vector<coordf>, flt>> Sources;
    */
   void render::Render( const std::pair<std::pair<coordf, std::pair<flt, flt>> *, size_t> &Charges,
                        const std::pair<flt, flt> &LeftTop,
-                       const std::pair<flt, flt> &RightBottom )
+                       const std::pair<flt, flt> &RightBottom,
+                       std::span<const coordf> LineShifts,
+                       std::span<const coordf> Conductor,
+                       std::span<const std::pair<std::vector<coordf>, flt>> Sources )
   {
     if (RenderTarget == nullptr)
       return;
@@ -179,14 +245,77 @@ namespace prj
   
     RenderTarget->SetTransform(GeomTransform);
     RenderTarget->Clear(D2D1::ColorF(D2D1::ColorF::White));
+
+    /* Draw background over whole target */
+    if (Background)
+    {
+      const auto [W, H] {RenderTarget->GetSize()};
+
+      RenderTarget->SetTransform(D2D1::IdentityMatrix());
+      /* Lower resolution backgrounds are smoothly stretched */
+      RenderTarget->DrawBitmap(Background.Get(), D2D1_RECT_F {0, 0, W, H}, 1.f,
+                               BackgroundW == Width && BackgroundH == Height ?
+                                 D2D1_BITMAP_INTERPOLATION_MODE_NEAREST_NEIGHBOR : D2D1_BITMAP_INTERPOLATION_MODE_LINEAR);
+      RenderTarget->SetTransform(GeomTransform);
+    }
   
-    /* Draw lines */
-    if (LinesGeom)
-      RenderTarget->DrawGeometry(LinesGeom.Get(), ColorBrushLines.Get(), .13f);
-  
-    if (LineDirsGeom)
-      RenderTarget->FillGeometry(LineDirsGeom.Get(), ColorBrushLineDirs.Get());
+    /* Draw equipotential lines under field lines */
+    if (ContoursGeom)
+      RenderTarget->DrawGeometry(ContoursGeom.Get(), ColorBrushContours.Get(), .08f);
+
+    /* Draw grounded conductor (lines end on its outline) */
+    if (Conductor.size() > 2)
+    {
+      ComPtr<ID2D1PathGeometry> ConductorGeom {};
+      ComPtr<ID2D1GeometrySink> ConductorSink {};
+
+      Factory->CreatePathGeometry(ConductorGeom.GetAddressOf());
+      ConductorGeom->Open(ConductorSink.GetAddressOf());
+      ConductorSink->BeginFigure(*(D2D1_POINT_2F *)Conductor.data(), D2D1_FIGURE_BEGIN_FILLED);
+      ConductorSink->AddLines((D2D1_POINT_2F *)(Conductor.data() + 1), (UINT32)(Conductor.size() - 1));
+      ConductorSink->EndFigure(D2D1_FIGURE_END_CLOSED);
+      ConductorSink->Close();
+
+      RenderTarget->FillGeometry(ConductorGeom.Get(), ColorBrushConductor.Get());
+      RenderTarget->DrawGeometry(ConductorGeom.Get(), ColorBrushConductor.Get(), .1f);
+    }
+
+    /* Draw lines (same geometry is drawn in every lattice cell under shifted transform) */
+    const coordf NoShift {0, 0};
+
+    for (const auto &Shift : LineShifts.empty() ? std::span<const coordf> {&NoShift, 1} : LineShifts)
+    {
+      auto ShiftTransform {GeomTransform};
+
+      ShiftTransform.dx += Shift.X * GeomTransform.m11;
+      ShiftTransform.dy += Shift.Y * GeomTransform.m22;
+      RenderTarget->SetTransform(ShiftTransform);
+
+      if (LinesGeom)
+        RenderTarget->DrawGeometry(LinesGeom.Get(), ColorBrushLines.Get(), .13f);
+
+      if (LineDirsGeom)
+        RenderTarget->FillGeometry(LineDirsGeom.Get(), ColorBrushLineDirs.Get());
+    }
   
+    /* Draw extended sources (their labels are drawn with charges) */
+    RenderTarget->SetTransform(GeomTransform);
+    for (const auto &[Outline, Charge] : Sources)
+      if (Outline.size() > 2)
+      {
+        ComPtr<ID2D1PathGeometry> SourceGeom {};
+        ComPtr<ID2D1GeometrySink> SourceSink {};
+
+        Factory->CreatePathGeometry(SourceGeom.GetAddressOf());
+        SourceGeom->Open(SourceSink.GetAddressOf());
+        SourceSink->BeginFigure(*(D2D1_POINT_2F *)Outline.data(), D2D1_FIGURE_BEGIN_FILLED);
+        SourceSink->AddLines((D2D1_POINT_2F *)(Outline.data() + 1), (UINT32)(Outline.size() - 1));
+        SourceSink->EndFigure(D2D1_FIGURE_END_CLOSED);
+        SourceSink->Close();
+
+        RenderTarget->FillGeometry(SourceGeom.Get(), (Charge > 0 ? ColorBrushPosCharge : ColorBrushNegCharge).Get());
+      }
+
     /* Draw charges */
     {
       for (size_t i = 0; i < Charges.second; i++)
@@ -1,7 +1,7 @@
 /* FILE NAME   : 'render.h'
  * PURPOSE     : Render module header file.
  * PROGRAMMER  : Fedor Borodulin.
- * LAST UPDATE : 10.04.2023.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : Module namespace 'prj'.
  */
 
@@ -36,16 +36,22 @@ namespace prj
     /* Color brushes */
     ComPtr<ID2D1SolidColorBrush>
       ColorBrushLines {},
+      ColorBrushContours {},
       ColorBrushLineDirs {},
       ColorBrushPosCharge {},
-      ColorBrushNegCharge {};
+      ColorBrushNegCharge {},
+      ColorBrushConductor {};
 
     /* Text font */
     ComPtr<IDWriteTextFormat> TextFmt {};
     flt FontSize = 102.f / GetDpiForSystem();
 
     /* Lines geometry store */
-    ComPtr<ID2D1PathGeometry> LinesGeom {}, LineDirsGeom {};
+    ComPtr<ID2D1PathGeometry> LinesGeom {}, LineDirsGeom {}, ContoursGeom {};
+
+    /* Background (heatmap) bitmap and its size */
+    ComPtr<ID2D1Bitmap> Background {};
+    INT BackgroundW {0}, BackgroundH {0};
 
     /* Screen size */
     INT Width {1}, Height {1};
@@ -84,10 +90,22 @@ namespace prj
      * ARGUMENTS:
      *   - Lines data:
      *       const std::vector<std::pair<const coordf *, size_t>> &Lines;
+     *   - Equipotential lines (polylines) data:
+     *       const std::vector<std::pair<const coordf *, size_t>> &Contours;
      *   - Directions drawing flag (default: false):
      *       bool DrawDirs;
      */
-    void UpdateData( const std::vector<std::pair<const coordf *, size_t>> &Lines, bool DrawDirs = false );
+    void UpdateData( const std::vector<std::pair<const coordf *, size_t>> &Lines,
+                     const std::vector<std::pair<const coordf *, size_t>> &Contours, bool DrawDirs = false );
+
+    /* Background bitmap update function.
+     * ARGUMENTS:
+     *   - Pixels (BGRA, window size, nullptr <=> plain background):
+     *       const DWORD *Pixels;
+     *   - Pixels size:
+     *       INT W, H;
+     */
+    void SetBackground( const DWORD *Pixels, INT W, INT H );
 
     /* Render function
      * ARGUMENTS:
@@ -95,10 +113,19 @@ namespace prj
      *       const std::pair<std::pair<coordf, std::pair<flt, flt>> *, size_t> &Charges;
      *   - Logical screen coordinates:
      *       const std::pair<flt, flt> &LeftTop, &RightBottom;
+     *   - Field lines copies shifts (periodic lattice cells, default: empty - lines are drawn once):
+     *       std::span<const coordf> LineShifts;
+     *   - Grounded conductor outline polygon (default: empty - no conductor):
+     *       std::span<const coordf> Conductor;
+     *   - Extended charge sources outline polygons with charges (default: empty - no sources):
+     *       std::span<const std::pair<std::vector<coordf>, flt>> Sources;
      */
     void Render( const std::pair<std::pair<coordf, std::pair<flt, flt>> *, size_t> &Charges,
                  const std::pair<flt, flt> &LeftTop,
-                 const std::pair<flt, flt> &RightBottom );
+                 const std::pair<flt, flt> &RightBottom,
+                 std::span<const coordf> LineShifts = {},
+                 std::span<const coordf> Conductor = {},
+                 std::span<const std::pair<std::vector<coordf>, flt>> Sources = {} );
   };
 }
 
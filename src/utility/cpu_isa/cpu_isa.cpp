@@ -0,0 +1,122 @@
+/* FILE NAME   : 'cpu_isa.cpp'
+ * PURPOSE     : Processor vector instruction sets detection implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::util'.
+ */
+
+#include <pch.h>
+
+#include "cpu_isa.h"
+
+using namespace prj::util;
+
+/* Instruction set levels names (in 'isa' order) */
+static const CHAR *const IsaNames[] {"sse42", "avx2", "avx512"};
+
+/* Override level and its presence flag */
+static isa IsaOverride {isa::Avx512};
+static bool IsOverridden {false};
+
+/* Processor and operating system supported instruction set level detection function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (isa) Highest supported level.
+ */
+isa prj::util::DetectIsa( void )
+{
+  INT Regs[4];
+
+  __cpuid(Regs, 0);
+  if (Regs[0] < 7)
+    return isa::Sse42;
+
+  /* Leaf 1 ECX: FMA3 (bit 12), OS saves extended state (bit 27), AVX (bit 28) */
+  __cpuid(Regs, 1);
+
+  const bool
+    IsFma {(Regs[2] & 1 << 12) != 0},
+    IsOsSave {(Regs[2] & 1 << 27) != 0},
+    IsAvx {(Regs[2] & 1 << 28) != 0};
+
+  if (!IsFma || !IsOsSave || !IsAvx)
+    return isa::Sse42;
+
+  /* Operating system must save YMM (XCR0 bits 1, 2) and ZMM (XCR0 bits 5..7) registers */
+  const UINT64 Xcr0 {_xgetbv(0)};
+
+  if ((Xcr0 & 0x6) != 0x6)
+    return isa::Sse42;
+
+  /* Leaf 7 EBX: AVX2 (bit 5), AVX-512 foundation (bit 16) */
+  __cpuidex(Regs, 7, 0);
+  if ((Regs[1] & 1 << 5) == 0)
+    return isa::Sse42;
+  if ((Regs[1] & 1 << 16) == 0 || (Xcr0 & 0xE6) != 0xE6)
+    return isa::Avx2;
+  return isa::Avx512;
+} /* End of 'prj::util::DetectIsa' function */
+
+/* Active instruction set level (detected one, limited by override) getting function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (isa) Level for kernels selection.
+ */
+isa prj::util::GetIsa( void )
+{
+  static const isa Detected {DetectIsa()};
+
+  return IsOverridden ? std::min(IsaOverride, Detected) : Detected;
+} /* End of 'prj::util::GetIsa' function */
+
+/* Instruction set level override function (must be called before kernels are used, level is limited by detected one).
+ * ARGUMENTS:
+ *   - Level name ("sse42", "avx2" or "avx512"):
+ *       const CHAR *Name;
+ * RETURNS:
+ *   (bool) true if name is known.
+ */
+bool prj::util::SetIsa( const CHAR *Name )
+{
+  for (UINT i = 0; i < std::size(IsaNames); i++)
+    if (_stricmp(Name, IsaNames[i]) == 0)
+    {
+      IsaOverride = (isa)i;
+      IsOverridden = true;
+      return true;
+    }
+  return false;
+} /* End of 'prj::util::SetIsa' function */
+
+/* Instruction set level name getting function.
+ * ARGUMENTS:
+ *   - Level:
+ *       isa Level;
+ * RETURNS:
+ *   (const CHAR *) Name.
+ */
+const CHAR *prj::util::IsaName( isa Level )
+{
+  return IsaNames[(UINT)Level];
+} /* End of 'prj::util::IsaName' function */
+
+/* Detected and active instruction set levels report function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (std::string) Report.
+ */
+std::string prj::util::IsaReport( void )
+{
+  std::string Res {"Vector instruction set: detected "};
+
+  Res += IsaName(DetectIsa());
+  Res += ", active ";
+  Res += IsaName(GetIsa());
+  if (IsOverridden)
+    Res += " (command line override '-isa=" + std::string {IsaName(IsaOverride)} + "')";
+  Res += "\n";
+
+  return Res;
+} /* End of 'prj::util::IsaReport' function */
+
+/* END OF 'cpu_isa.cpp' FILE */
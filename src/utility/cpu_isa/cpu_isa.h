@@ -0,0 +1,66 @@
+/* FILE NAME   : 'cpu_isa.h'
+ * PURPOSE     : Processor vector instruction sets detection handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::util'.
+ */
+
+#ifndef __cpu_isa_h__
+#define __cpu_isa_h__
+
+#include <def.h>
+
+/* Project namespace // Utility module */
+namespace prj::util
+{
+  /* Vector instruction set levels (every level includes previous ones) */
+  enum class isa : UINT
+  {
+    Sse42,  /* SSE up to 4.2 (baseline) */
+    Avx2,   /* AVX2 with FMA3 */
+    Avx512, /* AVX-512 foundation */
+  }; /* end of 'isa' enum */
+
+  /* Processor and operating system supported instruction set level detection function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (isa) Highest supported level.
+   */
+  isa DetectIsa( void );
+
+  /* Active instruction set level (detected one, limited by override) getting function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (isa) Level for kernels selection.
+   */
+  isa GetIsa( void );
+
+  /* Instruction set level override function (must be called before kernels are used, level is limited by detected one).
+   * ARGUMENTS:
+   *   - Level name ("sse42", "avx2" or "avx512"):
+   *       const CHAR *Name;
+   * RETURNS:
+   *   (bool) true if name is known.
+   */
+  bool SetIsa( const CHAR *Name );
+
+  /* Instruction set level name getting function.
+   * ARGUMENTS:
+   *   - Level:
+   *       isa Level;
+   * RETURNS:
+   *   (const CHAR *) Name.
+   */
+  const CHAR *IsaName( isa Level );
+
+  /* Detected and active instruction set levels report function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (std::string) Report.
+   */
+  std::string IsaReport( void );
+} /* end of 'prj::util' namespace */
+
+#endif /* __cpu_isa_h__ */
+
+/* END OF 'cpu_isa.h' FILE */
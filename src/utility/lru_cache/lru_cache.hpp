@@ -0,0 +1,177 @@
+/* FILE NAME   : 'lru_cache.hpp'
+ * PURPOSE     : Memory bounded least recently used cache class implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::util'.
+ */
+
+#ifndef __lru_cache_hpp__
+#define __lru_cache_hpp__
+
+#include <def.h>
+
+/* Project namespace // Utility module */
+namespace prj::util
+{
+  /* Cache usage statistics structure */
+  struct lru_cache_stats
+  {
+    size_t
+      Hits {0},      /* Successful lookups count */
+      Misses {0},    /* Failed lookups count */
+      Evictions {0}, /* Entries dropped because of memory limit */
+      Entries {0},   /* Currently stored entries count */
+      Bytes {0};     /* Currently held memory (in bytes) */
+
+    /* Hit rate getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (dbl) Hits part of all lookups in [0; 1] range.
+     */
+    dbl HitRate( void ) const
+    {
+      return Hits + Misses == 0 ? 0.0 : (dbl)Hits / (dbl)(Hits + Misses);
+    } /* End of 'HitRate' function */
+  }; /* end of 'lru_cache_stats' structure */
+
+  /* Least recently used cache bounded by held memory size */
+  template<typename key, typename value>
+    class lru_cache
+    {
+    private:
+      /* Cache entry structure */
+      struct entry
+      {
+        key Key;
+        value Value;
+        size_t Bytes;
+      }; /* end of 'entry' structure */
+
+      /* Entries in usage order (most recently used first) */
+      std::list<entry> Entries {};
+
+      /* Key to entry fast lookup table */
+      std::unordered_map<key, typename std::list<entry>::iterator> Table {};
+
+      /* Memory limit (in bytes) */
+      size_t MaxBytes;
+
+      /* Usage statistics */
+      lru_cache_stats Stats {};
+
+      /* Entries evicting while memory limit is exceeded function */
+      void Shrink( void )
+      {
+        while (Stats.Bytes > MaxBytes && !Entries.empty())
+        {
+          auto &Last {Entries.back()};
+
+          Stats.Bytes -= Last.Bytes;
+          Stats.Evictions++;
+          Table.erase(Last.Key);
+          Entries.pop_back();
+        }
+
+        Stats.Entries = Entries.size();
+      } /* End of 'Shrink' function */
+
+    public:
+      /* Default constructor
+       * ARGUMENTS:
+       *   - Memory limit (in bytes):
+       *       size_t MaxBytes;
+       */
+      lru_cache( size_t MaxBytes ) : MaxBytes {MaxBytes}
+      { }
+
+      /* Value lookup function (marks found entry as most recently used).
+       * ARGUMENTS:
+       *   - Key:
+       *       const key &Key;
+       * RETURNS:
+       *   (const value *) Found value or nullptr.
+       */
+      const value *Find( const key &Key )
+      {
+        auto It {Table.find(Key)};
+
+        if (It == Table.end())
+        {
+          Stats.Misses++;
+          return nullptr;
+        }
+
+        Stats.Hits++;
+        Entries.splice(Entries.begin(), Entries, It->second);
+
+        return &It->second->Value;
+      } /* End of 'Find' function */
+
+      /* Value inserting function (replaces value with same key).
+       * ARGUMENTS:
+       *   - Key:
+       *       const key &Key;
+       *   - Value:
+       *       value &&Value;
+       *   - Value held memory (in bytes):
+       *       size_t Bytes;
+       */
+      void Put( const key &Key, value &&Value, size_t Bytes )
+      {
+        auto It {Table.find(Key)};
+
+        if (It != Table.end())
+        {
+          Stats.Bytes -= It->second->Bytes;
+          Entries.erase(It->second);
+          Table.erase(It);
+        }
+
+        /* Too big values are not stored at all */
+        if (Bytes > MaxBytes)
+        {
+          Stats.Entries = Entries.size();
+          return;
+        }
+
+        Entries.push_front({Key, std::move(Value), Bytes});
+        Table[Key] = Entries.begin();
+        Stats.Bytes += Bytes;
+
+        Shrink();
+      } /* End of 'Put' function */
+
+      /* Memory limit setting function.
+       * ARGUMENTS:
+       *   - New memory limit (in bytes):
+       *       size_t NewMaxBytes;
+       */
+      void SetMaxBytes( size_t NewMaxBytes )
+      {
+        MaxBytes = NewMaxBytes;
+        Shrink();
+      } /* End of 'SetMaxBytes' function */
+
+      /* All entries removing function */
+      void Clear( void )
+      {
+        Entries.clear();
+        Table.clear();
+        Stats.Bytes = Stats.Entries = 0;
+      } /* End of 'Clear' function */
+
+      /* Usage statistics getting function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (const lru_cache_stats &) Statistics.
+       */
+      const lru_cache_stats &GetStats( void ) const
+      {
+        return Stats;
+      } /* End of 'GetStats' function */
+    }; /* end of 'lru_cache' class */
+} /* end of 'prj::util' namespace */
+
+#endif /* __lru_cache_hpp__ */
+
+/* END OF 'lru_cache.hpp' FILE */
@@ -0,0 +1,191 @@
+/* FILE NAME   : 'ef_boundary.h'
+ * PURPOSE     : Physics module.
+ *               Grounded conductor boundaries (method of images) handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#ifndef __ef_boundary_h__
+#define __ef_boundary_h__
+
+#include "ef_charges.h"
+
+/* Project namespace // Physics module */
+namespace prj::phys
+{
+  /* Grounded conductor boundary types enum */
+  enum class boundary_type : UINT
+  {
+    None,   /* No boundary */
+    Line,   /* Grounded plane perpendicular to scene plane (conductor is half plane behind normal) */
+    Circle, /* Grounded sphere centered in scene plane (conductor is disk inside) */
+  }; /* end of 'boundary_type' enum */
+
+  /* Grounded conductor boundary.
+   * Charges field is point charges (1 / r^2) field, so both boundaries have exact point images:
+   * charge q at distance d from plane gives -q mirrored over plane, charge q at distance d from sphere
+   * center gives -q * R / d at distance R^2 / d. Images are never stored - evaluators generate them from charges.
+   * Field inside conductor is zero, charges inside conductor are screened.
+   */
+  struct boundary
+  {
+    boundary_type Type {boundary_type::None};
+    coordd Point {0, 0};  /* Point on line or circle center */
+    coordd Normal {0, 1}; /* Line unit normal (directed to free half plane) */
+    dbl Radius {0};       /* Circle radius */
+
+    /* Grounded line boundary creation function.
+     * ARGUMENTS:
+     *   - Point on line:
+     *       const coordd &Point;
+     *   - Normal directed to free half plane (not normalized):
+     *       const coordd &Normal;
+     * RETURNS:
+     *   (boundary) Boundary (none for zero normal).
+     */
+    static boundary Line( const coordd &Point, const coordd &Normal )
+    {
+      const dbl Len {hypot(Normal.X, Normal.Y)};
+
+      if (!(Len > 0))
+        return {};
+      return {boundary_type::Line, Point, {Normal.X / Len, Normal.Y / Len}, 0};
+    } /* End of 'Line' function */
+
+    /* Grounded circle boundary creation function.
+     * ARGUMENTS:
+     *   - Circle center:
+     *       const coordd &Center;
+     *   - Circle radius:
+     *       dbl Radius;
+     * RETURNS:
+     *   (boundary) Boundary (none for not positive radius).
+     */
+    static boundary Circle( const coordd &Center, dbl Radius )
+    {
+      if (!(Radius > 0))
+        return {};
+      return {boundary_type::Circle, Center, {0, 1}, Radius};
+    } /* End of 'Circle' function */
+
+    /* Boundary presence check function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (bool) true if boundary is set.
+     */
+    bool IsValid( void ) const
+    {
+      return Type != boundary_type::None;
+    } /* End of 'IsValid' function */
+
+    /* Signed distance to boundary evaluation function.
+     * ARGUMENTS:
+     *   - Point:
+     *       const coordd &P;
+     * RETURNS:
+     *   (dbl) Distance (negative inside conductor, infinity without boundary).
+     */
+    dbl Distance( const coordd &P ) const
+    {
+      switch (Type)
+      {
+      case boundary_type::Line:
+        return (P.X - Point.X) * Normal.X + (P.Y - Point.Y) * Normal.Y;
+      case boundary_type::Circle:
+        return hypot(P.X - Point.X, P.Y - Point.Y) - Radius;
+      default:
+        return std::numeric_limits<dbl>::infinity();
+      }
+    } /* End of 'Distance' function */
+
+    /* Nearest boundary point evaluation function.
+     * ARGUMENTS:
+     *   - Point:
+     *       const coordd &P;
+     * RETURNS:
+     *   (coordd) Point on boundary (same point without boundary).
+     */
+    coordd Project( const coordd &P ) const
+    {
+      switch (Type)
+      {
+      case boundary_type::Line:
+        {
+          const dbl D {Distance(P)};
+
+          return {P.X - Normal.X * D, P.Y - Normal.Y * D};
+        }
+      case boundary_type::Circle:
+        {
+          const dbl DX {P.X - Point.X}, DY {P.Y - Point.Y}, Len {hypot(DX, DY)};
+
+          if (Len == 0)
+            return {Point.X + Radius, Point.Y};
+          return {Point.X + DX * Radius / Len, Point.Y + DY * Radius / Len};
+        }
+      default:
+        return P;
+      }
+    } /* End of 'Project' function */
+
+    /* Charge image evaluation function.
+     * ARGUMENTS:
+     *   - Charge position and value:
+     *       const coordd &C;
+     *       dbl Q;
+     *   - Image position and value (out):
+     *       coordd &IC;
+     *       dbl &IQ;
+     * RETURNS:
+     *   (bool) true if charge is in free region (otherwise it is screened and has no image).
+     */
+    bool Image( const coordd &C, dbl Q, coordd &IC, dbl &IQ ) const
+    {
+      switch (Type)
+      {
+      case boundary_type::Line:
+        {
+          const dbl D {Distance(C)};
+
+          IC = {C.X - Normal.X * 2 * D, C.Y - Normal.Y * 2 * D};
+          IQ = -Q;
+          return D > 0;
+        }
+      case boundary_type::Circle:
+        {
+          const dbl DX {C.X - Point.X}, DY {C.Y - Point.Y}, D2 {DX * DX + DY * DY};
+
+          if (!(D2 > Radius * Radius))
+            return false;
+
+          const dbl K {Radius * Radius / D2};
+
+          IC = {Point.X + DX * K, Point.Y + DY * K};
+          IQ = -Q * sqrt(K);
+          return true;
+        }
+      default:
+        return false;
+      }
+    } /* End of 'Image' function */
+
+    /* Boundaries comparison function.
+     * ARGUMENTS:
+     *   - Boundary to compare with:
+     *       const boundary &Other;
+     * RETURNS:
+     *   (bool) true if boundaries are same.
+     */
+    bool operator==( const boundary &Other ) const
+    {
+      return Type == Other.Type && (Type == boundary_type::None ||
+        (Point.X == Other.Point.X && Point.Y == Other.Point.Y &&
+         Normal.X == Other.Normal.X && Normal.Y == Other.Normal.Y && Radius == Other.Radius));
+    } /* End of 'operator==' function */
+  }; /* end of 'boundary' structure */
+} /* end of 'prj::phys' namespace */
+
+#endif /* __ef_boundary_h__ */
+
+/* END OF 'ef_boundary.h' FILE */
@@ -0,0 +1,464 @@
+/* FILE NAME   : 'ef_charges.cpp'
+ * PURPOSE     : Physics module.
+ *               Charges pool (slot map with generational handles) implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#include <pch.h>
+
+#include "ef_charges.h"
+#include "ef_sources.h"
+
+using namespace prj::phys;
+
+/* Grid cell coordinates bound (keys are biased by it) */
+static constexpr INT CellBound {1 << 30};
+
+/* Grid cell coordinate evaluation function.
+ * ARGUMENTS:
+ *   - Coordinate:
+ *       dbl V;
+ *   - Cell size:
+ *       dbl Size;
+ * RETURNS:
+ *   (INT) Cell coordinate (clamped to cells bound).
+ */
+static INT CellCoord( dbl V, dbl Size )
+{
+  const dbl C {floor(V / Size)};
+
+  if (!(C > -CellBound))
+    return -CellBound;
+  if (C >= CellBound)
+    return CellBound - 1;
+  return (INT)C;
+} /* End of 'CellCoord' function */
+
+/* Grid cell key evaluation function.
+ * ARGUMENTS:
+ *   - Cell coordinates:
+ *       INT X, Y;
+ * RETURNS:
+ *   (UINT64) Key.
+ */
+static UINT64 CellKey( INT X, INT Y )
+{
+  return ((UINT64)(X + CellBound) << 32) | (UINT64)(Y + CellBound);
+} /* End of 'CellKey' function */
+
+/* Constructor from charges list.
+ * ARGUMENTS:
+ *   - Charges:
+ *       std::initializer_list<charge> Charges;
+ */
+charge_pool::charge_pool( std::initializer_list<charge> Charges )
+{
+  for (const auto &Elm : Charges)
+    Add(Elm);
+} /* End of 'charge_pool::charge_pool' function */
+
+/* Charge mirror in structure of arrays updating function.
+ * ARGUMENTS:
+ *   - Dense index:
+ *       size_t Index;
+ */
+void charge_pool::Mirror( size_t Index )
+{
+  const charge &Elm {Dense[Index]};
+
+  /* Zero charge far away gives exact zero input without division by zero */
+  if (Elm.Shape.Type == source_type::Point)
+    X[Index] = Elm.Coord.X, Y[Index] = Elm.Coord.Y, Q[Index] = Elm.Charge;
+  else
+    X[Index] = 1e30, Y[Index] = 1e30, Q[Index] = 0;
+} /* End of 'charge_pool::Mirror' function */
+
+/* Charge adding function.
+ * ARGUMENTS:
+ *   - Charge:
+ *       const charge &Elm;
+ * RETURNS:
+ *   (charge_handle) Charge handle.
+ */
+charge_handle charge_pool::Add( const charge &Elm )
+{
+  UINT32 Slot {FreeSlot};
+
+  if (Slot != NoSlot)
+    FreeSlot = Slots[Slot].Index;
+  else
+  {
+    Slot = (UINT32)Slots.size();
+    Slots.push_back({0, 1});
+  }
+
+  Slots[Slot].Index = (UINT32)Dense.size();
+  Dense.push_back(Elm);
+  DenseSlots.push_back(Slot);
+  X.push_back(0), Y.push_back(0), Q.push_back(0);
+  Mirror(Dense.size() - 1);
+  Link(Slot);
+
+  if (Elm.Shape.Type == source_type::Point)
+    PointsCount++;
+
+  return {Slot, Slots[Slot].Generation};
+} /* End of 'charge_pool::Add' function */
+
+/* Charge removing function (order of other charges is kept).
+ * ARGUMENTS:
+ *   - Charge handle:
+ *       charge_handle Handle;
+ * RETURNS:
+ *   (bool) true if charge was in pool.
+ */
+bool charge_pool::Remove( charge_handle Handle )
+{
+  if (Get(Handle) == nullptr)
+    return false;
+
+  const size_t Index {Slots[Handle.Slot].Index};
+
+  if (Dense[Index].Shape.Type == source_type::Point)
+    PointsCount--;
+
+  Unlink(Handle.Slot);
+  Dense.erase(Dense.begin() + Index);
+  DenseSlots.erase(DenseSlots.begin() + Index);
+  X.erase(X.begin() + Index), Y.erase(Y.begin() + Index), Q.erase(Q.begin() + Index);
+
+  /* Charges after removed one are shifted */
+  for (size_t i = Index; i < DenseSlots.size(); i++)
+    Slots[DenseSlots[i]].Index = (UINT32)i;
+
+  /* Zero generation is never given */
+  auto &Slot {Slots[Handle.Slot]};
+
+  if (++Slot.Generation == 0)
+    Slot.Generation = 1;
+  Slot.Index = FreeSlot;
+  FreeSlot = Handle.Slot;
+
+  return true;
+} /* End of 'charge_pool::Remove' function */
+
+/* Charge changing function.
+ * ARGUMENTS:
+ *   - Charge handle:
+ *       charge_handle Handle;
+ *   - New charge data:
+ *       const charge &Elm;
+ * RETURNS:
+ *   (bool) true if charge is in pool.
+ */
+bool charge_pool::Set( charge_handle Handle, const charge &Elm )
+{
+  if (Get(Handle) == nullptr)
+    return false;
+
+  const size_t Index {Slots[Handle.Slot].Index};
+
+  PointsCount += (Elm.Shape.Type == source_type::Point) - (Dense[Index].Shape.Type == source_type::Point);
+  Unlink(Handle.Slot);
+  Dense[Index] = Elm;
+  Mirror(Index);
+  Link(Handle.Slot);
+
+  return true;
+} /* End of 'charge_pool::Set' function */
+
+/* All charges removing function (all handles become stale) */
+void charge_pool::Clear( void )
+{
+  while (!Dense.empty())
+    Remove(Handle(Dense.size() - 1));
+} /* End of 'charge_pool::Clear' function */
+
+/* Charge reach (source extent with seed circle, all its lines start and end inside) radius getting function.
+ * ARGUMENTS:
+ *   - Charge:
+ *       const charge &Elm;
+ * RETURNS:
+ *   (dbl) Radius around charge coordinate.
+ */
+dbl charge_pool::Reach( const charge &Elm )
+{
+  return SourceRadius(Elm.Shape) + Elm.Size * 2;
+} /* End of 'charge_pool::Reach' function */
+
+/* Charge to grid placing function.
+ * ARGUMENTS:
+ *   - Charge slot:
+ *       UINT32 Slot;
+ */
+void charge_pool::Link( UINT32 Slot )
+{
+  auto &Place {Slots[Slot]};
+  const charge &Elm {Dense[Place.Index]};
+  const dbl R {Reach(Elm)};
+
+  /* Charge is tested from neighbour cells only, so its level cell is not less than its reach */
+  Place.Level = 0;
+  for (dbl Size = CellSize; Place.Level < Levels && !(R <= Size); Size *= 4)
+    Place.Level++;
+
+  if (Place.Level == Levels || !std::isfinite(Elm.Coord.X) || !std::isfinite(Elm.Coord.Y))
+  {
+    Place.Level = Levels;
+    Place.CellIndex = (UINT32)LargeSlots.size();
+    LargeSlots.push_back(Slot);
+    return;
+  }
+
+  const dbl Size {CellSize * (1 << (Place.Level * 2))};
+
+  Place.Cell = CellKey(CellCoord(Elm.Coord.X, Size), CellCoord(Elm.Coord.Y, Size));
+
+  auto &List {Cells[Place.Level][Place.Cell]};
+
+  Place.CellIndex = (UINT32)List.size();
+  List.push_back(Slot);
+} /* End of 'charge_pool::Link' function */
+
+/* Charge from grid removing function.
+ * ARGUMENTS:
+ *   - Charge slot:
+ *       UINT32 Slot;
+ */
+void charge_pool::Unlink( UINT32 Slot )
+{
+  const auto &Place {Slots[Slot]};
+  const bool IsLarge {Place.Level == Levels};
+  auto Found {IsLarge ? Cells[0].end() : Cells[Place.Level].find(Place.Cell)};
+  auto &List {IsLarge ? LargeSlots : Found->second};
+
+  /* Last slot of cell takes place of removed one */
+  const UINT32 Last {List.back()};
+
+  List[Place.CellIndex] = Last;
+  Slots[Last].CellIndex = Place.CellIndex;
+  List.pop_back();
+
+  if (List.empty() && !IsLarge)
+    Cells[Place.Level].erase(Found);
+} /* End of 'charge_pool::Unlink' function */
+
+/* Charges with reach boxes intersecting box gathering function.
+ * ARGUMENTS:
+ *   - Box corners:
+ *       const coordd &Min, &Max;
+ *   - Charges dense indices (out, sorted):
+ *       std::vector<size_t> &Indices;
+ */
+void charge_pool::Gather( const coordd &Min, const coordd &Max, std::vector<size_t> &Indices ) const
+{
+  Indices.clear();
+  if (!(Min.X <= Max.X && Min.Y <= Max.Y))
+    return;
+
+  auto Test = [&]( UINT32 Slot )
+    {
+      const size_t Index {Slots[Slot].Index};
+      const charge &Elm {Dense[Index]};
+      const dbl R {Reach(Elm)};
+
+      if (Elm.Coord.X + R >= Min.X && Elm.Coord.X - R <= Max.X && Elm.Coord.Y + R >= Min.Y && Elm.Coord.Y - R <= Max.Y)
+        Indices.push_back(Index);
+    };
+
+  for (const UINT32 Slot : LargeSlots)
+    Test(Slot);
+
+  for (UINT32 Level = 0; Level < Levels; Level++)
+  {
+    const auto &LevelCells {Cells[Level]};
+
+    if (LevelCells.empty())
+      continue;
+
+    /* Charges of neighbour cells may reach box */
+    const dbl Size {CellSize * (1 << (Level * 2))};
+    const INT
+      X0 {CellCoord(Min.X - Size, Size)}, Y0 {CellCoord(Min.Y - Size, Size)},
+      X1 {CellCoord(Max.X + Size, Size)}, Y1 {CellCoord(Max.Y + Size, Size)};
+
+    /* Box with more cells than occupied ones is tested by occupied cells */
+    if (((UINT64)X1 - X0 + 1) * ((UINT64)Y1 - Y0 + 1) > LevelCells.size())
+    {
+      for (const auto &[Key, List] : LevelCells)
+      {
+        const INT CX {(INT)(Key >> 32) - CellBound}, CY {(INT)(Key & 0xFFFFFFFF) - CellBound};
+
+        if (CX >= X0 && CX <= X1 && CY >= Y0 && CY <= Y1)
+          for (const UINT32 Slot : List)
+            Test(Slot);
+      }
+    }
+    else
+      for (INT y = Y0; y <= Y1; y++)
+        for (INT x = X0; x <= X1; x++)
+          if (const auto Found {LevelCells.find(CellKey(x, y))}; Found != LevelCells.end())
+            for (const UINT32 Slot : Found->second)
+              Test(Slot);
+  }
+
+  /* Results are in pool order independent of cells placement */
+  std::sort(Indices.begin(), Indices.end());
+} /* End of 'charge_pool::Gather' function */
+
+/* Charges near point finding function.
+ * ARGUMENTS:
+ *   - Point:
+ *       const coordd &P;
+ *   - Distance from charge reach circle:
+ *       dbl Radius;
+ *   - Charges dense indices (out, sorted):
+ *       std::vector<size_t> &Indices;
+ */
+void charge_pool::FindNear( const coordd &P, dbl Radius, std::vector<size_t> &Indices ) const
+{
+  Gather({P.X - Radius, P.Y - Radius}, {P.X + Radius, P.Y + Radius}, Indices);
+
+  std::erase_if(Indices, [&]( size_t Index )
+    {
+      const charge &Elm {Dense[Index]};
+      const dbl R {Reach(Elm) + Radius};
+
+      return (Elm.Coord.X - P.X) * (Elm.Coord.X - P.X) + (Elm.Coord.Y - P.Y) * (Elm.Coord.Y - P.Y) > R * R;
+    });
+} /* End of 'charge_pool::FindNear' function */
+
+/* Charges in box finding function.
+ * ARGUMENTS:
+ *   - Box corners:
+ *       const coordd &Min, &Max;
+ *   - Charges (with reach boxes intersecting box) dense indices (out, sorted):
+ *       std::vector<size_t> &Indices;
+ */
+void charge_pool::FindInBox( const coordd &Min, const coordd &Max, std::vector<size_t> &Indices ) const
+{
+  Gather(Min, Max, Indices);
+} /* End of 'charge_pool::FindInBox' function */
+
+/* Charges grid queries versus all charges scan benchmark (with results comparison) function.
+ * ARGUMENTS:
+ *   - Charges count:
+ *       size_t Count;
+ *   - Queries count:
+ *       size_t Queries;
+ * RETURNS:
+ *   (std::string) Report.
+ */
+std::string prj::phys::BenchmarkChargeQueries( size_t Count, size_t Queries )
+{
+  /* Charges are spread with constant density, some of them are segments longer than grid cell */
+  const dbl Area {sqrt((dbl)Count) * 2};
+  charge_pool Charges {};
+  std::vector<charge_handle> Handles {};
+
+  for (size_t i = 0; i < Count; i++)
+  {
+    const dbl Angle {2.39996 * i}, Radius {Area * sqrt((i + 0.5) / Count)};
+    const source_shape Shape {i % 16 == 0 ? source_shape {source_type::Segment, 6, 0.3, Angle} : source_shape {}};
+
+    Handles.push_back(Charges.Add({{Radius * cos(Angle), Radius * sin(Angle)}, i % 2 == 0 ? 1.0 : -1.0, 0.5, Shape}));
+  }
+
+  /* Grid is kept by edits: some charges are moved to other cells, some are removed */
+  for (size_t i = 0; i < Count; i += 3)
+  {
+    charge Elm {*Charges.Get(Handles[i])};
+
+    Elm.Coord.X += 5.5, Elm.Coord.Y -= 3.5;
+    Charges.Set(Handles[i], Elm);
+  }
+  for (size_t i = 0; i < Count; i += 7)
+    Charges.Remove(Handles[i]);
+
+  std::vector<coordd> Points {};
+
+  for (size_t i = 0; i < Queries; i++)
+  {
+    const dbl Angle {2.39996 * i}, Radius {Area * 1.1 * sqrt((i + 0.5) / Queries)};
+
+    Points.push_back({Radius * cos(Angle), Radius * sin(Angle)});
+  }
+
+  /* Scan results are tested in same way as grid candidates */
+  auto ScanNear = [&]( const coordd &P, dbl Radius, std::vector<size_t> &Indices )
+    {
+      Indices.clear();
+      for (size_t i = 0; i < Charges.Size(); i++)
+      {
+        const auto &Elm {Charges[i]};
+        const dbl R {charge_pool::Reach(Elm) + Radius};
+
+        if ((Elm.Coord.X - P.X) * (Elm.Coord.X - P.X) + (Elm.Coord.Y - P.Y) * (Elm.Coord.Y - P.Y) <= R * R)
+          Indices.push_back(i);
+      }
+    };
+  auto ScanBox = [&]( const coordd &Min, const coordd &Max, std::vector<size_t> &Indices )
+    {
+      Indices.clear();
+      for (size_t i = 0; i < Charges.Size(); i++)
+      {
+        const auto &Elm {Charges[i]};
+        const dbl R {charge_pool::Reach(Elm)};
+
+        if (Elm.Coord.X + R >= Min.X && Elm.Coord.X - R <= Max.X && Elm.Coord.Y + R >= Min.Y && Elm.Coord.Y - R <= Max.Y)
+          Indices.push_back(i);
+      }
+    };
+
+  UINT64 Freq, Start, End;
+  dbl Times[4] {};
+  size_t Found[2] {}, Mismatches {0};
+  std::vector<size_t> A {}, B {};
+
+  QueryPerformanceFrequency((LARGE_INTEGER *)&Freq);
+
+  /* Picking (near point) and frame (box) queries */
+  for (INT Mode = 0; Mode < 2; Mode++)
+    for (const auto &P : Points)
+    {
+      const coordd Min {P.X - 18, P.Y - 18}, Max {P.X + 18, P.Y + 18};
+
+      QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+      if (Mode == 0)
+        Charges.FindNear(P, 0.125, A);
+      else
+        Charges.FindInBox(Min, Max, A);
+      QueryPerformanceCounter((LARGE_INTEGER *)&End);
+      Times[Mode * 2] += (dbl)(End - Start) / Freq;
+
+      QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+      if (Mode == 0)
+        ScanNear(P, 0.125, B);
+      else
+        ScanBox(Min, Max, B);
+      QueryPerformanceCounter((LARGE_INTEGER *)&End);
+      Times[Mode * 2 + 1] += (dbl)(End - Start) / Freq;
+
+      Found[Mode] += A.size();
+      Mismatches += A != B;
+    }
+
+  CHAR Buf[0x200];
+  const dbl Div {1e9 / std::max<size_t>(Queries, 1)};
+
+  sprintf(Buf,
+          "Charges grid queries benchmark (%zu charges after moves and removals, %zu queries):\n"
+          "  - near point: grid %.1f ns/query, scan %.1f ns/query (%.1fx), %.2f charges/query\n"
+          "  - frame box: grid %.1f ns/query, scan %.1f ns/query (%.1fx), %.2f charges/query\n"
+          "  Results %s (%zu mismatches)\n",
+          Charges.Size(), Queries,
+          Times[0] * Div, Times[1] * Div, Times[1] / std::max(Times[0], 1e-12), (dbl)Found[0] / std::max<size_t>(Queries, 1),
+          Times[2] * Div, Times[3] * Div, Times[3] / std::max(Times[2], 1e-12), (dbl)Found[1] / std::max<size_t>(Queries, 1),
+          Mismatches == 0 ? "match" : "DIFFER", Mismatches);
+
+  return Buf;
+} /* End of 'prj::phys::BenchmarkChargeQueries' function */
+
+/* END OF 'ef_charges.cpp' FILE */
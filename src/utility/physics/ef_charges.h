@@ -0,0 +1,353 @@
+/* FILE NAME   : 'ef_charges.h'
+ * PURPOSE     : Physics module.
+ *               Charges pool (slot map with generational handles) handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#ifndef __ef_charges_h__
+#define __ef_charges_h__
+
+#include "physics_def.h"
+
+/* Project namespace // Physics module */
+namespace prj::phys
+{
+  /* Charge handle (pool slot and its generation, zero generation - no charge) */
+  struct charge_handle
+  {
+    UINT32 Slot {0}, Generation {0};
+
+    /* Handle validity (not pool charge presence) check function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (bool) true if handle was given by pool.
+     */
+    bool IsValid( void ) const
+    {
+      return Generation != 0;
+    } /* End of 'IsValid' function */
+
+    /* Handles comparison function */
+    bool operator==( const charge_handle &Other ) const = default;
+  }; /* end of 'charge_handle' structure */
+
+  /* Charges pool (slot map).
+   * Charges are stored densely in insertion order, so iteration is linear over contiguous memory.
+   * Handles address slots, slot generation is increased on charge removal, so stale handles are detected
+   * and handles of other charges stay valid after storage reallocation and removal.
+   * Point charges coordinates and values are mirrored in structure of arrays in same order
+   * (extended sources are zero charges far away), so vector kernels read pool directly.
+   * Charges are also placed in loose hashed grids (charge is in cell of its center on first level, where its reach
+   * is not greater than cell size, cell size grows 4 times per level), so near point and box queries test only few charges.
+   * Charges are changed only by pool functions, which keep mirror and grid in sync.
+   */
+  class charge_pool
+  {
+  private:
+    /* Charges in dense order and their slots */
+    std::vector<charge> Dense {};
+    std::vector<UINT32> DenseSlots {};
+
+    /* Point charges coordinates and values in dense order */
+    std::vector<dbl> X {}, Y {}, Q {};
+
+    /* Point charges count */
+    size_t PointsCount {0};
+
+    /* Slot: charge dense index (next free slot for free one), generation and grid place (cell key, level and index in cell) */
+    struct slot
+    {
+      UINT32 Index;
+      UINT32 Generation;
+      UINT64 Cell;
+      UINT32 Level;
+      UINT32 CellIndex;
+    }; /* end of 'slot' structure */
+
+    /* Slots and free slots list head */
+    std::vector<slot> Slots {};
+    UINT32 FreeSlot {NoSlot};
+
+    /* Free slots list end mark */
+    static constexpr UINT32 NoSlot {0xFFFFFFFF};
+
+    /* Grid levels count and first level cell size */
+    static constexpr UINT32 Levels {8};
+    static constexpr dbl CellSize {4};
+
+    /* Grid levels cells (slots of charges by cell key) and slots of charges larger than last level cell */
+    std::unordered_map<UINT64, std::vector<UINT32>> Cells[Levels] {};
+    std::vector<UINT32> LargeSlots {};
+
+    /* Charge to grid placing function.
+     * ARGUMENTS:
+     *   - Charge slot:
+     *       UINT32 Slot;
+     */
+    void Link( UINT32 Slot );
+
+    /* Charge from grid removing function.
+     * ARGUMENTS:
+     *   - Charge slot:
+     *       UINT32 Slot;
+     */
+    void Unlink( UINT32 Slot );
+
+    /* Charges with reach boxes intersecting box gathering function.
+     * ARGUMENTS:
+     *   - Box corners:
+     *       const coordd &Min, &Max;
+     *   - Charges dense indices (out, sorted):
+     *       std::vector<size_t> &Indices;
+     */
+    void Gather( const coordd &Min, const coordd &Max, std::vector<size_t> &Indices ) const;
+
+    /* Charge mirror in structure of arrays updating function.
+     * ARGUMENTS:
+     *   - Dense index:
+     *       size_t Index;
+     */
+    void Mirror( size_t Index );
+
+  public:
+    /* Default constructor */
+    charge_pool( void ) = default;
+
+    /* Constructor from charges list.
+     * ARGUMENTS:
+     *   - Charges:
+     *       std::initializer_list<charge> Charges;
+     */
+    charge_pool( std::initializer_list<charge> Charges );
+
+    /* Charge adding function.
+     * ARGUMENTS:
+     *   - Charge:
+     *       const charge &Elm;
+     * RETURNS:
+     *   (charge_handle) Charge handle.
+     */
+    charge_handle Add( const charge &Elm );
+
+    /* Charge removing function (order of other charges is kept).
+     * ARGUMENTS:
+     *   - Charge handle:
+     *       charge_handle Handle;
+     * RETURNS:
+     *   (bool) true if charge was in pool.
+     */
+    bool Remove( charge_handle Handle );
+
+    /* Charge changing function.
+     * ARGUMENTS:
+     *   - Charge handle:
+     *       charge_handle Handle;
+     *   - New charge data:
+     *       const charge &Elm;
+     * RETURNS:
+     *   (bool) true if charge is in pool.
+     */
+    bool Set( charge_handle Handle, const charge &Elm );
+
+    /* All charges removing function (all handles become stale) */
+    void Clear( void );
+
+    /* Charges near point finding function.
+     * ARGUMENTS:
+     *   - Point:
+     *       const coordd &P;
+     *   - Distance from charge reach circle:
+     *       dbl Radius;
+     *   - Charges dense indices (out, sorted):
+     *       std::vector<size_t> &Indices;
+     */
+    void FindNear( const coordd &P, dbl Radius, std::vector<size_t> &Indices ) const;
+
+    /* Charges in box finding function.
+     * ARGUMENTS:
+     *   - Box corners:
+     *       const coordd &Min, &Max;
+     *   - Charges (with reach boxes intersecting box) dense indices (out, sorted):
+     *       std::vector<size_t> &Indices;
+     */
+    void FindInBox( const coordd &Min, const coordd &Max, std::vector<size_t> &Indices ) const;
+
+    /* Charge reach (source extent with seed circle, all its lines start and end inside) radius getting function.
+     * ARGUMENTS:
+     *   - Charge:
+     *       const charge &Elm;
+     * RETURNS:
+     *   (dbl) Radius around charge coordinate.
+     */
+    static dbl Reach( const charge &Elm );
+
+    /* Charge by handle getting function.
+     * ARGUMENTS:
+     *   - Charge handle:
+     *       charge_handle Handle;
+     * RETURNS:
+     *   (const charge *) Charge (nullptr if handle is stale).
+     */
+    const charge *Get( charge_handle Handle ) const
+    {
+      if (Handle.Slot >= Slots.size() || Slots[Handle.Slot].Generation != Handle.Generation || !Handle.IsValid())
+        return nullptr;
+      return &Dense[Slots[Handle.Slot].Index];
+    } /* End of 'Get' function */
+
+    /* Charge handle by dense index getting function.
+     * ARGUMENTS:
+     *   - Dense index:
+     *       size_t Index;
+     * RETURNS:
+     *   (charge_handle) Charge handle.
+     */
+    charge_handle Handle( size_t Index ) const
+    {
+      const UINT32 Slot {DenseSlots[Index]};
+
+      return {Slot, Slots[Slot].Generation};
+    } /* End of 'Handle' function */
+
+    /* Charge by dense index getting function.
+     * ARGUMENTS:
+     *   - Dense index:
+     *       size_t Index;
+     * RETURNS:
+     *   (const charge &) Charge.
+     */
+    const charge &operator[]( size_t Index ) const
+    {
+      return Dense[Index];
+    } /* End of 'operator[]' function */
+
+    /* Charges count getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (size_t) Charges count.
+     */
+    size_t Size( void ) const
+    {
+      return Dense.size();
+    } /* End of 'Size' function */
+
+    /* Charges absence check function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (bool) true if there are no charges.
+     */
+    bool IsEmpty( void ) const
+    {
+      return Dense.empty();
+    } /* End of 'IsEmpty' function */
+
+    /* Point charges count getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (size_t) Count of charges which are not extended sources.
+     */
+    size_t GetPointsCount( void ) const
+    {
+      return PointsCount;
+    } /* End of 'GetPointsCount' function */
+
+    /* Point charges mirror (in dense order, extended sources are zero charges far away) getting functions.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const dbl *) Coordinates or values array.
+     */
+    const dbl *GetX( void ) const
+    {
+      return X.data();
+    } /* End of 'GetX' function */
+    const dbl *GetY( void ) const
+    {
+      return Y.data();
+    } /* End of 'GetY' function */
+    const dbl *GetQ( void ) const
+    {
+      return Q.data();
+    } /* End of 'GetQ' function */
+
+    /* Charges iteration (dense order) functions */
+    std::vector<charge>::const_iterator begin( void ) const
+    {
+      return Dense.begin();
+    } /* End of 'begin' function */
+    std::vector<charge>::const_iterator end( void ) const
+    {
+      return Dense.end();
+    } /* End of 'end' function */
+  }; /* end of 'charge_pool' class */
+
+  /* Charges attached data storage (indexed by handle slot).
+   * Value of stale handle slot is reset on first access by new handle, so removed charges data is dropped lazily.
+   * Values are stored in slots order, so references to value internals (e.g. vector elements) survive pool changes.
+   */
+  template<typename value>
+    class charge_map
+    {
+    private:
+      /* Values and their handles generations by slot */
+      std::vector<value> Values {};
+      std::vector<UINT32> Generations {};
+
+    public:
+      /* Value by handle getting (default one is created for new handle) function.
+       * ARGUMENTS:
+       *   - Charge handle:
+       *       charge_handle Handle;
+       * RETURNS:
+       *   (value &) Value.
+       */
+      value &operator[]( charge_handle Handle )
+      {
+        if (Handle.Slot >= Values.size())
+          Values.resize(Handle.Slot + 1), Generations.resize(Handle.Slot + 1, 0);
+        if (Generations[Handle.Slot] != Handle.Generation)
+          Values[Handle.Slot] = value {}, Generations[Handle.Slot] = Handle.Generation;
+        return Values[Handle.Slot];
+      } /* End of 'operator[]' function */
+
+      /* Value by handle finding function.
+       * ARGUMENTS:
+       *   - Charge handle:
+       *       charge_handle Handle;
+       * RETURNS:
+       *   (const value *) Value (nullptr if handle has no value).
+       */
+      const value *Find( charge_handle Handle ) const
+      {
+        if (Handle.Slot >= Values.size() || Generations[Handle.Slot] != Handle.Generation || !Handle.IsValid())
+          return nullptr;
+        return &Values[Handle.Slot];
+      } /* End of 'Find' function */
+
+      /* All values removing function */
+      void Clear( void )
+      {
+        Values.clear();
+        Generations.clear();
+      } /* End of 'Clear' function */
+    }; /* end of 'charge_map' class */
+
+  /* Charges force lines storage (lines of every charge by its handle) */
+  using charge_lines = charge_map<std::vector<std::vector<coordf>>>;
+
+  /* Charges grid queries versus all charges scan benchmark (with results comparison) function.
+   * ARGUMENTS:
+   *   - Charges count:
+   *       size_t Count;
+   *   - Queries count:
+   *       size_t Queries;
+   * RETURNS:
+   *   (std::string) Report.
+   */
+  std::string BenchmarkChargeQueries( size_t Count, size_t Queries );
+} /* end of 'prj::phys' namespace */
+
+#endif /* __ef_charges_h__ */
+
+/* END OF 'ef_charges.h' FILE */
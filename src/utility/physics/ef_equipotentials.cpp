@@ -0,0 +1,501 @@
+/* FILE NAME   : 'ef_equipotentials.cpp'
+ * PURPOSE     : Physics module.
+ *               Equipotential contours evaluation class implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#include <pch.h>
+
+#include "ef_equipotentials.h"
+#include "utility/threads_pool/threads_pool.hpp"
+
+using namespace prj::phys;
+
+/* Tile sample position evaluation function.
+ * ARGUMENTS:
+ *   - Tile:
+ *       const tile &Tile;
+ *   - Sample indices:
+ *       size_t I, J;
+ * RETURNS:
+ *   (coordd) Position.
+ */
+coordd equipotentials::SamplePos( const tile &Tile, size_t I, size_t J ) const
+{
+  /* Global sample indices make neighbour tiles of same level share bit-identical samples */
+  const size_t Cells {BaseCells << Tile.Level};
+  const dbl TotalCells {(dbl)(Cells * TilesSide)};
+
+  return {Min.X + (Max.X - Min.X) * (Tile.X * Cells + I) / TotalCells,
+          Min.Y + (Max.Y - Min.Y) * (Tile.Y * Cells + J) / TotalCells};
+} /* End of 'equipotentials::SamplePos' function */
+
+/* Tile refinement level evaluation function.
+ * ARGUMENTS:
+ *   - Tile indices:
+ *       INT X, Y;
+ *   - Charges:
+ *       const std::vector<charge_state> &Charges;
+ * RETURNS:
+ *   (UINT) Level.
+ */
+UINT equipotentials::EvalLevel( INT X, INT Y, const std::vector<charge_state> &Charges ) const
+{
+  const dbl
+    TileW {(Max.X - Min.X) / TilesSide},
+    TileH {(Max.Y - Min.Y) / TilesSide},
+    CenterX {Min.X + TileW * (X + 0.5)},
+    CenterY {Min.Y + TileH * (Y + 0.5)},
+    HalfDiag {hypot(TileW, TileH) * 0.5};
+
+  UINT Level {0};
+
+  /* Potential changes fast near charges */
+  for (const auto &Elm : Charges)
+  {
+    const dbl Dist {hypot(Elm.Coord.X - CenterX, Elm.Coord.Y - CenterY) - SourceRadius(Elm.Shape) - HalfDiag};
+
+    if (Dist <= 0)
+      return MaxLevel;
+
+    Level = std::max(Level, (UINT)std::clamp(log2(HalfDiag * 2 / Dist) + 1, 0.0, (dbl)MaxLevel));
+  }
+
+  return Level;
+} /* End of 'equipotentials::EvalLevel' function */
+
+/* Tile potential full evaluation function.
+ * ARGUMENTS:
+ *   - Tile:
+ *       tile &Tile;
+ *   - Charges snapshot:
+ *       const field_snapshot &Snapshot;
+ */
+void equipotentials::EvalTile( tile &Tile, const field_snapshot &Snapshot ) const
+{
+  const size_t Side {(BaseCells << Tile.Level) + 1};
+  std::vector<coordd> Points {};
+
+  Points.reserve(Side * Side);
+  for (size_t j = 0; j < Side; j++)
+    for (size_t i = 0; i < Side; i++)
+      Points.push_back(SamplePos(Tile, i, j));
+
+  field_out Out {};
+
+  Tile.Phi.resize(Side * Side);
+  Out.Phi = Tile.Phi.data();
+  EvalField(Snapshot, Points.data(), Points.size(), Out);
+} /* End of 'equipotentials::EvalTile' function */
+
+/* Tile potential update for single charge change function (charge images are updated too).
+ * ARGUMENTS:
+ *   - Tile:
+ *       tile &Tile;
+ *   - Old and new charge states:
+ *       const charge_state &Old, &New;
+ */
+void equipotentials::UpdateTile( tile &Tile, const charge_state &Old, const charge_state &New ) const
+{
+  const size_t Side {(BaseCells << Tile.Level) + 1};
+
+  /* Charge with its boundary image potential (screened charges give nothing) */
+  auto Potential = [&]( const charge_state &Elm, const coordd &Pos ) -> dbl
+    {
+      if (!Boundary.IsValid())
+        return Elm.Charge / hypot(Pos.X - Elm.Coord.X, Pos.Y - Elm.Coord.Y);
+
+      coordd IC;
+      dbl IQ;
+
+      if (!Boundary.Image(Elm.Coord, Elm.Charge, IC, IQ))
+        return 0;
+      return Elm.Charge / hypot(Pos.X - Elm.Coord.X, Pos.Y - Elm.Coord.Y) + IQ / hypot(Pos.X - IC.X, Pos.Y - IC.Y);
+    };
+
+  /* Potential is linear in charges (and stays zero inside conductor) */
+  for (size_t j = 0; j < Side; j++)
+    for (size_t i = 0; i < Side; i++)
+    {
+      const coordd Pos {SamplePos(Tile, i, j)};
+
+      if (Boundary.Distance(Pos) >= 0)
+        Tile.Phi[j * Side + i] += Potential(New, Pos) - Potential(Old, Pos);
+    }
+} /* End of 'equipotentials::UpdateTile' function */
+
+/* Tile contour segments extraction (marching squares) function.
+ * ARGUMENTS:
+ *   - Tile:
+ *       tile &Tile;
+ */
+void equipotentials::ExtractSegments( tile &Tile ) const
+{
+  /* Segments edges by cell case (edges: 0 - bottom, 1 - right, 2 - top, 3 - left), saddles are resolved separately */
+  static const INT Table[16][4]
+  {
+    {-1, -1, -1, -1}, {3, 0, -1, -1}, {0, 1, -1, -1}, {3, 1, -1, -1},
+    {1, 2, -1, -1},   {-1, -1, -1, -1}, {0, 2, -1, -1}, {3, 2, -1, -1},
+    {2, 3, -1, -1},   {0, 2, -1, -1}, {-1, -1, -1, -1}, {1, 2, -1, -1},
+    {3, 1, -1, -1},   {0, 1, -1, -1}, {3, 0, -1, -1}, {-1, -1, -1, -1},
+  };
+
+  const size_t
+    Cells {BaseCells << Tile.Level},
+    Side {Cells + 1};
+
+  Tile.Segments.clear();
+
+  /* Infinite values at charges centers are clamped */
+  auto Value = [&]( size_t I, size_t J ) -> dbl
+    {
+      const dbl Val {Tile.Phi[J * Side + I]};
+
+      return std::isnan(Val) ? 0.0 : std::clamp(Val, -1e300, 1e300);
+    };
+
+  for (size_t LevelIndex = 0; LevelIndex < Levels.size(); LevelIndex++)
+  {
+    const dbl Level {Levels[LevelIndex]};
+
+    for (size_t j = 0; j < Cells; j++)
+      for (size_t i = 0; i < Cells; i++)
+      {
+        const dbl V[4] {Value(i, j), Value(i + 1, j), Value(i + 1, j + 1), Value(i, j + 1)};
+        const UINT Case {(UINT)(V[0] > Level) | (UINT)(V[1] > Level) << 1 | (UINT)(V[2] > Level) << 2 | (UINT)(V[3] > Level) << 3};
+
+        if (Case == 0 || Case == 15)
+          continue;
+
+        /* Edge crossing point (nodes are always taken in same order, so neighbour cells give same point) */
+        auto Crossing = [&]( INT Edge ) -> coordd
+          {
+            static const INT Nodes[4][2] {{0, 1}, {1, 2}, {3, 2}, {0, 3}};
+            static const INT Offsets[4][2] {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+
+            const INT A {Nodes[Edge][0]}, B {Nodes[Edge][1]};
+            const coordd
+              PA {SamplePos(Tile, i + Offsets[A][0], j + Offsets[A][1])},
+              PB {SamplePos(Tile, i + Offsets[B][0], j + Offsets[B][1])};
+            const dbl T {(Level - V[A]) / (V[B] - V[A])};
+
+            return {PA.X + (PB.X - PA.X) * T, PA.Y + (PB.Y - PA.Y) * T};
+          };
+
+        INT Edges[4];
+
+        if (Case == 5 || Case == 10)
+        {
+          /* Saddle - cell center value decides which corners are connected */
+          const bool IsCenterAbove {(V[0] + V[1] + V[2] + V[3]) * 0.25 > Level};
+
+          if ((Case == 5) == IsCenterAbove)
+            Edges[0] = 0, Edges[1] = 1, Edges[2] = 2, Edges[3] = 3;
+          else
+            Edges[0] = 3, Edges[1] = 0, Edges[2] = 1, Edges[3] = 2;
+        }
+        else
+          std::copy(Table[Case], Table[Case] + 4, Edges);
+
+        for (INT k = 0; k < 4 && Edges[k] >= 0; k += 2)
+          Tile.Segments.push_back({LevelIndex, {Crossing(Edges[k]), Crossing(Edges[k + 1])}});
+      }
+  }
+} /* End of 'equipotentials::ExtractSegments' function */
+
+/* Tiles segments stitching to polylines function */
+void equipotentials::Stitch( void )
+{
+  Lines.clear();
+  Stats.Segments = 0;
+
+  /* All segments by level */
+  std::vector<std::vector<std::pair<coordd, coordd>>> Segments(Levels.size());
+
+  for (const auto &Tile : Tiles)
+    for (const auto &[LevelIndex, Segment] : Tile.Segments)
+      Segments[LevelIndex].push_back(Segment), Stats.Segments++;
+
+  /* Exact point comparison (crossings inside one level of refinement are bit-identical) */
+  using point_key = std::pair<dbl, dbl>;
+
+  /* Coarsest cell size - tolerance for joining ends on tiles with different refinement */
+  const dbl Tolerance {(Max.X - Min.X) / (TilesSide * BaseCells) * 0.75};
+
+  for (auto &LevelSegments : Segments)
+  {
+    std::map<point_key, std::vector<size_t>> Ends {};
+    std::vector<bool> IsUsed(LevelSegments.size(), false);
+
+    for (size_t i = 0; i < LevelSegments.size(); i++)
+    {
+      Ends[{LevelSegments[i].first.X, LevelSegments[i].first.Y}].push_back(i);
+      Ends[{LevelSegments[i].second.X, LevelSegments[i].second.Y}].push_back(i);
+    }
+
+    /* Polyline extending from its end function */
+    auto Extend = [&]( std::deque<coordd> &Line, bool IsBack )
+      {
+        while (true)
+        {
+          const coordd &End {IsBack ? Line.back() : Line.front()};
+          const auto It {Ends.find({End.X, End.Y})};
+          bool IsExtended {false};
+
+          for (const size_t Index : It->second)
+            if (!IsUsed[Index])
+            {
+              const auto &Seg {LevelSegments[Index]};
+              const coordd Next {(Seg.first.X == End.X && Seg.first.Y == End.Y) ? Seg.second : Seg.first};
+
+              IsUsed[Index] = true;
+              IsBack ? Line.push_back(Next) : Line.push_front(Next);
+              IsExtended = true;
+              break;
+            }
+
+          if (!IsExtended)
+            break;
+        }
+      };
+
+    std::vector<std::deque<coordd>> Polylines {};
+
+    for (size_t i = 0; i < LevelSegments.size(); i++)
+      if (!IsUsed[i])
+      {
+        auto &Line {Polylines.emplace_back(std::deque<coordd> {LevelSegments[i].first, LevelSegments[i].second})};
+
+        IsUsed[i] = true;
+        Extend(Line, true);
+        Extend(Line, false);
+      }
+
+    /* Join open ends inside region (on borders between tiles of different refinement) */
+    auto IsInner = [&]( const coordd &Pt ) -> bool
+      {
+        return Pt.X > Min.X + Tolerance && Pt.X < Max.X - Tolerance && Pt.Y > Min.Y + Tolerance && Pt.Y < Max.Y - Tolerance;
+      };
+    auto IsClosed = [&]( const std::deque<coordd> &Line ) -> bool
+      {
+        return Line.front().X == Line.back().X && Line.front().Y == Line.back().Y;
+      };
+
+    for (size_t i = 0; i < Polylines.size(); i++)
+    {
+      auto &Line {Polylines[i]};
+
+      while (!Line.empty() && !IsClosed(Line) && IsInner(Line.back()))
+      {
+        /* Nearest other open end */
+        size_t Best {Polylines.size()};
+        bool IsBestFront {false};
+        dbl BestDist {Tolerance};
+
+        for (size_t k = 0; k < Polylines.size(); k++)
+        {
+          const auto &Other {Polylines[k]};
+
+          if (Other.empty() || IsClosed(Other))
+            continue;
+
+          for (const bool IsFront : {true, false})
+          {
+            if (k == i && !IsFront)
+              continue;
+
+            const coordd &Pt {IsFront ? Other.front() : Other.back()};
+            const dbl Dist {hypot(Pt.X - Line.back().X, Pt.Y - Line.back().Y)};
+
+            if (Dist < BestDist)
+              Best = k, IsBestFront = IsFront, BestDist = Dist;
+          }
+        }
+
+        if (Best == Polylines.size())
+          break;
+
+        if (Best == i)
+        {
+          /* Close line */
+          Line.push_back(Line.front());
+          break;
+        }
+
+        auto Other {std::move(Polylines[Best])};
+
+        Polylines[Best].clear();
+        if (IsBestFront)
+          Line.insert(Line.end(), Other.begin(), Other.end());
+        else
+          Line.insert(Line.end(), Other.rbegin(), Other.rend());
+      }
+    }
+
+    for (const auto &Line : Polylines)
+      if (Line.size() >= 2)
+      {
+        auto &Res {Lines.emplace_back()};
+
+        Res.reserve(Line.size());
+        for (const auto &Pt : Line)
+          Res.push_back({(flt)Pt.X, (flt)Pt.Y});
+      }
+  }
+
+  Stats.Polylines = Lines.size();
+} /* End of 'equipotentials::Stitch' function */
+
+/* Contour levels setting function (takes effect on next update).
+ * ARGUMENTS:
+ *   - Potential levels:
+ *       std::vector<dbl> NewLevels;
+ */
+void equipotentials::SetLevels( std::vector<dbl> NewLevels )
+{
+  if (NewLevels != Levels)
+  {
+    Levels = std::move(NewLevels);
+
+    /* Force full update */
+    Evaluated.clear();
+    Tiles.clear();
+  }
+} /* End of 'equipotentials::SetLevels' function */
+
+/* Contours update function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Evaluation region corners:
+ *       const coordd &RegionMin, &RegionMax;
+ *   - Periodic lattice evaluator (default: nullptr - charges are isolated):
+ *       const ewald_sum *Periodic;
+ *   - Grounded conductor boundary (default: none):
+ *       const boundary &NewBoundary;
+ */
+void equipotentials::Update( const charge_pool &Charges, const coordd &RegionMin, const coordd &RegionMax,
+                             const ewald_sum *Periodic, const boundary &NewBoundary )
+{
+  UINT64 Freq, Start, End;
+
+  QueryPerformanceFrequency((LARGE_INTEGER *)&Freq);
+  QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+
+  std::vector<charge_state> NewCharges {};
+
+  NewCharges.reserve(Charges.Size());
+  for (const auto &Elm : Charges)
+    NewCharges.push_back({Elm.Coord, Elm.Charge, Elm.Size, Elm.Shape});
+
+  /* Single changed charge search */
+  const periodic_cell NewLattice {Periodic != nullptr ? Periodic->GetCell() : periodic_cell {}};
+  const bool IsSameRegion
+  {
+    RegionMin.X == Min.X && RegionMin.Y == Min.Y && RegionMax.X == Max.X && RegionMax.Y == Max.Y &&
+    NewLattice.W == Lattice.W && NewLattice.H == Lattice.H && NewBoundary == Boundary
+  };
+  size_t Changed {NewCharges.size()}, ChangedCount {0};
+
+  if (IsSameRegion && !Tiles.empty() && NewCharges.size() == Evaluated.size())
+    for (size_t i = 0; i < NewCharges.size(); i++)
+      if (NewCharges[i].Coord.X != Evaluated[i].Coord.X || NewCharges[i].Coord.Y != Evaluated[i].Coord.Y ||
+          NewCharges[i].Charge != Evaluated[i].Charge || NewCharges[i].Size != Evaluated[i].Size ||
+          NewCharges[i].Shape != Evaluated[i].Shape)
+        Changed = i, ChangedCount++;
+
+  /* Charge move changes all its lattice images and reciprocal terms, so it has no cheap delta
+   * (extended source delta is not point charge one too) */
+  const bool IsIncremental
+  {
+    IsSameRegion && !Tiles.empty() && NewCharges.size() == Evaluated.size() &&
+    (ChangedCount == 0 || (ChangedCount == 1 && Periodic == nullptr &&
+                           NewCharges[Changed].Shape.Type == source_type::Point &&
+                           Evaluated[Changed].Shape.Type == source_type::Point))
+  };
+
+  if (IsIncremental && ChangedCount == 0)
+    return;
+
+  Min = RegionMin, Max = RegionMax;
+  Lattice = NewLattice;
+  Boundary = NewBoundary;
+
+  /* Tiles to evaluate fully or update */
+  std::vector<std::pair<tile *, bool>> Work {};
+
+  if (!IsIncremental)
+  {
+    Tiles.clear();
+    Tiles.reserve(TilesSide * TilesSide);
+
+    for (INT y = 0; y < TilesSide; y++)
+      for (INT x = 0; x < TilesSide; x++)
+        Tiles.push_back({x, y, EvalLevel(x, y, NewCharges), {}, {}});
+
+    for (auto &Tile : Tiles)
+      Work.push_back({&Tile, true});
+
+    Stats.FullUpdates++;
+  }
+  else
+  {
+    for (auto &Tile : Tiles)
+    {
+      const UINT NewLevel {EvalLevel(Tile.X, Tile.Y, NewCharges)};
+
+      /* Tiles with changed refinement are evaluated again */
+      Work.push_back({&Tile, NewLevel != Tile.Level});
+      Tile.Level = NewLevel;
+    }
+
+    Stats.IncrementalUpdates++;
+  }
+
+  /* Tile-parallel evaluation and marching squares */
+  const field_snapshot Snapshot {Charges, Periodic, Boundary};
+
+  {
+    prj::util::threads_pool<std::pair<tile *, bool>> Pool {[&]( std::pair<tile *, bool> *Task ) -> bool
+      {
+        auto &[Tile, IsFull] {*Task};
+
+        if (IsFull)
+          EvalTile(*Tile, Snapshot);
+        else
+          UpdateTile(*Tile, Evaluated[Changed], NewCharges[Changed]);
+
+        ExtractSegments(*Tile);
+        return true;
+      }};
+
+    for (const auto &Elm : Work)
+      Pool.AddTask(Elm);
+
+    Pool.Run();
+    Pool.Wait();
+  }
+
+  Evaluated = std::move(NewCharges);
+
+  Stats.Samples = 0;
+  for (const auto &Tile : Tiles)
+    Stats.Samples += Tile.Phi.size();
+
+  Stitch();
+
+  QueryPerformanceCounter((LARGE_INTEGER *)&End);
+  Stats.LastTime = (End - Start) * 1000.0 / Freq;
+} /* End of 'equipotentials::Update' function */
+
+/* Contours clearing function */
+void equipotentials::Clear( void )
+{
+  Tiles.clear();
+  Evaluated.clear();
+  Lines.clear();
+} /* End of 'equipotentials::Clear' function */
+
+/* END OF 'ef_equipotentials.cpp' FILE */
@@ -0,0 +1,181 @@
+/* FILE NAME   : 'ef_equipotentials.h'
+ * PURPOSE     : Physics module.
+ *               Equipotential contours evaluation class handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#ifndef __ef_equipotentials_h__
+#define __ef_equipotentials_h__
+
+#include "ef_charges.h"
+#include "ef_ewald.h"
+
+/* Project namespace // Physics module */
+namespace prj::phys
+{
+  /* Equipotential contours evaluator.
+   * Potential is sampled on tiles grid with resolution refined near charges,
+   * contours are extracted by tile-parallel marching squares and stitched to polylines.
+   */
+  class equipotentials
+  {
+  public:
+    /* Update statistics structure */
+    struct stats
+    {
+      size_t
+        FullUpdates {0},        /* Updates with all charges reevaluation */
+        IncrementalUpdates {0}, /* Updates with single moved charge delta */
+        Samples {0},            /* Potential samples in last update */
+        Segments {0},           /* Marching squares segments in last update */
+        Polylines {0};          /* Stitched polylines in last update */
+      dbl
+        LastTime {0};           /* Last update time (in ms) */
+    }; /* end of 'stats' structure */
+
+  private:
+    /* Single tile data */
+    struct tile
+    {
+      INT X, Y;                   /* Tile indices */
+      UINT Level;                 /* Refinement level (cells count is 'BaseCells << Level') */
+      std::vector<dbl> Phi;       /* Potential samples ((Cells + 1) x (Cells + 1)) */
+      std::vector<std::pair<size_t, std::pair<coordd, coordd>>> Segments; /* Contour segments by level index */
+    }; /* end of 'tile' structure */
+
+    /* Evaluated charge state */
+    struct charge_state
+    {
+      coordd Coord;
+      dbl Charge, Size;
+      source_shape Shape;
+    }; /* end of 'charge_state' structure */
+
+    /* Tiles count in each direction, base tile cells count and maximal refinement level */
+    static constexpr INT TilesSide {16};
+    static constexpr UINT BaseCells {8}, MaxLevel {3};
+
+    /* Evaluation region */
+    coordd Min {0, 0}, Max {0, 0};
+
+    /* Tiles */
+    std::vector<tile> Tiles {};
+
+    /* Contour potential levels */
+    std::vector<dbl> Levels {};
+
+    /* Charges, periodic cell (zero - isolated charges) and boundary for which tiles are evaluated */
+    std::vector<charge_state> Evaluated {};
+    periodic_cell Lattice {};
+    boundary Boundary {};
+
+    /* Resulting polylines */
+    std::vector<std::vector<coordf>> Lines {};
+
+    /* Statistics */
+    stats Stats {};
+
+    /* Tile sample position evaluation function.
+     * ARGUMENTS:
+     *   - Tile:
+     *       const tile &Tile;
+     *   - Sample indices:
+     *       size_t I, J;
+     * RETURNS:
+     *   (coordd) Position.
+     */
+    coordd SamplePos( const tile &Tile, size_t I, size_t J ) const;
+
+    /* Tile refinement level evaluation function.
+     * ARGUMENTS:
+     *   - Tile indices:
+     *       INT X, Y;
+     *   - Charges:
+     *       const std::vector<charge_state> &Charges;
+     * RETURNS:
+     *   (UINT) Level.
+     */
+    UINT EvalLevel( INT X, INT Y, const std::vector<charge_state> &Charges ) const;
+
+    /* Tile potential full evaluation function.
+     * ARGUMENTS:
+     *   - Tile:
+     *       tile &Tile;
+     *   - Charges snapshot:
+     *       const field_snapshot &Snapshot;
+     */
+    void EvalTile( tile &Tile, const field_snapshot &Snapshot ) const;
+
+    /* Tile potential update for single charge change function (charge images are updated too).
+     * ARGUMENTS:
+     *   - Tile:
+     *       tile &Tile;
+     *   - Old and new charge states:
+     *       const charge_state &Old, &New;
+     */
+    void UpdateTile( tile &Tile, const charge_state &Old, const charge_state &New ) const;
+
+    /* Tile contour segments extraction (marching squares) function.
+     * ARGUMENTS:
+     *   - Tile:
+     *       tile &Tile;
+     */
+    void ExtractSegments( tile &Tile ) const;
+
+    /* Tiles segments stitching to polylines function */
+    void Stitch( void );
+
+  public:
+    /* Contour levels setting function (takes effect on next update).
+     * ARGUMENTS:
+     *   - Potential levels:
+     *       std::vector<dbl> NewLevels;
+     */
+    void SetLevels( std::vector<dbl> NewLevels );
+
+    /* Contours update function.
+     * If only one charge is changed and region is same, potential is updated incrementally
+     * (lattice potential is always evaluated fully).
+     * ARGUMENTS:
+     *   - Charges pool:
+     *       const charge_pool &Charges;
+     *   - Evaluation region corners:
+     *       const coordd &RegionMin, &RegionMax;
+     *   - Periodic lattice evaluator (default: nullptr - charges are isolated):
+     *       const ewald_sum *Periodic;
+     *   - Grounded conductor boundary (default: none):
+     *       const boundary &NewBoundary;
+     */
+    void Update( const charge_pool &Charges, const coordd &RegionMin, const coordd &RegionMax,
+                 const ewald_sum *Periodic = nullptr, const boundary &NewBoundary = {} );
+
+    /* Contours clearing function */
+    void Clear( void );
+
+    /* Resulting polylines getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const std::vector<std::vector<coordf>> &) Polylines.
+     */
+    const std::vector<std::vector<coordf>> &GetLines( void ) const
+    {
+      return Lines;
+    } /* End of 'GetLines' function */
+
+    /* Statistics getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const stats &) Statistics.
+     */
+    const stats &GetStats( void ) const
+    {
+      return Stats;
+    } /* End of 'GetStats' function */
+  }; /* end of 'equipotentials' class */
+} /* end of 'prj::phys' namespace */
+
+#endif /* __ef_equipotentials_h__ */
+
+/* END OF 'ef_equipotentials.h' FILE */
@@ -0,0 +1,631 @@
+/* FILE NAME   : 'ef_ewald.cpp'
+ * PURPOSE     : Physics module.
+ *               Periodic charges lattice field (Ewald summation) implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#include <pch.h>
+
+#include "ef_ewald.h"
+#include "utility/cpu_isa/cpu_isa.h"
+
+using namespace prj::phys;
+
+/* Maximal reciprocal vectors count along each axis (per-point phases are kept on stack) */
+static constexpr INT MaxWaves {64};
+
+/* Horizontal vector sum function.
+ * ARGUMENTS:
+ *   - Vector:
+ *       __m256d V;
+ * RETURNS:
+ *   (dbl) Elements sum.
+ */
+static inline dbl __vectorcall HorizontalSum( __m256d V )
+{
+  const auto Half {_mm_add_pd(_mm256_castpd256_pd128(V), _mm256_extractf128_pd(V, 1))};
+
+  return _mm_cvtsd_f64(_mm_hadd_pd(Half, Half));
+} /* End of 'HorizontalSum' function */
+
+/* Vector exponent function (argument is limited to normal results range).
+ * ARGUMENTS:
+ *   - Argument:
+ *       __m256d X;
+ * RETURNS:
+ *   (__m256d) Exponents.
+ */
+static inline __m256d __vectorcall ExpPd( __m256d X )
+{
+  X = _mm256_max_pd(_mm256_min_pd(X, _mm256_set1_pd(700)), _mm256_set1_pd(-700));
+
+  /* exp(x) = 2^k * exp(r), |r| <= ln2 / 2 */
+  const auto K {_mm256_round_pd(_mm256_mul_pd(X, _mm256_set1_pd(1.4426950408889634)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+  const auto R {_mm256_fnmadd_pd(K, _mm256_set1_pd(1.9082149292705877e-10), _mm256_fnmadd_pd(K, _mm256_set1_pd(0.6931471803691238), X))};
+
+  /* Taylor series up to r^11 / 11! */
+  auto P {_mm256_set1_pd(1 / 39916800.0)};
+
+  for (const dbl C : {1 / 3628800.0, 1 / 362880.0, 1 / 40320.0, 1 / 5040.0, 1 / 720.0, 1 / 120.0, 1 / 24.0, 1 / 6.0, 0.5, 1.0, 1.0})
+    P = _mm256_fmadd_pd(P, R, _mm256_set1_pd(C));
+
+  /* 2^k from exponent bits */
+  const auto Pow2 {_mm256_slli_epi64(_mm256_add_epi64(_mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(K)), _mm256_set1_epi64x(1023)), 52)};
+
+  return _mm256_mul_pd(P, _mm256_castsi256_pd(Pow2));
+} /* End of 'ExpPd' function */
+
+/* Vector complementary error function (non-negative arguments, relative error below 1.2e-7).
+ * ARGUMENTS:
+ *   - Argument:
+ *       __m256d X;
+ *   - Precomputed exp(-x^2):
+ *       __m256d ExpX2;
+ * RETURNS:
+ *   (__m256d) erfc(x).
+ */
+static inline __m256d __vectorcall ErfcPd( __m256d X, __m256d ExpX2 )
+{
+  /* Chebyshev fit: erfc(x) = t * exp(-x^2 + P(t)), t = 1 / (1 + x / 2) */
+  const auto T {_mm256_div_pd(_mm256_set1_pd(1), _mm256_fmadd_pd(X, _mm256_set1_pd(0.5), _mm256_set1_pd(1)))};
+  auto P {_mm256_set1_pd(0.17087277)};
+
+  for (const dbl C : {-0.82215223, 1.48851587, -1.13520398, 0.27886807, -0.18628806, 0.09678418, 0.37409196, 1.00002368, -1.26551223})
+    P = _mm256_fmadd_pd(P, T, _mm256_set1_pd(C));
+
+  return _mm256_mul_pd(_mm256_mul_pd(T, ExpX2), ExpPd(P));
+} /* End of 'ErfcPd' function */
+
+/* Constructor from cell charges.
+ * ARGUMENTS:
+ *   - Charges pool (one cell content):
+ *       const charge_pool &Charges;
+ *   - Periodic cell:
+ *       const periodic_cell &NewCell;
+ */
+ewald_sum::ewald_sum( const charge_pool &Charges, const periodic_cell &NewCell ) : Cell {NewCell}
+{
+  const dbl Area {Cell.W * Cell.H};
+
+  /* Extended sources are discretized into point charges (lattice sum has no analytic elements) */
+  std::vector<std::pair<coordd, dbl>> Points {};
+
+  for (const auto &Elm : Charges)
+    SourcePoints(Elm, SourceSamples, Points);
+
+  const size_t Count {std::max<size_t>(Points.size(), 1)};
+
+  /* Short range terms are about 4 times more expensive than long range ones, alpha balances their counts */
+  Alpha = pow(8 * M_PI * M_PI * Count, 0.25) / sqrt(Area);
+
+  /* Reciprocal vectors up to erfc(k / 2alpha) = erfc(Accuracy) must fit per-point phases storage,
+   * otherwise alpha is decreased (real space cutoff is increased), so accuracy is kept at higher short range cost */
+  KX0 = 2 * M_PI / Cell.W, KY0 = 2 * M_PI / Cell.H;
+
+  const dbl AlphaLimit {std::min(KX0 * (MaxWaves - 1), KY0 * (MaxWaves / 2 - 1)) / (2 * Accuracy)};
+
+  if (Alpha > AlphaLimit)
+    Alpha = AlphaLimit, IsAlphaLimited = true;
+  Cutoff = Accuracy / Alpha;
+
+  /* Charges are wrapped into cell */
+  const size_t Padded {(Points.size() + 3) / 4 * 4};
+  dbl Total {0};
+
+  X.reserve(Padded), Y.reserve(Padded), Q.reserve(Padded);
+  for (const auto &[C, PQ] : Points)
+  {
+    X.push_back(C.X - Cell.W * floor(C.X / Cell.W));
+    Y.push_back(C.Y - Cell.H * floor(C.Y / Cell.H));
+    Q.push_back(PQ);
+    Total += PQ;
+  }
+  X.resize(Padded, 1e30), Y.resize(Padded, 1e30), Q.resize(Padded, 0);
+
+  /* Only potential depends on k = 0 term (in plane field of uniformly charged plane is zero) */
+  PhiConst = -2 * sqrt(M_PI) / (Area * Alpha) * Total;
+
+  /* Reciprocal vectors up to erfc(k / 2alpha) = erfc(Accuracy) (limits only cut rounding excess) */
+  const dbl KMax {2 * Alpha * Accuracy};
+
+  MaxX = std::min((INT)ceil(KMax / KX0), MaxWaves - 1);
+  MaxY = std::min((INT)ceil(KMax / KY0), MaxWaves / 2 - 1);
+  RowSize = ((size_t)MaxY * 2 + 1 + 3) / 4 * 4;
+
+  const size_t Size {(size_t)(MaxX + 1) * RowSize};
+
+  KX.assign(Size, 0), KY.assign(Size, 0), CRe.assign(Size, 0), CIm.assign(Size, 0);
+
+  for (INT mx = 0; mx <= MaxX; mx++)
+    for (INT my = -MaxY; my <= MaxY; my++)
+    {
+      /* Opposite vectors give conjugate terms, so only half space is summed (with doubled coefficients) */
+      if (mx == 0 && my <= 0)
+        continue;
+
+      const size_t I {(size_t)mx * RowSize + (size_t)(my + MaxY)};
+      const dbl
+        Kx {mx * KX0},
+        Ky {my * KY0},
+        K {hypot(Kx, Ky)},
+        Coeff {4 * M_PI / Area * erfc(K / (2 * Alpha)) / K};
+      dbl SRe {0}, SIm {0};
+
+      /* Structure factor S(k) = sum(q * exp(-i * k * r)) */
+      for (size_t i = 0; i < Points.size(); i++)
+      {
+        const dbl Phase {Kx * X[i] + Ky * Y[i]};
+
+        SRe += Q[i] * cos(Phase);
+        SIm -= Q[i] * sin(Phase);
+      }
+
+      KX[I] = Kx, KY[I] = Ky;
+      CRe[I] = Coeff * SRe, CIm[I] = Coeff * SIm;
+    }
+} /* End of 'ewald_sum::ewald_sum' function */
+
+/* Point with cell images short and long range parts evaluation kernel.
+ * ARGUMENTS:
+ *   - Point:
+ *       const coordd &Pos;
+ *   - Values (out, Ex, Ey, Dxx, Dxy, Dyy, Phi - only requested are set):
+ *       dbl *Res;
+ */
+template<bool IsField, bool IsGradient, bool IsPotential>
+  void ewald_sum::EvalKernel( const coordd &Pos, dbl *Res ) const
+  {
+    /* Point is wrapped into cell, so few images are inside cutoff */
+    const dbl
+      PX {Pos.X - Cell.W * floor(Pos.X / Cell.W)},
+      PY {Pos.Y - Cell.H * floor(Pos.Y / Cell.H)};
+    const auto
+      One {_mm256_set1_pd(1)},
+      Three {_mm256_set1_pd(3)},
+      AlphaV {_mm256_set1_pd(Alpha)},
+      GaussCoeff {_mm256_set1_pd(2 / sqrt(M_PI))},
+      GradCoeff {_mm256_set1_pd(4 * Alpha * Alpha * Alpha / sqrt(M_PI))};
+    auto Ex {_mm256_setzero_pd()}, Ey {Ex}, Dxx {Ex}, Dxy {Ex}, Dyy {Ex}, Phi {Ex};
+
+    /* Short range part: erfc-screened charges (field factor g = erfc(ar) + 2ar / sqrt(pi) * exp(-a^2r^2)) */
+    const INT
+      SX0 {(INT)ceil((PX - Cutoff) / Cell.W) - 1}, SX1 {(INT)floor((PX + Cutoff) / Cell.W)},
+      SY0 {(INT)ceil((PY - Cutoff) / Cell.H) - 1}, SY1 {(INT)floor((PY + Cutoff) / Cell.H)};
+
+    for (INT sy = SY0; sy <= SY1; sy++)
+      for (INT sx = SX0; sx <= SX1; sx++)
+      {
+        const auto OX {_mm256_set1_pd(PX - sx * Cell.W)}, OY {_mm256_set1_pd(PY - sy * Cell.H)};
+
+        for (size_t i = 0; i < Q.size(); i += 4)
+        {
+          const auto
+            DX {_mm256_sub_pd(OX, _mm256_loadu_pd(&X[i]))},
+            DY {_mm256_sub_pd(OY, _mm256_loadu_pd(&Y[i]))},
+            QV {_mm256_loadu_pd(&Q[i])},
+            R2 {_mm256_fmadd_pd(DX, DX, _mm256_mul_pd(DY, DY))},
+            RevR {_mm256_div_pd(One, _mm256_sqrt_pd(R2))},
+            RevR2 {_mm256_mul_pd(RevR, RevR)},
+            AR {_mm256_mul_pd(AlphaV, _mm256_mul_pd(R2, RevR))},
+            Gauss {ExpPd(_mm256_sub_pd(_mm256_setzero_pd(), _mm256_mul_pd(AR, AR)))},
+            Erfc {ErfcPd(AR, Gauss)};
+
+          if constexpr (IsField || IsGradient)
+          {
+            const auto F {_mm256_mul_pd(_mm256_mul_pd(QV, _mm256_fmadd_pd(_mm256_mul_pd(GaussCoeff, AR), Gauss, Erfc)),
+                                        _mm256_mul_pd(RevR2, RevR))};
+
+            if constexpr (IsField)
+            {
+              Ex = _mm256_fmadd_pd(F, DX, Ex);
+              Ey = _mm256_fmadd_pd(F, DY, Ey);
+            }
+
+            if constexpr (IsGradient)
+            {
+              const auto H {_mm256_mul_pd(_mm256_fmadd_pd(Three, F, _mm256_mul_pd(_mm256_mul_pd(QV, GradCoeff), Gauss)), RevR2)};
+
+              Dxx = _mm256_add_pd(Dxx, _mm256_fnmadd_pd(_mm256_mul_pd(H, DX), DX, F));
+              Dxy = _mm256_fnmadd_pd(_mm256_mul_pd(H, DX), DY, Dxy);
+              Dyy = _mm256_add_pd(Dyy, _mm256_fnmadd_pd(_mm256_mul_pd(H, DY), DY, F));
+            }
+          }
+
+          if constexpr (IsPotential)
+            Phi = _mm256_fmadd_pd(_mm256_mul_pd(QV, Erfc), RevR, Phi);
+        }
+      }
+
+    /* Long range part: waves exp(i * k * r) are built from per-axis phase powers */
+    alignas(32) dbl WXRe[MaxWaves], WXIm[MaxWaves], WYRe[MaxWaves], WYIm[MaxWaves];
+    const dbl
+      BXRe {cos(KX0 * PX)}, BXIm {sin(KX0 * PX)},
+      BYRe {cos(KY0 * PY)}, BYIm {sin(KY0 * PY)};
+
+    WXRe[0] = 1, WXIm[0] = 0;
+    for (INT m = 1; m <= MaxX; m++)
+      WXRe[m] = WXRe[m - 1] * BXRe - WXIm[m - 1] * BXIm, WXIm[m] = WXRe[m - 1] * BXIm + WXIm[m - 1] * BXRe;
+
+    WYRe[MaxY] = 1, WYIm[MaxY] = 0;
+    for (INT m = 1; m <= MaxY; m++)
+    {
+      WYRe[MaxY + m] = WYRe[MaxY + m - 1] * BYRe - WYIm[MaxY + m - 1] * BYIm;
+      WYIm[MaxY + m] = WYRe[MaxY + m - 1] * BYIm + WYIm[MaxY + m - 1] * BYRe;
+      WYRe[MaxY - m] = WYRe[MaxY + m], WYIm[MaxY - m] = -WYIm[MaxY + m];
+    }
+    for (size_t j = (size_t)MaxY * 2 + 1; j < RowSize; j++)
+      WYRe[j] = WYIm[j] = 0;
+
+    for (INT mx = 0; mx <= MaxX; mx++)
+    {
+      const auto PRe {_mm256_set1_pd(WXRe[mx])}, PIm {_mm256_set1_pd(WXIm[mx])};
+      const size_t Row {(size_t)mx * RowSize};
+
+      for (size_t j = 0; j < RowSize; j += 4)
+      {
+        const auto
+          YRe {_mm256_load_pd(WYRe + j)},
+          YIm {_mm256_load_pd(WYIm + j)},
+          ZRe {_mm256_fmsub_pd(PRe, YRe, _mm256_mul_pd(PIm, YIm))},
+          ZIm {_mm256_fmadd_pd(PRe, YIm, _mm256_mul_pd(PIm, YRe))},
+          CR {_mm256_loadu_pd(&CRe[Row + j])},
+          CI {_mm256_loadu_pd(&CIm[Row + j])},
+          Re {_mm256_fmsub_pd(ZRe, CR, _mm256_mul_pd(ZIm, CI))};
+
+        /* E = sum(k * Im(exp(ikr) * C)), dE/dr = sum(k * k * Re(exp(ikr) * C)), phi = sum(Re(exp(ikr) * C)) */
+        if constexpr (IsField)
+        {
+          const auto Im {_mm256_fmadd_pd(ZRe, CI, _mm256_mul_pd(ZIm, CR))};
+
+          Ex = _mm256_fmadd_pd(_mm256_loadu_pd(&KX[Row + j]), Im, Ex);
+          Ey = _mm256_fmadd_pd(_mm256_loadu_pd(&KY[Row + j]), Im, Ey);
+        }
+
+        if constexpr (IsGradient)
+        {
+          const auto Kx {_mm256_loadu_pd(&KX[Row + j])}, Ky {_mm256_loadu_pd(&KY[Row + j])};
+
+          Dxx = _mm256_fmadd_pd(_mm256_mul_pd(Kx, Kx), Re, Dxx);
+          Dxy = _mm256_fmadd_pd(_mm256_mul_pd(Kx, Ky), Re, Dxy);
+          Dyy = _mm256_fmadd_pd(_mm256_mul_pd(Ky, Ky), Re, Dyy);
+        }
+
+        if constexpr (IsPotential)
+          Phi = _mm256_add_pd(Phi, Re);
+      }
+    }
+
+    if constexpr (IsField)
+      Res[0] = HorizontalSum(Ex), Res[1] = HorizontalSum(Ey);
+
+    if constexpr (IsGradient)
+      Res[2] = HorizontalSum(Dxx), Res[3] = HorizontalSum(Dxy), Res[4] = HorizontalSum(Dyy);
+
+    if constexpr (IsPotential)
+      Res[5] = HorizontalSum(Phi) + PhiConst;
+  } /* End of 'ewald_sum::EvalKernel' function */
+
+/* Point with cell images short and long range parts scalar evaluation kernel (for processors below AVX2).
+ * ARGUMENTS:
+ *   - Point:
+ *       const coordd &Pos;
+ *   - Values (out, Ex, Ey, Dxx, Dxy, Dyy, Phi - only requested are set):
+ *       dbl *Res;
+ */
+template<bool IsField, bool IsGradient, bool IsPotential>
+  void ewald_sum::EvalScalarKernel( const coordd &Pos, dbl *Res ) const
+  {
+    const dbl
+      PX {Pos.X - Cell.W * floor(Pos.X / Cell.W)},
+      PY {Pos.Y - Cell.H * floor(Pos.Y / Cell.H)},
+      GaussCoeff {2 / sqrt(M_PI)},
+      GradCoeff {4 * Alpha * Alpha * Alpha / sqrt(M_PI)};
+    dbl Ex {0}, Ey {0}, Dxx {0}, Dxy {0}, Dyy {0}, Phi {0};
+
+    /* Short range part (same images range as vectorized kernel, padding charges are skipped) */
+    const INT
+      SX0 {(INT)ceil((PX - Cutoff) / Cell.W) - 1}, SX1 {(INT)floor((PX + Cutoff) / Cell.W)},
+      SY0 {(INT)ceil((PY - Cutoff) / Cell.H) - 1}, SY1 {(INT)floor((PY + Cutoff) / Cell.H)};
+
+    for (INT sy = SY0; sy <= SY1; sy++)
+      for (INT sx = SX0; sx <= SX1; sx++)
+        for (size_t i = 0; i < Q.size(); i++)
+        {
+          if (Q[i] == 0)
+            continue;
+
+          const dbl
+            DX {PX - sx * Cell.W - X[i]},
+            DY {PY - sy * Cell.H - Y[i]},
+            R2 {DX * DX + DY * DY},
+            RevR {1 / sqrt(R2)},
+            RevR2 {RevR * RevR},
+            AR {Alpha * R2 * RevR},
+            Gauss {exp(-AR * AR)},
+            Erfc {erfc(AR)};
+
+          if constexpr (IsField || IsGradient)
+          {
+            const dbl F {Q[i] * (GaussCoeff * AR * Gauss + Erfc) * RevR2 * RevR};
+
+            if constexpr (IsField)
+              Ex += F * DX, Ey += F * DY;
+
+            if constexpr (IsGradient)
+            {
+              const dbl H {(3 * F + Q[i] * GradCoeff * Gauss) * RevR2};
+
+              Dxx += F - H * DX * DX;
+              Dxy -= H * DX * DY;
+              Dyy += F - H * DY * DY;
+            }
+          }
+
+          if constexpr (IsPotential)
+            Phi += Q[i] * Erfc * RevR;
+        }
+
+    /* Long range part: wave phases are advanced by per-axis phase steps */
+    const dbl
+      BXRe {cos(KX0 * PX)}, BXIm {sin(KX0 * PX)},
+      BYRe {cos(KY0 * PY)}, BYIm {sin(KY0 * PY)};
+    dbl XRe {1}, XIm {0};
+
+    for (INT mx = 0; mx <= MaxX; mx++)
+    {
+      const size_t Row {(size_t)mx * RowSize};
+
+      /* Row starts from my = -MaxY wave (conjugate of MaxY power) */
+      dbl YRe {1}, YIm {0};
+
+      for (INT m = 0; m < MaxY; m++)
+      {
+        const dbl Re {YRe * BYRe - YIm * BYIm};
+
+        YIm = YRe * BYIm + YIm * BYRe, YRe = Re;
+      }
+      YIm = -YIm;
+
+      for (INT my = -MaxY; my <= MaxY; my++)
+      {
+        const size_t I {Row + (size_t)(my + MaxY)};
+        const dbl
+          ZRe {XRe * YRe - XIm * YIm},
+          ZIm {XRe * YIm + XIm * YRe},
+          Re {ZRe * CRe[I] - ZIm * CIm[I]};
+
+        if constexpr (IsField)
+        {
+          const dbl Im {ZRe * CIm[I] + ZIm * CRe[I]};
+
+          Ex += KX[I] * Im, Ey += KY[I] * Im;
+        }
+
+        if constexpr (IsGradient)
+          Dxx += KX[I] * KX[I] * Re, Dxy += KX[I] * KY[I] * Re, Dyy += KY[I] * KY[I] * Re;
+
+        if constexpr (IsPotential)
+          Phi += Re;
+
+        const dbl NextRe {YRe * BYRe - YIm * BYIm};
+
+        YIm = YRe * BYIm + YIm * BYRe, YRe = NextRe;
+      }
+
+      const dbl NextRe {XRe * BXRe - XIm * BXIm};
+
+      XIm = XRe * BXIm + XIm * BXRe, XRe = NextRe;
+    }
+
+    if constexpr (IsField)
+      Res[0] = Ex, Res[1] = Ey;
+
+    if constexpr (IsGradient)
+      Res[2] = Dxx, Res[3] = Dxy, Res[4] = Dyy;
+
+    if constexpr (IsPotential)
+      Res[5] = Phi + PhiConst;
+  } /* End of 'ewald_sum::EvalScalarKernel' function */
+
+/* Field values for points array evaluation function.
+ * ARGUMENTS:
+ *   - Query points:
+ *       const coordd *Points;
+ *   - Query points count:
+ *       size_t Count;
+ *   - Outputs:
+ *       const field_out &Out;
+ */
+void ewald_sum::EvalField( const coordd *Points, size_t Count, const field_out &Out ) const
+{
+  /* Kernel is selected by requested outputs and instruction set level (vectorized kernel requires AVX2) */
+  static void (ewald_sum::* const Kernels[2][8])( const coordd &, dbl * ) const
+  {
+    {
+      &ewald_sum::EvalScalarKernel<false, false, false>, &ewald_sum::EvalScalarKernel<true, false, false>,
+      &ewald_sum::EvalScalarKernel<false, true, false>, &ewald_sum::EvalScalarKernel<true, true, false>,
+      &ewald_sum::EvalScalarKernel<false, false, true>, &ewald_sum::EvalScalarKernel<true, false, true>,
+      &ewald_sum::EvalScalarKernel<false, true, true>, &ewald_sum::EvalScalarKernel<true, true, true>,
+    },
+    {
+      &ewald_sum::EvalKernel<false, false, false>, &ewald_sum::EvalKernel<true, false, false>,
+      &ewald_sum::EvalKernel<false, true, false>, &ewald_sum::EvalKernel<true, true, false>,
+      &ewald_sum::EvalKernel<false, false, true>, &ewald_sum::EvalKernel<true, false, true>,
+      &ewald_sum::EvalKernel<false, true, true>, &ewald_sum::EvalKernel<true, true, true>,
+    },
+  };
+
+  const bool
+    IsField {Out.Ex != nullptr && Out.Ey != nullptr},
+    IsGradient {Out.Dxx != nullptr && Out.Dxy != nullptr && Out.Dyy != nullptr},
+    IsPotential {Out.Phi != nullptr};
+  const size_t Index {(size_t)IsField | (size_t)IsGradient << 1 | (size_t)IsPotential << 2};
+
+  if (Index == 0)
+    return;
+
+  const auto Kernel {Kernels[prj::util::GetIsa() >= prj::util::isa::Avx2][Index]};
+
+  for (size_t p = 0; p < Count; p++)
+  {
+    dbl Res[6];
+
+    (this->*Kernel)(Points[p], Res);
+
+    if (IsField)
+      Out.Ex[p] = Res[0], Out.Ey[p] = Res[1];
+    if (IsGradient)
+      Out.Dxx[p] = Res[2], Out.Dxy[p] = Res[3], Out.Dyy[p] = Res[4];
+    if (IsPotential)
+      Out.Phi[p] = Res[5];
+  }
+} /* End of 'ewald_sum::EvalField' function */
+
+/* Single point field vector evaluation function.
+ * ARGUMENTS:
+ *   - Query point:
+ *       const coordd &Pos;
+ * RETURNS:
+ *   (coordd) Field vector.
+ */
+coordd ewald_sum::EvalField( const coordd &Pos ) const
+{
+  dbl Res[6];
+
+  if (prj::util::GetIsa() >= prj::util::isa::Avx2)
+    EvalKernel<true, false, false>(Pos, Res);
+  else
+    EvalScalarKernel<true, false, false>(Pos, Res);
+  return {Res[0], Res[1]};
+} /* End of 'ewald_sum::EvalField' function */
+
+/* Terms per evaluation getting function.
+ * ARGUMENTS:
+ *   - Short range (charge images inside cutoff) and long range (reciprocal vectors) terms count (out):
+ *       size_t &RealTerms, &ReciprocalTerms;
+ */
+void ewald_sum::GetTerms( size_t &RealTerms, size_t &ReciprocalTerms ) const
+{
+  /* Images shifts range for point in cell middle */
+  const size_t
+    ShiftsX {(size_t)(floor((Cell.W * 0.5 + Cutoff) / Cell.W) - ceil((Cell.W * 0.5 - Cutoff) / Cell.W) + 2)},
+    ShiftsY {(size_t)(floor((Cell.H * 0.5 + Cutoff) / Cell.H) - ceil((Cell.H * 0.5 - Cutoff) / Cell.H) + 2)};
+
+  RealTerms = ShiftsX * ShiftsY * Q.size();
+  ReciprocalTerms = (size_t)(MaxX + 1) * RowSize;
+} /* End of 'ewald_sum::GetTerms' function */
+
+/* Ewald summation versus explicit images sum benchmark function.
+ * ARGUMENTS:
+ *   - Charges pool (one cell content):
+ *       const charge_pool &Charges;
+ *   - Periodic cell:
+ *       const periodic_cell &Cell;
+ *   - Query points count:
+ *       size_t Count;
+ * RETURNS:
+ *   (std::string) Report.
+ */
+std::string prj::phys::BenchmarkEwald( const charge_pool &Charges, const periodic_cell &Cell, size_t Count )
+{
+  /* Explicit sums cell images rings */
+  constexpr INT NearRings {10}, FarRings {40};
+
+  if (Charges.IsEmpty() || !Cell.IsValid() || Count == 0)
+    return "Ewald benchmark: no charges or cell\n";
+
+  UINT64 Freq, Start, End;
+
+  QueryPerformanceFrequency((LARGE_INTEGER *)&Freq);
+
+  /* Query points on grid over cell (points near charges are skipped) */
+  const size_t Side {(size_t)ceil(sqrt((dbl)Count))};
+  std::vector<coordd> Points {};
+
+  for (size_t y = 0; y < Side; y++)
+    for (size_t x = 0; x < Side; x++)
+    {
+      const coordd P {Cell.W * (x + 0.5) / Side, Cell.H * (y + 0.5) / Side};
+      bool IsNear {false};
+
+      for (const auto &Elm : Charges)
+      {
+        dbl DX {P.X - Elm.Coord.X}, DY {P.Y - Elm.Coord.Y};
+
+        DX -= Cell.W * round(DX / Cell.W), DY -= Cell.H * round(DY / Cell.H);
+        IsNear |= SourceDistance(Elm, {Elm.Coord.X + DX, Elm.Coord.Y + DY}) < Elm.Size * 2;
+      }
+
+      if (!IsNear)
+        Points.push_back(P);
+    }
+
+  /* Ewald sum */
+  QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+  const ewald_sum Sum {Charges, Cell};
+  std::vector<dbl> EX(Points.size()), EY(Points.size());
+
+  Sum.EvalField(Points.data(), Points.size(), {EX.data(), EY.data()});
+  QueryPerformanceCounter((LARGE_INTEGER *)&End);
+
+  const dbl EwaldTime {(End - Start) * 1000.0 / Freq};
+
+  /* Explicit sum over pasted cell copies */
+  auto Explicit = [&]( INT Rings, std::vector<dbl> &OutX, std::vector<dbl> &OutY ) -> dbl
+    {
+      charge_pool Copies {};
+
+      for (INT sy = -Rings; sy <= Rings; sy++)
+        for (INT sx = -Rings; sx <= Rings; sx++)
+          for (const auto &Elm : Charges)
+            Copies.Add({{Elm.Coord.X + sx * Cell.W, Elm.Coord.Y + sy * Cell.H}, Elm.Charge, Elm.Size, Elm.Shape});
+
+      UINT64 From, To;
+
+      QueryPerformanceCounter((LARGE_INTEGER *)&From);
+      const field_snapshot Snapshot {Copies};
+
+      OutX.resize(Points.size()), OutY.resize(Points.size());
+      prj::phys::EvalField(Snapshot, Points.data(), Points.size(), {OutX.data(), OutY.data()});
+      QueryPerformanceCounter((LARGE_INTEGER *)&To);
+
+      return (To - From) * 1000.0 / Freq;
+    };
+
+  std::vector<dbl> NearX, NearY, FarX, FarY;
+  const dbl
+    NearTime {Explicit(NearRings, NearX, NearY)},
+    FarTime {Explicit(FarRings, FarX, FarY)};
+
+  /* Explicit sums truncation errors (Ewald sum is infinite lattice limit) relative to mean field length */
+  dbl Mean {0}, NearError {0}, FarError {0};
+
+  for (size_t i = 0; i < Points.size(); i++)
+    Mean += hypot(EX[i], EY[i]) / Points.size();
+  for (size_t i = 0; i < Points.size(); i++)
+  {
+    NearError = std::max(NearError, hypot(NearX[i] - EX[i], NearY[i] - EY[i]) / Mean);
+    FarError = std::max(FarError, hypot(FarX[i] - EX[i], FarY[i] - EY[i]) / Mean);
+  }
+
+  size_t RealTerms, ReciprocalTerms;
+  CHAR Buf[0x300];
+
+  Sum.GetTerms(RealTerms, ReciprocalTerms);
+  sprintf(Buf,
+          "Periodic field (%zu charges in %.2f x %.2f cell, %zu points):\n"
+          "  - Ewald sum: %.3f ms, %zu short range + %zu long range terms per point%s\n"
+          "  - Explicit %d x %d copies: %.3f ms, max error %.2e (in mean field)\n"
+          "  - Explicit %d x %d copies: %.3f ms, max error %.2e\n",
+          Charges.Size(), Cell.W, Cell.H, Points.size(),
+          EwaldTime, RealTerms, ReciprocalTerms,
+          Sum.IsReciprocalLimited() ? " (reciprocal vectors limit reached, real space cutoff is increased)" : "",
+          NearRings * 2 + 1, NearRings * 2 + 1, NearTime, NearError,
+          FarRings * 2 + 1, FarRings * 2 + 1, FarTime, FarError);
+
+  return Buf;
+} /* End of 'prj::phys::BenchmarkEwald' function */
+
+/* END OF 'ef_ewald.cpp' FILE */
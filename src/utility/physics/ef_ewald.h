@@ -0,0 +1,174 @@
+/* FILE NAME   : 'ef_ewald.h'
+ * PURPOSE     : Physics module.
+ *               Periodic charges lattice field (Ewald summation) handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#ifndef __ef_ewald_h__
+#define __ef_ewald_h__
+
+#include "ef_field.h"
+
+/* Project namespace // Physics module */
+namespace prj::phys
+{
+  /* Rectangular periodic cell (scene charges are repeated with cell size periods) */
+  struct periodic_cell
+  {
+    dbl W {0}, H {0}; /* Cell size */
+
+    /* Cell validity check function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (bool) true if cell has positive size.
+     */
+    bool IsValid( void ) const
+    {
+      return W > 0 && H > 0;
+    } /* End of 'IsValid' function */
+  }; /* end of 'periodic_cell' structure */
+
+  /* Charges lattice (charges in plane, periodic along both axes) field evaluator.
+   * Field is split with Ewald parameter alpha into short range part (erfc-screened charges, summed over
+   * cell images inside cutoff) and long range part (sum over reciprocal lattice vectors with structure
+   * factors precomputed for all charges), so evaluation cost is independent from images count.
+   */
+  class ewald_sum
+  {
+  private:
+    /* Cell and its reciprocal lattice periods */
+    periodic_cell Cell {};
+    dbl KX0 {0}, KY0 {0};
+
+    /* Splitting parameter, real space cutoff and k = 0 potential term */
+    dbl Alpha {1}, Cutoff {1}, PhiConst {0};
+
+    /* Splitting parameter was decreased to fit reciprocal vectors limit flag */
+    bool IsAlphaLimited {false};
+
+    /* Charges wrapped into cell (padded to SIMD width with zero charges far away) */
+    std::vector<dbl> X {}, Y {}, Q {};
+
+    /* Reciprocal vectors half space (mx = 0..MaxX, my = -MaxY..MaxY, rows are padded to SIMD width):
+     * vectors and coefficients 4pi / A * erfc(k / 2alpha) / k * S(k) for structure factors S(k) */
+    INT MaxX {0}, MaxY {0};
+    size_t RowSize {0};
+    std::vector<dbl> KX {}, KY {}, CRe {}, CIm {};
+
+    /* Point with cell images short and long range parts evaluation kernel.
+     * ARGUMENTS:
+     *   - Point:
+     *       const coordd &Pos;
+     *   - Values (out, Ex, Ey, Dxx, Dxy, Dyy, Phi - only requested are set):
+     *       dbl *Res;
+     */
+    template<bool IsField, bool IsGradient, bool IsPotential>
+      void EvalKernel( const coordd &Pos, dbl *Res ) const;
+
+    /* Point with cell images short and long range parts scalar evaluation kernel (for processors below AVX2).
+     * ARGUMENTS:
+     *   - Point:
+     *       const coordd &Pos;
+     *   - Values (out, Ex, Ey, Dxx, Dxy, Dyy, Phi - only requested are set):
+     *       dbl *Res;
+     */
+    template<bool IsField, bool IsGradient, bool IsPotential>
+      void EvalScalarKernel( const coordd &Pos, dbl *Res ) const;
+
+  public:
+    /* Sum accuracy (erfc argument at cutoffs) */
+    static constexpr dbl Accuracy {4};
+
+    /* Point charges per extended source */
+    static constexpr size_t SourceSamples {64};
+
+    /* Default constructor */
+    ewald_sum( void ) = default;
+
+    /* Constructor from cell charges.
+     * ARGUMENTS:
+     *   - Charges pool (one cell content):
+     *       const charge_pool &Charges;
+     *   - Periodic cell:
+     *       const periodic_cell &NewCell;
+     */
+    ewald_sum( const charge_pool &Charges, const periodic_cell &NewCell );
+
+    /* Field values for points array evaluation function.
+     * ARGUMENTS:
+     *   - Query points:
+     *       const coordd *Points;
+     *   - Query points count:
+     *       size_t Count;
+     *   - Outputs:
+     *       const field_out &Out;
+     */
+    void EvalField( const coordd *Points, size_t Count, const field_out &Out ) const;
+
+    /* Single point field vector evaluation function.
+     * ARGUMENTS:
+     *   - Query point:
+     *       const coordd &Pos;
+     * RETURNS:
+     *   (coordd) Field vector.
+     */
+    coordd EvalField( const coordd &Pos ) const;
+
+    /* Nearest image offset evaluation function.
+     * ARGUMENTS:
+     *   - Offset between points:
+     *       dbl &DX, &DY;
+     */
+    void Wrap( dbl &DX, dbl &DY ) const
+    {
+      DX -= Cell.W * round(DX / Cell.W);
+      DY -= Cell.H * round(DY / Cell.H);
+    } /* End of 'Wrap' function */
+
+    /* Periodic cell getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const periodic_cell &) Cell.
+     */
+    const periodic_cell &GetCell( void ) const
+    {
+      return Cell;
+    } /* End of 'GetCell' function */
+
+    /* Terms per evaluation getting function.
+     * ARGUMENTS:
+     *   - Short range (charge images inside cutoff) and long range (reciprocal vectors) terms count (out):
+     *       size_t &RealTerms, &ReciprocalTerms;
+     */
+    void GetTerms( size_t &RealTerms, size_t &ReciprocalTerms ) const;
+
+    /* Reciprocal vectors limit reaching check function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (bool) true if splitting parameter was decreased (real space cutoff increased) to keep accuracy.
+     */
+    bool IsReciprocalLimited( void ) const
+    {
+      return IsAlphaLimited;
+    } /* End of 'IsReciprocalLimited' function */
+  }; /* end of 'ewald_sum' class */
+
+  /* Ewald summation versus explicit images sum benchmark function.
+   * ARGUMENTS:
+   *   - Charges pool (one cell content):
+   *       const charge_pool &Charges;
+   *   - Periodic cell:
+   *       const periodic_cell &Cell;
+   *   - Query points count:
+   *       size_t Count;
+   * RETURNS:
+   *   (std::string) Report.
+   */
+  std::string BenchmarkEwald( const charge_pool &Charges, const periodic_cell &Cell, size_t Count );
+} /* end of 'prj::phys' namespace */
+
+#endif /* __ef_ewald_h__ */
+
+/* END OF 'ef_ewald.h' FILE */
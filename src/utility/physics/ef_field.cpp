@@ -0,0 +1,1118 @@
+/* FILE NAME   : 'ef_field.cpp'
+ * PURPOSE     : Physics module.
+ *               Electric field, its gradient and potential evaluation implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#include <pch.h>
+
+#include "ef_field.h"
+#include "ef_ewald.h"
+#include "ef_kernels.h"
+#include "utility/cpu_isa/cpu_isa.h"
+#include "utility/threads_pool/threads_pool.hpp"
+
+using namespace prj::phys;
+
+/* Constructor from charges pool.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Periodic lattice evaluator (default: nullptr - charges are isolated):
+ *       const ewald_sum *NewPeriodic;
+ *   - Grounded conductor boundary (default: none):
+ *       const boundary &NewBoundary;
+ */
+field_snapshot::field_snapshot( const charge_pool &Charges, const ewald_sum *NewPeriodic, const boundary &NewBoundary ) :
+  Periodic {NewPeriodic}, Boundary {NewBoundary}
+{
+  /* Zero elements far away give exact zero input without division by zero */
+  auto Pad = []( std::vector<dbl> &Values, dbl Value )
+    {
+      Values.resize((Values.size() + Width - 1) / Width * Width, Value);
+    };
+
+  /* Pool point charges mirror is copied as is without extended sources (its zero charges are dropped otherwise) */
+  const size_t Size {Charges.Size()};
+  const dbl *PoolX {Charges.GetX()}, *PoolY {Charges.GetY()}, *PoolQ {Charges.GetQ()};
+
+  X.reserve(Size + Width), Y.reserve(Size + Width), Q.reserve(Size + Width);
+  if (Charges.GetPointsCount() == Size)
+    X.assign(PoolX, PoolX + Size), Y.assign(PoolY, PoolY + Size), Q.assign(PoolQ, PoolQ + Size);
+  else
+    for (size_t i = 0; i < Size; i++)
+      if (!IsExtended(Charges[i]))
+      {
+        X.push_back(PoolX[i]);
+        Y.push_back(PoolY[i]);
+        Q.push_back(PoolQ[i]);
+      }
+
+  Count = Q.size();
+  Pad(X, 1e30), Pad(Y, 1e30), Pad(Q, 0);
+
+  /* Extended sources elements (lattice evaluator has its own sources samples) */
+  if (Periodic != nullptr || Count == Charges.Size())
+    return;
+
+  Elements = source_elements {Charges, Boundary};
+
+  for (const auto &Seg : Elements.Segments)
+  {
+    SegX.push_back(Seg.Center.X), SegY.push_back(Seg.Center.Y);
+    SegUX.push_back(Seg.Dir.X), SegUY.push_back(Seg.Dir.Y);
+    SegL.push_back(Seg.HalfLength), SegQ.push_back(Seg.Density);
+  }
+  Pad(SegX, 1e30), Pad(SegY, 1e30), Pad(SegUX, 1), Pad(SegUY, 0), Pad(SegL, 1), Pad(SegQ, 0);
+
+  for (const auto &Disk : Elements.Disks)
+  {
+    DiskX.push_back(Disk.Center.X), DiskY.push_back(Disk.Center.Y);
+    DiskR.push_back(Disk.Radius), DiskQ.push_back(Disk.Density);
+  }
+  Pad(DiskX, 1e30), Pad(DiskY, 1e30), Pad(DiskR, 1), Pad(DiskQ, 0);
+
+  for (const auto &Mul : Elements.Multipoles)
+  {
+    MulX.push_back(Mul.Center.X), MulY.push_back(Mul.Center.Y);
+    MulUX.push_back(Mul.Dir.X), MulUY.push_back(Mul.Dir.Y);
+    MulP.push_back(Mul.Dipole), MulQ.push_back(Mul.Quadrupole);
+  }
+  Pad(MulX, 1e30), Pad(MulY, 1e30), Pad(MulUX, 1), Pad(MulUY, 0), Pad(MulP, 0), Pad(MulQ, 0);
+
+  for (const auto &[C, FQ] : Elements.Points)
+    FixedX.push_back(C.X), FixedY.push_back(C.Y), FixedQ.push_back(FQ);
+  Pad(FixedX, 1e30), Pad(FixedY, 1e30), Pad(FixedQ, 0);
+} /* End of 'field_snapshot::field_snapshot' function */
+
+/* Horizontal vector sum function.
+ * ARGUMENTS:
+ *   - Vector:
+ *       __m256d V;
+ * RETURNS:
+ *   (dbl) Elements sum.
+ */
+static inline dbl __vectorcall HorizontalSum( __m256d V )
+{
+  const auto Half {_mm_add_pd(_mm256_castpd256_pd128(V), _mm256_extractf128_pd(V, 1))};
+
+  return _mm_cvtsd_f64(_mm_hadd_pd(Half, Half));
+} /* End of 'HorizontalSum' function */
+
+/* Vector elements natural logarithm evaluation function.
+ * ARGUMENTS:
+ *   - Vector:
+ *       __m256d V;
+ * RETURNS:
+ *   (__m256d) Logarithms.
+ */
+static inline __m256d __vectorcall Log4( __m256d V )
+{
+  alignas(32) dbl Values[4];
+
+  _mm256_store_pd(Values, V);
+  for (auto &Value : Values)
+    Value = log(Value);
+
+  return _mm256_load_pd(Values);
+} /* End of 'Log4' function */
+
+/* Extended sources analytic elements contribution accumulation function (elements are processed by 4).
+ * Formulas are same as scalar ones in 'ef_sources.cpp', branches are replaced with blends.
+ * ARGUMENTS:
+ *   - Charges snapshot:
+ *       const field_snapshot &Snapshot;
+ *   - Query point (broadcasted):
+ *       __m256d PX, PY;
+ *   - Field, gradient and potential accumulators:
+ *       __m256d &Ex, &Ey, &Dxx, &Dxy, &Dyy, &Phi;
+ */
+template<bool IsField, bool IsGradient, bool IsPotential>
+  static inline void __vectorcall AccumulateSources( const field_snapshot &Snapshot, __m256d PX, __m256d PY,
+                                                     __m256d &Ex, __m256d &Ey, __m256d &Dxx, __m256d &Dxy, __m256d &Dyy, __m256d &Phi )
+  {
+    const auto Zero {_mm256_setzero_pd()}, One {_mm256_set1_pd(1)}, Two {_mm256_set1_pd(2)};
+
+    /* Uniformly charged segments (local frame: T - along direction, H - along normal) */
+    for (size_t i = 0; i < Snapshot.SegQ.size(); i += field_snapshot::Width)
+    {
+      const auto
+        UX {_mm256_loadu_pd(&Snapshot.SegUX[i])}, UY {_mm256_loadu_pd(&Snapshot.SegUY[i])},
+        L {_mm256_loadu_pd(&Snapshot.SegL[i])}, Lambda {_mm256_loadu_pd(&Snapshot.SegQ[i])},
+        DX {_mm256_sub_pd(PX, _mm256_loadu_pd(&Snapshot.SegX[i]))},
+        DY {_mm256_sub_pd(PY, _mm256_loadu_pd(&Snapshot.SegY[i]))},
+        T {_mm256_fmadd_pd(DX, UX, _mm256_mul_pd(DY, UY))},
+        H {_mm256_fmsub_pd(DY, UX, _mm256_mul_pd(DX, UY))},
+        H2 {_mm256_mul_pd(H, H)},
+        T1 {_mm256_sub_pd(_mm256_sub_pd(Zero, L), T)},
+        T2 {_mm256_sub_pd(L, T)},
+        R1 {_mm256_sqrt_pd(_mm256_fmadd_pd(T1, T1, H2))},
+        R2 {_mm256_sqrt_pd(_mm256_fmadd_pd(T2, T2, H2))},
+        RevR1 {_mm256_div_pd(One, R1)},
+        RevR2 {_mm256_div_pd(One, R2)};
+
+      /* Normal component factor without cancellation near segment line out of segment */
+      const auto
+        Stable
+        {
+          _mm256_div_pd(_mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(-4), L), _mm256_mul_pd(T, _mm256_mul_pd(RevR1, RevR2))),
+                        _mm256_fmadd_pd(T2, R1, _mm256_mul_pd(T1, R2)))
+        },
+        Direct {_mm256_div_pd(_mm256_fmsub_pd(T2, RevR2, _mm256_mul_pd(T1, RevR1)), H2)},
+        S {_mm256_blendv_pd(Direct, Stable, _mm256_cmp_pd(_mm256_mul_pd(T1, T2), Zero, _CMP_GT_OQ))};
+
+      if constexpr (IsField)
+      {
+        const auto
+          Ea {_mm256_mul_pd(Lambda, _mm256_sub_pd(RevR2, RevR1))},
+          Eh {_mm256_mul_pd(Lambda, _mm256_mul_pd(H, S))};
+
+        Ex = _mm256_add_pd(Ex, _mm256_fmsub_pd(Ea, UX, _mm256_mul_pd(Eh, UY)));
+        Ey = _mm256_add_pd(Ey, _mm256_fmadd_pd(Ea, UY, _mm256_mul_pd(Eh, UX)));
+      }
+
+      if constexpr (IsGradient)
+      {
+        const auto
+          RevR13 {_mm256_mul_pd(RevR1, _mm256_mul_pd(RevR1, RevR1))},
+          RevR23 {_mm256_mul_pd(RevR2, _mm256_mul_pd(RevR2, RevR2))},
+          Daa {_mm256_mul_pd(Lambda, _mm256_fmsub_pd(T2, RevR23, _mm256_mul_pd(T1, RevR13)))},
+          Dah {_mm256_mul_pd(_mm256_mul_pd(Lambda, H), _mm256_sub_pd(RevR13, RevR23))},
+          Dhh {_mm256_fnmadd_pd(Lambda, S, _mm256_sub_pd(Zero, Daa))},
+          UXX {_mm256_mul_pd(UX, UX)}, UYY {_mm256_mul_pd(UY, UY)}, UXY2 {_mm256_mul_pd(Two, _mm256_mul_pd(UX, UY))};
+
+        Dxx = _mm256_add_pd(Dxx, _mm256_fmadd_pd(UXX, Daa, _mm256_fnmadd_pd(UXY2, Dah, _mm256_mul_pd(UYY, Dhh))));
+        Dxy = _mm256_add_pd(Dxy, _mm256_fmadd_pd(_mm256_mul_pd(UX, UY), _mm256_sub_pd(Daa, Dhh), _mm256_mul_pd(_mm256_sub_pd(UXX, UYY), Dah)));
+        Dyy = _mm256_add_pd(Dyy, _mm256_fmadd_pd(UYY, Daa, _mm256_fmadd_pd(UXY2, Dah, _mm256_mul_pd(UXX, Dhh))));
+      }
+
+      if constexpr (IsPotential)
+      {
+        /* Logarithm argument is taken from side without cancellation */
+        const auto
+          IsFront {_mm256_cmp_pd(T, Zero, _CMP_GE_OQ)},
+          Num {_mm256_blendv_pd(_mm256_add_pd(T2, R2), _mm256_sub_pd(R1, T1), IsFront)},
+          Den {_mm256_blendv_pd(_mm256_add_pd(T1, R1), _mm256_sub_pd(R2, T2), IsFront)};
+
+        Phi = _mm256_fmadd_pd(Lambda, Log4(_mm256_div_pd(Num, Den)), Phi);
+      }
+    }
+
+    /* Uniformly charged disks (radial field by complete elliptic integrals, modulus is R / r outside and r / R inside) */
+    for (size_t i = 0; i < Snapshot.DiskQ.size(); i += field_snapshot::Width)
+    {
+      const auto
+        R {_mm256_loadu_pd(&Snapshot.DiskR[i])},
+        Sigma4 {_mm256_mul_pd(_mm256_set1_pd(4), _mm256_loadu_pd(&Snapshot.DiskQ[i]))},
+        DX {_mm256_sub_pd(PX, _mm256_loadu_pd(&Snapshot.DiskX[i]))},
+        DY {_mm256_sub_pd(PY, _mm256_loadu_pd(&Snapshot.DiskY[i]))},
+        Dist {_mm256_max_pd(_mm256_sqrt_pd(_mm256_fmadd_pd(DX, DX, _mm256_mul_pd(DY, DY))), _mm256_mul_pd(R, _mm256_set1_pd(1e-12)))},
+        IsOutside {_mm256_cmp_pd(Dist, R, _CMP_GT_OQ)},
+        Mod {_mm256_blendv_pd(_mm256_max_pd(_mm256_div_pd(Dist, R), _mm256_set1_pd(1e-4)), _mm256_div_pd(R, Dist), IsOutside)},
+        Mod2 {_mm256_mul_pd(Mod, Mod)},
+        CoMod2 {_mm256_max_pd(_mm256_sub_pd(One, Mod2), _mm256_set1_pd(1e-30))};
+
+      /* Arithmetic-geometric mean with fixed iterations count */
+      auto A {One}, B {_mm256_sqrt_pd(CoMod2)}, Sum {_mm256_mul_pd(Mod2, _mm256_set1_pd(0.5))}, Pow {_mm256_set1_pd(0.5)};
+
+      for (INT k = 0; k < 10; k++)
+      {
+        const auto C {_mm256_mul_pd(_mm256_sub_pd(A, B), _mm256_set1_pd(0.5))};
+
+        B = _mm256_sqrt_pd(_mm256_mul_pd(A, B));
+        A = _mm256_sub_pd(A, C);
+        Pow = _mm256_add_pd(Pow, Pow);
+        Sum = _mm256_fmadd_pd(Pow, _mm256_mul_pd(C, C), Sum);
+      }
+
+      const auto
+        K {_mm256_div_pd(_mm256_set1_pd(M_PI / 2), A)},
+        E {_mm256_fnmadd_pd(K, Sum, K)},
+        SKE {_mm256_mul_pd(Sigma4, _mm256_sub_pd(K, E))},
+        Er {_mm256_blendv_pd(_mm256_div_pd(SKE, Mod), SKE, IsOutside)},
+        RevDist {_mm256_div_pd(One, Dist)},
+        CX {_mm256_mul_pd(DX, RevDist)}, CY {_mm256_mul_pd(DY, RevDist)};
+
+      if constexpr (IsField)
+      {
+        Ex = _mm256_fmadd_pd(Er, CX, Ex);
+        Ey = _mm256_fmadd_pd(Er, CY, Ey);
+      }
+
+      if constexpr (IsGradient)
+      {
+        const auto
+          DErOut {_mm256_div_pd(_mm256_mul_pd(_mm256_mul_pd(Sigma4, E), Mod2), _mm256_sub_pd(Zero, _mm256_mul_pd(Dist, CoMod2)))},
+          DErIn
+          {
+            _mm256_mul_pd(_mm256_div_pd(Sigma4, _mm256_mul_pd(R, Mod2)),
+                          _mm256_add_pd(_mm256_sub_pd(_mm256_div_pd(_mm256_mul_pd(E, Mod2), CoMod2), K), E))
+          },
+          DEr {_mm256_blendv_pd(DErIn, DErOut, IsOutside)},
+          ErR {_mm256_mul_pd(Er, RevDist)},
+          CXX {_mm256_mul_pd(CX, CX)}, CYY {_mm256_mul_pd(CY, CY)};
+
+        Dxx = _mm256_add_pd(Dxx, _mm256_fmadd_pd(DEr, CXX, _mm256_mul_pd(ErR, _mm256_sub_pd(One, CXX))));
+        Dxy = _mm256_fmadd_pd(_mm256_sub_pd(DEr, ErR), _mm256_mul_pd(CX, CY), Dxy);
+        Dyy = _mm256_add_pd(Dyy, _mm256_fmadd_pd(DEr, CYY, _mm256_mul_pd(ErR, _mm256_sub_pd(One, CYY))));
+      }
+
+      if constexpr (IsPotential)
+        Phi = _mm256_add_pd(Phi, _mm256_mul_pd(Sigma4, _mm256_blendv_pd(_mm256_mul_pd(R, E),
+                                                                        _mm256_mul_pd(Dist, _mm256_fnmadd_pd(CoMod2, K, E)), IsOutside)));
+    }
+
+    /* Ideal multipoles (field is Cx X + Cu u, gradient is combination of I, X X^T, u u^T and X u^T + u X^T) */
+    for (size_t i = 0; i < Snapshot.MulP.size(); i += field_snapshot::Width)
+    {
+      const auto
+        UX {_mm256_loadu_pd(&Snapshot.MulUX[i])}, UY {_mm256_loadu_pd(&Snapshot.MulUY[i])},
+        Dp {_mm256_loadu_pd(&Snapshot.MulP[i])}, Qd {_mm256_loadu_pd(&Snapshot.MulQ[i])},
+        DX {_mm256_sub_pd(PX, _mm256_loadu_pd(&Snapshot.MulX[i]))},
+        DY {_mm256_sub_pd(PY, _mm256_loadu_pd(&Snapshot.MulY[i]))},
+        S {_mm256_fmadd_pd(DX, UX, _mm256_mul_pd(DY, UY))}, S2 {_mm256_mul_pd(S, S)},
+        R2 {_mm256_fmadd_pd(DX, DX, _mm256_mul_pd(DY, DY))},
+        RevR2 {_mm256_div_pd(One, R2)},
+        RevR3 {_mm256_div_pd(RevR2, _mm256_sqrt_pd(R2))},
+        RevR5 {_mm256_mul_pd(RevR3, RevR2)},
+        RevR7 {_mm256_mul_pd(RevR5, RevR2)},
+        QdRevR5 {_mm256_mul_pd(Qd, RevR5)},
+        Cx
+        {
+          _mm256_fmadd_pd(_mm256_mul_pd(_mm256_set1_pd(3), Dp), _mm256_mul_pd(S, RevR5),
+                          _mm256_mul_pd(Qd, _mm256_fmsub_pd(_mm256_set1_pd(7.5), _mm256_mul_pd(S2, RevR7),
+                                                            _mm256_mul_pd(_mm256_set1_pd(1.5), RevR5))))
+        };
+
+      if constexpr (IsField)
+      {
+        const auto Cu {_mm256_fnmadd_pd(Dp, RevR3, _mm256_mul_pd(_mm256_set1_pd(-3), _mm256_mul_pd(QdRevR5, S)))};
+
+        Ex = _mm256_add_pd(Ex, _mm256_fmadd_pd(Cx, DX, _mm256_mul_pd(Cu, UX)));
+        Ey = _mm256_add_pd(Ey, _mm256_fmadd_pd(Cx, DY, _mm256_mul_pd(Cu, UY)));
+      }
+
+      if constexpr (IsGradient)
+      {
+        const auto
+          Kxu {_mm256_fmadd_pd(_mm256_set1_pd(3), _mm256_mul_pd(Dp, RevR5), _mm256_mul_pd(_mm256_set1_pd(15), _mm256_mul_pd(_mm256_mul_pd(Qd, S), RevR7)))},
+          Kxx
+          {
+            _mm256_fmadd_pd(_mm256_set1_pd(-15), _mm256_mul_pd(_mm256_mul_pd(Dp, S), RevR7),
+                            _mm256_mul_pd(_mm256_mul_pd(Qd, RevR7), _mm256_fnmadd_pd(_mm256_set1_pd(52.5), _mm256_mul_pd(S2, RevR2), _mm256_set1_pd(7.5))))
+          },
+          Kuu {_mm256_mul_pd(_mm256_set1_pd(-3), QdRevR5)},
+          XU {_mm256_mul_pd(Kxu, DX)}, YU {_mm256_mul_pd(Kxu, DY)};
+
+        Dxx = _mm256_add_pd(Dxx, _mm256_fmadd_pd(Two, _mm256_mul_pd(XU, UX),
+                                                 _mm256_fmadd_pd(Kxx, _mm256_mul_pd(DX, DX), _mm256_fmadd_pd(Kuu, _mm256_mul_pd(UX, UX), Cx))));
+        Dxy = _mm256_add_pd(Dxy, _mm256_fmadd_pd(XU, UY, _mm256_fmadd_pd(YU, UX,
+                                                                         _mm256_fmadd_pd(Kxx, _mm256_mul_pd(DX, DY), _mm256_mul_pd(Kuu, _mm256_mul_pd(UX, UY))))));
+        Dyy = _mm256_add_pd(Dyy, _mm256_fmadd_pd(Two, _mm256_mul_pd(YU, UY),
+                                                 _mm256_fmadd_pd(Kxx, _mm256_mul_pd(DY, DY), _mm256_fmadd_pd(Kuu, _mm256_mul_pd(UY, UY), Cx))));
+      }
+
+      if constexpr (IsPotential)
+        Phi = _mm256_add_pd(Phi, _mm256_fmadd_pd(_mm256_mul_pd(Dp, S), RevR3,
+                                                 _mm256_mul_pd(QdRevR5, _mm256_fmsub_pd(_mm256_set1_pd(1.5), S2, _mm256_mul_pd(_mm256_set1_pd(0.5), R2)))));
+    }
+  } /* End of 'AccumulateSources' function */
+
+/* Charges images by grounded boundary evaluation function (charges are processed by 4).
+ * ARGUMENTS:
+ *   - Boundary parameters (point or center, normal, squared radius):
+ *       __m256d BX, BY, NX, NY, BR2;
+ *   - Charges coordinates and values (values of screened charges are zeroed):
+ *       __m256d X, Y;
+ *       __m256d &Q;
+ *   - Images coordinates and values (out):
+ *       __m256d &IX, &IY, &IQ;
+ */
+template<boundary_type Type>
+  static inline void __vectorcall EvalImages( __m256d BX, __m256d BY, __m256d NX, __m256d NY, __m256d BR2,
+                                              __m256d X, __m256d Y, __m256d &Q, __m256d &IX, __m256d &IY, __m256d &IQ )
+  {
+    const auto DX {_mm256_sub_pd(X, BX)}, DY {_mm256_sub_pd(Y, BY)};
+
+    if constexpr (Type == boundary_type::Line)
+    {
+      /* Mirror over line */
+      const auto D {_mm256_fmadd_pd(DX, NX, _mm256_mul_pd(DY, NY))}, D2 {_mm256_add_pd(D, D)};
+
+      Q = _mm256_and_pd(_mm256_cmp_pd(D, _mm256_setzero_pd(), _CMP_GT_OQ), Q);
+      IX = _mm256_fnmadd_pd(D2, NX, X);
+      IY = _mm256_fnmadd_pd(D2, NY, Y);
+      IQ = _mm256_sub_pd(_mm256_setzero_pd(), Q);
+    }
+    else
+    {
+      /* Inversion in circle, screened charges images are zero charges in center (selected, not multiplied, so 1 / 0 gives no NaN) */
+      const auto
+        D2 {_mm256_fmadd_pd(DX, DX, _mm256_mul_pd(DY, DY))},
+        IsFree {_mm256_cmp_pd(D2, BR2, _CMP_GT_OQ)},
+        K {_mm256_and_pd(IsFree, _mm256_div_pd(BR2, D2))};
+
+      Q = _mm256_and_pd(IsFree, Q);
+      IX = _mm256_fmadd_pd(DX, K, BX);
+      IY = _mm256_fmadd_pd(DY, K, BY);
+      IQ = _mm256_sub_pd(_mm256_setzero_pd(), _mm256_mul_pd(Q, _mm256_sqrt_pd(K)));
+    }
+  } /* End of 'EvalImages' function */
+
+/* Field values for points array evaluation kernel (charges are processed by 4).
+ * Boundary images are generated from charges in same loop, so charges memory stays same.
+ * ARGUMENTS:
+ *   - Charges snapshot:
+ *       const field_snapshot &Snapshot;
+ *   - Query points:
+ *       const coordd *Points;
+ *   - Query points count:
+ *       size_t Count;
+ *   - Outputs:
+ *       const field_out &Out;
+ */
+template<boundary_type Type, bool IsField, bool IsGradient, bool IsPotential>
+  static void EvalFieldKernel( const field_snapshot &Snapshot, const coordd *Points, size_t Count, const field_out &Out )
+  {
+    const size_t Charges {Snapshot.PaddedCount()};
+    const dbl *SX {Snapshot.X.data()}, *SY {Snapshot.Y.data()}, *SQ {Snapshot.Q.data()};
+    const auto One {_mm256_set1_pd(1)}, Three {_mm256_set1_pd(3)};
+
+    const boundary &Boundary {Snapshot.Boundary};
+    const auto
+      BX {_mm256_set1_pd(Boundary.Point.X)}, BY {_mm256_set1_pd(Boundary.Point.Y)},
+      NX {_mm256_set1_pd(Boundary.Normal.X)}, NY {_mm256_set1_pd(Boundary.Normal.Y)},
+      BR2 {_mm256_set1_pd(Boundary.Radius * Boundary.Radius)};
+
+    for (size_t p = 0; p < Count; p++)
+    {
+      const auto PX {_mm256_set1_pd(Points[p].X)}, PY {_mm256_set1_pd(Points[p].Y)};
+      auto Ex {_mm256_setzero_pd()}, Ey {Ex}, Dxx {Ex}, Dxy {Ex}, Dyy {Ex}, Phi {Ex};
+
+      /* Charges by 4 contribution accumulation */
+      auto Accumulate = [&]( __m256d CX, __m256d CY, __m256d Q )
+        {
+          const auto
+            DX {_mm256_sub_pd(PX, CX)},
+            DY {_mm256_sub_pd(PY, CY)};
+
+          /* Shared distance powers */
+          const auto
+            R2 {_mm256_fmadd_pd(DX, DX, _mm256_mul_pd(DY, DY))},
+            RevR {_mm256_div_pd(One, _mm256_sqrt_pd(R2))},
+            RevR2 {_mm256_mul_pd(RevR, RevR)},
+            QR3 {_mm256_mul_pd(Q, _mm256_mul_pd(RevR2, RevR))};
+
+          if constexpr (IsField)
+          {
+            Ex = _mm256_fmadd_pd(QR3, DX, Ex);
+            Ey = _mm256_fmadd_pd(QR3, DY, Ey);
+          }
+
+          if constexpr (IsGradient)
+          {
+            const auto QR5 {_mm256_mul_pd(Three, _mm256_mul_pd(QR3, RevR2))};
+
+            Dxx = _mm256_add_pd(Dxx, _mm256_fnmadd_pd(_mm256_mul_pd(QR5, DX), DX, QR3));
+            Dxy = _mm256_fnmadd_pd(_mm256_mul_pd(QR5, DX), DY, Dxy);
+            Dyy = _mm256_add_pd(Dyy, _mm256_fnmadd_pd(_mm256_mul_pd(QR5, DY), DY, QR3));
+          }
+
+          if constexpr (IsPotential)
+            Phi = _mm256_fmadd_pd(Q, RevR, Phi);
+        };
+
+      for (size_t i = 0; i < Charges; i += field_snapshot::Width)
+      {
+        const auto X {_mm256_loadu_pd(SX + i)}, Y {_mm256_loadu_pd(SY + i)};
+        auto Q {_mm256_loadu_pd(SQ + i)};
+
+        if constexpr (Type != boundary_type::None)
+        {
+          __m256d IX, IY, IQ;
+
+          EvalImages<Type>(BX, BY, NX, NY, BR2, X, Y, Q, IX, IY, IQ);
+          Accumulate(IX, IY, IQ);
+        }
+
+        Accumulate(X, Y, Q);
+      }
+
+      /* Extended sources with their images */
+      if (Snapshot.HasSources())
+      {
+        for (size_t i = 0; i < Snapshot.FixedQ.size(); i += field_snapshot::Width)
+          Accumulate(_mm256_loadu_pd(&Snapshot.FixedX[i]), _mm256_loadu_pd(&Snapshot.FixedY[i]), _mm256_loadu_pd(&Snapshot.FixedQ[i]));
+        AccumulateSources<IsField, IsGradient, IsPotential>(Snapshot, PX, PY, Ex, Ey, Dxx, Dxy, Dyy, Phi);
+      }
+
+      /* Field inside grounded conductor is zero */
+      if constexpr (Type != boundary_type::None)
+        if (Boundary.Distance(Points[p]) < 0)
+        {
+          if constexpr (IsField)
+            Out.Ex[p] = Out.Ey[p] = 0;
+
+          if constexpr (IsGradient)
+            Out.Dxx[p] = Out.Dxy[p] = Out.Dyy[p] = 0;
+
+          if constexpr (IsPotential)
+            Out.Phi[p] = 0;
+          continue;
+        }
+
+      if constexpr (IsField)
+        Out.Ex[p] = HorizontalSum(Ex), Out.Ey[p] = HorizontalSum(Ey);
+
+      if constexpr (IsGradient)
+        Out.Dxx[p] = HorizontalSum(Dxx), Out.Dxy[p] = HorizontalSum(Dxy), Out.Dyy[p] = HorizontalSum(Dyy);
+
+      if constexpr (IsPotential)
+        Out.Phi[p] = HorizontalSum(Phi);
+    }
+  } /* End of 'EvalFieldKernel' function */
+
+/* Field values for points array evaluation kernel (points are processed by vector width of active instruction set).
+ * Used for few charges and on processors without AVX2: point charges with boundary images are evaluated
+ * by instruction set level kernel, extended sources by their scalar analytic elements.
+ * ARGUMENTS:
+ *   - Charges snapshot:
+ *       const field_snapshot &Snapshot;
+ *   - Query points:
+ *       const coordd *Points;
+ *   - Query points count:
+ *       size_t Count;
+ *   - Outputs (only requested are set):
+ *       const field_out &Out;
+ */
+static void EvalFieldPointsKernel( const field_snapshot &Snapshot, const coordd *Points, size_t Count, const field_out &Out )
+{
+  const boundary &Boundary {Snapshot.Boundary};
+  const bool
+    IsField {Out.Ex != nullptr && Out.Ey != nullptr},
+    IsGradient {Out.Dxx != nullptr && Out.Dxy != nullptr && Out.Dyy != nullptr},
+    IsPotential {Out.Phi != nullptr};
+
+  GetSimdKernels().FieldPoints(Snapshot.X.data(), Snapshot.Y.data(), Snapshot.Q.data(), Snapshot.Count, Boundary, Points, Count, Out);
+
+  if (Snapshot.Elements.IsEmpty() && !Boundary.IsValid())
+    return;
+
+  for (size_t p = 0; p < Count; p++)
+  {
+    /* Field inside grounded conductor is zero */
+    if (Boundary.Distance(Points[p]) < 0)
+    {
+      if (IsField)
+        Out.Ex[p] = Out.Ey[p] = 0;
+
+      if (IsGradient)
+        Out.Dxx[p] = Out.Dxy[p] = Out.Dyy[p] = 0;
+
+      if (IsPotential)
+        Out.Phi[p] = 0;
+      continue;
+    }
+
+    if (Snapshot.Elements.IsEmpty())
+      continue;
+
+    coordd E {0, 0};
+    dbl D[3] {0, 0, 0}, Phi {0};
+
+    Snapshot.Elements.EvalSample(Points[p], E, D, Phi);
+
+    if (IsField)
+      Out.Ex[p] += E.X, Out.Ey[p] += E.Y;
+
+    if (IsGradient)
+      Out.Dxx[p] += D[0], Out.Dxy[p] += D[1], Out.Dyy[p] += D[2];
+
+    if (IsPotential)
+      Out.Phi[p] += Phi;
+  }
+} /* End of 'EvalFieldPointsKernel' function */
+
+/* Field kernel pointer type */
+using field_kernel = void (*)( const field_snapshot &, const coordd *, size_t, const field_out & );
+
+/* Kernels for boundary type by requested outputs (1 - field, 2 - gradient, 4 - potential) */
+template<boundary_type Type>
+  static const field_kernel BoundaryKernels[8]
+  {
+    EvalFieldKernel<Type, false, false, false>, EvalFieldKernel<Type, true, false, false>,
+    EvalFieldKernel<Type, false, true, false>, EvalFieldKernel<Type, true, true, false>,
+    EvalFieldKernel<Type, false, false, true>, EvalFieldKernel<Type, true, false, true>,
+    EvalFieldKernel<Type, false, true, true>, EvalFieldKernel<Type, true, true, true>,
+  };
+
+/* Kernel selection by boundary type and requested outputs function.
+ * ARGUMENTS:
+ *   - Boundary type:
+ *       boundary_type Type;
+ *   - Outputs mask (1 - field, 2 - gradient, 4 - potential):
+ *       size_t Index;
+ * RETURNS:
+ *   (field_kernel) Kernel.
+ */
+static field_kernel SelectKernel( boundary_type Type, size_t Index )
+{
+  static const field_kernel *const Kernels[3]
+  {
+    BoundaryKernels<boundary_type::None>, BoundaryKernels<boundary_type::Line>, BoundaryKernels<boundary_type::Circle>
+  };
+
+  /* Charges vectorized kernels are AVX2 ones, other processors evaluate points by instruction set level kernel */
+  if (prj::util::GetIsa() < prj::util::isa::Avx2)
+    return EvalFieldPointsKernel;
+  return Kernels[(size_t)Type][Index];
+} /* End of 'SelectKernel' function */
+
+/* Active instruction set level kernels table getting function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (const simd_kernels &) Kernels table.
+ */
+const simd_kernels &prj::phys::GetSimdKernels( void )
+{
+  switch (prj::util::GetIsa())
+  {
+  case prj::util::isa::Avx512:
+    return SimdKernelsAvx512;
+  case prj::util::isa::Avx2:
+    return SimdKernelsAvx2;
+  default:
+    return SimdKernelsSse42;
+  }
+} /* End of 'prj::phys::GetSimdKernels' function */
+
+/* Field values for points array evaluation function.
+ * ARGUMENTS:
+ *   - Charges snapshot:
+ *       const field_snapshot &Snapshot;
+ *   - Query points:
+ *       const coordd *Points;
+ *   - Query points count:
+ *       size_t Count;
+ *   - Outputs:
+ *       const field_out &Out;
+ */
+void prj::phys::EvalField( const field_snapshot &Snapshot, const coordd *Points, size_t Count, const field_out &Out )
+{
+  /* Kernel is selected by boundary and requested outputs */
+  const size_t Index
+  {
+    (size_t)(Out.Ex != nullptr && Out.Ey != nullptr) |
+    (size_t)(Out.Dxx != nullptr && Out.Dxy != nullptr && Out.Dyy != nullptr) << 1 |
+    (size_t)(Out.Phi != nullptr) << 2
+  };
+
+  if (Snapshot.Periodic != nullptr)
+    Snapshot.Periodic->EvalField(Points, Count, Out);
+  else if (Index != 0)
+    SelectKernel(Snapshot.Boundary.Type, Index)(Snapshot, Points, Count, Out);
+} /* End of 'prj::phys::EvalField' function */
+
+/* Single point all field values evaluation function.
+ * ARGUMENTS:
+ *   - Charges snapshot:
+ *       const field_snapshot &Snapshot;
+ *   - Query point:
+ *       const coordd &Pos;
+ * RETURNS:
+ *   (field_sample) Field values.
+ */
+field_sample prj::phys::EvalSample( const field_snapshot &Snapshot, const coordd &Pos )
+{
+  field_sample Res;
+  const field_out Out {&Res.E.X, &Res.E.Y, &Res.D[0], &Res.D[1], &Res.D[2], &Res.Phi};
+
+  if (Snapshot.Periodic != nullptr)
+    Snapshot.Periodic->EvalField(&Pos, 1, Out);
+  else
+    SelectKernel(Snapshot.Boundary.Type, 7)(Snapshot, &Pos, 1, Out);
+  return Res;
+} /* End of 'prj::phys::EvalSample' function */
+
+/* Field vectors for points chunk evaluation function.
+ * ARGUMENTS:
+ *   - Charges snapshot:
+ *       const field_snapshot &Snapshot;
+ *   - Query points:
+ *       const coordd *Points;
+ *   - Query points count:
+ *       size_t Count;
+ *   - Field vectors components:
+ *       dbl *OutX, *OutY;
+ */
+static void EvalFieldChunk( const field_snapshot &Snapshot, const coordd *Points, size_t Count, dbl *OutX, dbl *OutY )
+{
+  field_out Out {};
+
+  Out.Ex = OutX, Out.Ey = OutY;
+  if (Snapshot.Periodic != nullptr)
+    Snapshot.Periodic->EvalField(Points, Count, Out);
+  /* Vectorization over charges wastes padding lanes for few charges */
+  else if (Snapshot.Count >= field_snapshot::Width * 2 || Snapshot.HasSources())
+    SelectKernel(Snapshot.Boundary.Type, 1)(Snapshot, Points, Count, Out);
+  else
+    EvalFieldPointsKernel(Snapshot, Points, Count, Out);
+} /* End of 'EvalFieldChunk' function */
+
+/* Field vectors for arbitrary points set parallel evaluation function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Query points:
+ *       std::span<const point> Points;
+ *   - Field vectors:
+ *       field_vectors<type> Out;
+ *   - Threads count (0 <=> auto):
+ *       size_t Threads;
+ *   - Periodic lattice evaluator (nullptr - charges are isolated):
+ *       const ewald_sum *Periodic;
+ *   - Grounded conductor boundary:
+ *       const boundary &Boundary;
+ */
+template<typename point, typename type>
+  static void EvalFieldParallel( const charge_pool &Charges, std::span<const point> Points, field_vectors<type> Out, size_t Threads,
+                                 const ewald_sum *Periodic, const boundary &Boundary )
+  {
+    constexpr size_t ChunkSize {4096};
+
+    const field_snapshot Snapshot {Charges, Periodic, Boundary};
+    const size_t Count {std::min({Points.size(), Out.X.size(), Out.Y.size()})};
+
+    /* Points chunk evaluation */
+    auto Process = [&]( size_t Begin, size_t End )
+      {
+        if constexpr (std::is_same_v<point, coordd> && std::is_same_v<type, dbl>)
+          EvalFieldChunk(Snapshot, Points.data() + Begin, End - Begin, Out.X.data() + Begin, Out.Y.data() + Begin);
+        else
+        {
+          /* Single precision data is converted by chunks, accumulation is made in double precision */
+          std::vector<coordd> Pts(End - Begin);
+          std::vector<dbl> X(End - Begin), Y(End - Begin);
+
+          for (size_t i = Begin; i < End; i++)
+            Pts[i - Begin] = {(dbl)Points[i].X, (dbl)Points[i].Y};
+
+          EvalFieldChunk(Snapshot, Pts.data(), End - Begin, X.data(), Y.data());
+
+          for (size_t i = Begin; i < End; i++)
+            Out.X[i] = (type)X[i - Begin], Out.Y[i] = (type)Y[i - Begin];
+        }
+      };
+
+    if (Count <= ChunkSize || Threads == 1)
+    {
+      for (size_t Begin = 0; Begin < Count; Begin += ChunkSize)
+        Process(Begin, std::min(Begin + ChunkSize, Count));
+      return;
+    }
+
+    /* Points range task */
+    struct chunk
+    {
+      size_t Begin, End;
+    }; /* end of 'chunk' structure */
+
+    prj::util::threads_pool<chunk> Pool {[&]( chunk *Chunk ) -> bool
+      {
+        Process(Chunk->Begin, Chunk->End);
+        return true;
+      }};
+
+    for (size_t Begin = 0; Begin < Count; Begin += ChunkSize)
+      Pool.AddTask(chunk {Begin, std::min(Begin + ChunkSize, Count)});
+
+    Pool.Run(Threads);
+    Pool.Wait();
+  } /* End of 'EvalFieldParallel' function */
+
+/* Field vectors for arbitrary points set evaluation function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Query points:
+ *       std::span<const coordd> Points;
+ *   - Field vectors (size must be not less than points count):
+ *       field_vectors<dbl> Out;
+ *   - Threads count (default: 0 <=> auto):
+ *       size_t Threads;
+ *   - Periodic lattice evaluator (default: nullptr - charges are isolated):
+ *       const ewald_sum *Periodic;
+ *   - Grounded conductor boundary (default: none):
+ *       const boundary &Boundary;
+ */
+void prj::phys::EvalField( const charge_pool &Charges, std::span<const coordd> Points, field_vectors<dbl> Out, size_t Threads,
+                           const ewald_sum *Periodic, const boundary &Boundary )
+{
+  EvalFieldParallel(Charges, Points, Out, Threads, Periodic, Boundary);
+} /* End of 'prj::phys::EvalField' function */
+
+/* Field vectors for arbitrary points set evaluation function (single precision input/output).
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Query points:
+ *       std::span<const coordf> Points;
+ *   - Field vectors (size must be not less than points count):
+ *       field_vectors<flt> Out;
+ *   - Threads count (default: 0 <=> auto):
+ *       size_t Threads;
+ *   - Periodic lattice evaluator (default: nullptr - charges are isolated):
+ *       const ewald_sum *Periodic;
+ *   - Grounded conductor boundary (default: none):
+ *       const boundary &Boundary;
+ */
+void prj::phys::EvalField( const charge_pool &Charges, std::span<const coordf> Points, field_vectors<flt> Out, size_t Threads,
+                           const ewald_sum *Periodic, const boundary &Boundary )
+{
+  EvalFieldParallel(Charges, Points, Out, Threads, Periodic, Boundary);
+} /* End of 'prj::phys::EvalField' function */
+
+/* Benchmark query points generation function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Query points count (rounded up to square):
+ *       size_t Count;
+ * RETURNS:
+ *   (std::vector<coordd>) Points on grid over charges bounding box with margin.
+ */
+static std::vector<coordd> BenchmarkPoints( const charge_pool &Charges, size_t Count )
+{
+  coordd Min {Charges[0].Coord}, Max {Min};
+
+  for (const auto &Elm : Charges)
+  {
+    Min = {std::min(Min.X, Elm.Coord.X), std::min(Min.Y, Elm.Coord.Y)};
+    Max = {std::max(Max.X, Elm.Coord.X), std::max(Max.Y, Elm.Coord.Y)};
+  }
+
+  const size_t Side {(size_t)ceil(sqrt((dbl)Count))};
+  std::vector<coordd> Points {};
+
+  Points.reserve(Side * Side);
+  for (size_t y = 0; y < Side; y++)
+    for (size_t x = 0; x < Side; x++)
+      Points.push_back({Min.X - 2 + (Max.X - Min.X + 4) * (x + 0.5) / Side,
+                        Min.Y - 2 + (Max.Y - Min.Y + 4) * (y + 0.5) / Side});
+
+  return Points;
+} /* End of 'BenchmarkPoints' function */
+
+/* Points set field evaluation scaling by threads count benchmark function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Query points count:
+ *       size_t Count;
+ * RETURNS:
+ *   (std::string) Report.
+ */
+std::string prj::phys::BenchmarkFieldScaling( const charge_pool &Charges, size_t Count )
+{
+  if (Charges.IsEmpty() || Count == 0)
+    return "Field scaling benchmark: no charges\n";
+
+  const auto Points {BenchmarkPoints(Charges, Count)};
+  std::vector<dbl> X(Points.size()), Y(Points.size());
+  const size_t MaxThreads {std::max<size_t>(std::thread::hardware_concurrency(), 1)};
+
+  UINT64 Freq, Start, End;
+  dbl SingleTime {0};
+
+  QueryPerformanceFrequency((LARGE_INTEGER *)&Freq);
+
+  std::string Res {"Field scaling benchmark (" + std::to_string(Charges.Size()) + " charges, " +
+                   std::to_string(Points.size()) + " points, vectorized over " +
+                   (Charges.Size() >= field_snapshot::Width * 2 ? "charges" : "points") + "):\n"};
+
+  /* Threads counts: powers of two and all cores */
+  std::vector<size_t> ThreadsCounts {};
+
+  for (size_t Threads = 1; Threads < MaxThreads; Threads *= 2)
+    ThreadsCounts.push_back(Threads);
+  ThreadsCounts.push_back(MaxThreads);
+
+  for (const size_t Threads : ThreadsCounts)
+  {
+    QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+    EvalField(Charges, std::span<const coordd> {Points}, field_vectors<dbl> {X, Y}, Threads);
+    QueryPerformanceCounter((LARGE_INTEGER *)&End);
+
+    const dbl Time {(End - Start) * 1000.0 / Freq};
+    CHAR Buf[0x80];
+
+    if (Threads == 1)
+      SingleTime = Time;
+
+    sprintf(Buf, "  - %zu threads: %.3f ms, speedup %.2fx\n", Threads, Time, SingleTime / std::max(Time, 1e-9));
+    Res += Buf;
+  }
+
+  return Res;
+} /* End of 'prj::phys::BenchmarkFieldScaling' function */
+
+/* Scalar reference field vector evaluation function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Query point:
+ *       const coordd &Pos;
+ * RETURNS:
+ *   (coordd) Field vector.
+ */
+coordd prj::phys::EvalFieldScalar( const charge_pool &Charges, const coordd &Pos )
+{
+  coordd Res {source_elements {Charges}.EvalField(Pos)};
+
+  for (const auto &Elm : Charges)
+  {
+    if (IsExtended(Elm))
+      continue;
+
+    const dbl
+      DX {Pos.X - Elm.Coord.X},
+      DY {Pos.Y - Elm.Coord.Y},
+      R {sqrt(DX * DX + DY * DY)},
+      QR3 {Elm.Charge / (R * R * R)};
+
+    Res.X += QR3 * DX;
+    Res.Y += QR3 * DY;
+  }
+
+  return Res;
+} /* End of 'prj::phys::EvalFieldScalar' function */
+
+/* Scalar reference field gradient evaluation function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Query point:
+ *       const coordd &Pos;
+ *   - Gradient (out, dEx/dx, dEx/dy = dEy/dx, dEy/dy):
+ *       dbl (&D)[3];
+ */
+void prj::phys::EvalGradientScalar( const charge_pool &Charges, const coordd &Pos, dbl (&D)[3] )
+{
+  D[0] = D[1] = D[2] = 0;
+
+  /* Extended sources */
+  coordd E {0, 0};
+  dbl Phi {0};
+
+  source_elements {Charges}.EvalSample(Pos, E, D, Phi);
+
+  for (const auto &Elm : Charges)
+  {
+    if (IsExtended(Elm))
+      continue;
+
+    const dbl
+      DX {Pos.X - Elm.Coord.X},
+      DY {Pos.Y - Elm.Coord.Y},
+      R2 {DX * DX + DY * DY},
+      R {sqrt(R2)},
+      QR3 {Elm.Charge / (R2 * R)},
+      QR5 {3 * QR3 / R2};
+
+    D[0] += QR3 - QR5 * DX * DX;
+    D[1] -= QR5 * DX * DY;
+    D[2] += QR3 - QR5 * DY * DY;
+  }
+} /* End of 'prj::phys::EvalGradientScalar' function */
+
+/* Scalar reference potential evaluation function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Query point:
+ *       const coordd &Pos;
+ * RETURNS:
+ *   (dbl) Potential.
+ */
+dbl prj::phys::EvalPotentialScalar( const charge_pool &Charges, const coordd &Pos )
+{
+  coordd E {0, 0};
+  dbl D[3] {0, 0, 0}, Res {0};
+
+  source_elements {Charges}.EvalSample(Pos, E, D, Res);
+
+  for (const auto &Elm : Charges)
+    if (!IsExtended(Elm))
+      Res += Elm.Charge / hypot(Pos.X - Elm.Coord.X, Pos.Y - Elm.Coord.Y);
+
+  return Res;
+} /* End of 'prj::phys::EvalPotentialScalar' function */
+
+/* Batched kernel versus separate scalar evaluations benchmark function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Query points count (points are spread over charges bounding box):
+ *       size_t Count;
+ * RETURNS:
+ *   (std::string) Report.
+ */
+std::string prj::phys::BenchmarkField( const charge_pool &Charges, size_t Count )
+{
+  if (Charges.IsEmpty() || Count == 0)
+    return "Field benchmark: no charges\n";
+
+  /* Query points on grid over charges (with margin) */
+  const auto Points {BenchmarkPoints(Charges, Count)};
+
+  std::vector<dbl> Values(Points.size() * 6);
+  const field_out Out
+  {
+    &Values[0], &Values[Points.size()],
+    &Values[Points.size() * 2], &Values[Points.size() * 3], &Values[Points.size() * 4],
+    &Values[Points.size() * 5]
+  };
+
+  UINT64 Freq, Start, Batched, Scalar;
+  dbl MaxError {0};
+
+  QueryPerformanceFrequency((LARGE_INTEGER *)&Freq);
+
+  /* Batched evaluation */
+  const field_snapshot Snapshot {Charges};
+
+  QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+  EvalField(Snapshot, Points.data(), Points.size(), Out);
+  QueryPerformanceCounter((LARGE_INTEGER *)&Batched);
+  Batched -= Start;
+
+  /* Separate scalar evaluations */
+  std::vector<field_sample> Reference(Points.size());
+
+  QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+  for (size_t i = 0; i < Points.size(); i++)
+  {
+    Reference[i].E = EvalFieldScalar(Charges, Points[i]);
+    EvalGradientScalar(Charges, Points[i], Reference[i].D);
+    Reference[i].Phi = EvalPotentialScalar(Charges, Points[i]);
+  }
+  QueryPerformanceCounter((LARGE_INTEGER *)&Scalar);
+  Scalar -= Start;
+
+  /* Batched results relative error */
+  for (size_t i = 0; i < Points.size(); i++)
+  {
+    const auto &Ref {Reference[i]};
+    const dbl
+      Vals[6] {Ref.E.X, Ref.E.Y, Ref.D[0], Ref.D[1], Ref.D[2], Ref.Phi},
+      Batch[6] {Out.Ex[i], Out.Ey[i], Out.Dxx[i], Out.Dxy[i], Out.Dyy[i], Out.Phi[i]};
+
+    for (INT j = 0; j < 6; j++)
+      MaxError = std::max(MaxError, abs(Vals[j] - Batch[j]) / std::max(abs(Vals[j]), 1e-12));
+  }
+
+  CHAR Buf[0x200];
+
+  sprintf(Buf,
+          "Field benchmark (%zu charges, %zu points, E + grad E + potential):\n"
+          "  - Batched kernel: %.3f ms (%.1f ns/point)\n"
+          "  - Separate scalar evaluations: %.3f ms (%.1f ns/point)\n"
+          "  - Speedup: %.2fx, max relative error: %.2e\n",
+          Charges.Size(), Points.size(),
+          Batched * 1000.0 / Freq, Batched * 1e9 / Freq / Points.size(),
+          Scalar * 1000.0 / Freq, Scalar * 1e9 / Freq / Points.size(),
+          (dbl)Scalar / std::max<UINT64>(Batched, 1), MaxError);
+
+  return Buf;
+} /* End of 'prj::phys::BenchmarkField' function */
+
+/* Implicit boundary images versus explicitly added image charges benchmark function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Grounded conductor boundary:
+ *       const boundary &Boundary;
+ *   - Query points count:
+ *       size_t Count;
+ * RETURNS:
+ *   (std::string) Report.
+ */
+std::string prj::phys::BenchmarkBoundary( const charge_pool &Charges, const boundary &Boundary, size_t Count )
+{
+  if (Charges.IsEmpty() || Count == 0 || !Boundary.IsValid())
+    return "Boundary benchmark: no charges or boundary\n";
+
+  /* Hand placed mirror charges (screened charges are dropped, extended sources are not compared) */
+  charge_pool Free {}, Mirrored {};
+
+  for (const auto &Elm : Charges)
+  {
+    coordd IC;
+    dbl IQ;
+
+    if (IsExtended(Elm))
+      continue;
+    Free.Add({Elm.Coord, Elm.Charge, Elm.Size});
+    if (Boundary.Image(Elm.Coord, Elm.Charge, IC, IQ))
+    {
+      Mirrored.Add({Elm.Coord, Elm.Charge, Elm.Size});
+      Mirrored.Add({IC, IQ, Elm.Size});
+    }
+  }
+
+  /* Query points in free region only */
+  auto Points {BenchmarkPoints(Charges, Count)};
+
+  std::erase_if(Points, [&]( const coordd &P ){ return Boundary.Distance(P) < 0; });
+  if (Points.empty() || Mirrored.IsEmpty())
+    return "Boundary benchmark: no free points\n";
+
+  const field_snapshot
+    Implicit {Free, nullptr, Boundary},
+    Explicit {Mirrored};
+  std::vector<dbl> A(Points.size() * 6), B(Points.size() * 6);
+
+  auto Outputs = [&]( std::vector<dbl> &V ) -> field_out
+    {
+      const size_t N {Points.size()};
+
+      return {&V[0], &V[N], &V[N * 2], &V[N * 3], &V[N * 4], &V[N * 5]};
+    };
+
+  UINT64 Freq, Start, ImplicitTime, ExplicitTime;
+
+  QueryPerformanceFrequency((LARGE_INTEGER *)&Freq);
+
+  QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+  EvalField(Implicit, Points.data(), Points.size(), Outputs(A));
+  QueryPerformanceCounter((LARGE_INTEGER *)&ImplicitTime);
+  ImplicitTime -= Start;
+
+  QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+  EvalField(Explicit, Points.data(), Points.size(), Outputs(B));
+  QueryPerformanceCounter((LARGE_INTEGER *)&ExplicitTime);
+  ExplicitTime -= Start;
+
+  dbl MaxError {0};
+
+  for (size_t i = 0; i < A.size(); i++)
+    MaxError = std::max(MaxError, abs(A[i] - B[i]) / std::max(abs(B[i]), 1e-12));
+
+  CHAR Buf[0x200];
+
+  sprintf(Buf,
+          "Boundary benchmark (%s, %zu charges, %zu free points, E + grad E + potential):\n"
+          "  - Implicit images: %.3f ms (%.1f ns/point), %zu charges stored\n"
+          "  - Explicit mirror charges: %.3f ms (%.1f ns/point), %zu charges stored\n"
+          "  - Ratio: %.2fx, max relative difference: %.2e\n",
+          Boundary.Type == boundary_type::Line ? "grounded line" : "grounded circle", Free.Size(), Points.size(),
+          ImplicitTime * 1000.0 / Freq, ImplicitTime * 1e9 / Freq / Points.size(), Implicit.PaddedCount(),
+          ExplicitTime * 1000.0 / Freq, ExplicitTime * 1e9 / Freq / Points.size(), Explicit.PaddedCount(),
+          (dbl)ExplicitTime / std::max<UINT64>(ImplicitTime, 1), MaxError);
+
+  return Buf;
+} /* End of 'prj::phys::BenchmarkBoundary' function */
+
+/* END OF 'ef_field.cpp' FILE */
@@ -0,0 +1,244 @@
+/* FILE NAME   : 'ef_field.h'
+ * PURPOSE     : Physics module.
+ *               Electric field, its gradient and potential evaluation handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#ifndef __ef_field_h__
+#define __ef_field_h__
+
+#include "ef_sources.h"
+
+/* Project namespace // Physics module */
+namespace prj::phys
+{
+  /* Periodic charges lattice field evaluator (see 'ef_ewald.h') */
+  class ewald_sum;
+
+  /* Charges snapshot in structure of arrays layout (padded to SIMD width) */
+  class field_snapshot
+  {
+  public:
+    /* Point charges coordinates and values (padding charges are zero and far away) */
+    std::vector<dbl> X {}, Y {}, Q {};
+
+    /* Real point charges count */
+    size_t Count {0};
+
+    /* Extended sources analytic elements (padding elements are zero and far away):
+     * segments (center, direction, half length, line density), disks (center, radius, surface density),
+     * multipoles (center, axis, dipole and quadrupole moments)
+     * and fixed point charges (sources images which are not generated by kernels) */
+    std::vector<dbl> SegX {}, SegY {}, SegUX {}, SegUY {}, SegL {}, SegQ {};
+    std::vector<dbl> DiskX {}, DiskY {}, DiskR {}, DiskQ {};
+    std::vector<dbl> MulX {}, MulY {}, MulUX {}, MulUY {}, MulP {}, MulQ {};
+    std::vector<dbl> FixedX {}, FixedY {}, FixedQ {};
+
+    /* Same extended sources elements (for points vectorized kernel) */
+    source_elements Elements {};
+
+    /* Periodic lattice evaluator (nullptr - charges are isolated, must live while snapshot is used) */
+    const ewald_sum *Periodic {nullptr};
+
+    /* Grounded conductor boundary (charges images are generated by kernels, ignored for lattice) */
+    boundary Boundary {};
+
+    /* Padding granularity */
+    static constexpr size_t Width {4};
+
+    /* Default constructor */
+    field_snapshot( void ) = default;
+
+    /* Constructor from charges pool.
+     * ARGUMENTS:
+     *   - Charges pool:
+     *       const charge_pool &Charges;
+     *   - Periodic lattice evaluator (default: nullptr - charges are isolated):
+     *       const ewald_sum *NewPeriodic;
+     *   - Grounded conductor boundary (default: none):
+     *       const boundary &NewBoundary;
+     */
+    field_snapshot( const charge_pool &Charges, const ewald_sum *NewPeriodic = nullptr, const boundary &NewBoundary = {} );
+
+    /* Padded charges count getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (size_t) Padded count.
+     */
+    size_t PaddedCount( void ) const
+    {
+      return Q.size();
+    } /* End of 'PaddedCount' function */
+
+    /* Extended sources presence check function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (bool) true if snapshot has analytic elements.
+     */
+    bool HasSources( void ) const
+    {
+      return !SegQ.empty() || !DiskQ.empty() || !MulP.empty() || !FixedQ.empty();
+    } /* End of 'HasSources' function */
+  }; /* end of 'field_snapshot' class */
+
+  /* Field evaluation outputs (structure of arrays, any array may be nullptr) */
+  struct field_out
+  {
+    dbl
+      *Ex {nullptr}, *Ey {nullptr},                   /* Field vector */
+      *Dxx {nullptr}, *Dxy {nullptr}, *Dyy {nullptr}, /* Field gradient (dEx/dx, dEx/dy = dEy/dx, dEy/dy) */
+      *Phi {nullptr};                                 /* Potential */
+  }; /* end of 'field_out' structure */
+
+  /* Single point field values structure */
+  struct field_sample
+  {
+    coordd E;    /* Field vector */
+    dbl D[3];    /* Field gradient (dEx/dx, dEx/dy = dEy/dx, dEy/dy) */
+    dbl Phi;     /* Potential */
+  }; /* end of 'field_sample' structure */
+
+  /* Field values for points array evaluation function.
+   * All requested outputs share distance evaluations.
+   * ARGUMENTS:
+   *   - Charges snapshot:
+   *       const field_snapshot &Snapshot;
+   *   - Query points:
+   *       const coordd *Points;
+   *   - Query points count:
+   *       size_t Count;
+   *   - Outputs:
+   *       const field_out &Out;
+   */
+  void EvalField( const field_snapshot &Snapshot, const coordd *Points, size_t Count, const field_out &Out );
+
+  /* Single point all field values evaluation function.
+   * ARGUMENTS:
+   *   - Charges snapshot:
+   *       const field_snapshot &Snapshot;
+   *   - Query point:
+   *       const coordd &Pos;
+   * RETURNS:
+   *   (field_sample) Field values.
+   */
+  field_sample EvalSample( const field_snapshot &Snapshot, const coordd &Pos );
+
+  /* Scalar reference field vector evaluation function.
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Query point:
+   *       const coordd &Pos;
+   * RETURNS:
+   *   (coordd) Field vector.
+   */
+  coordd EvalFieldScalar( const charge_pool &Charges, const coordd &Pos );
+
+  /* Scalar reference field gradient evaluation function.
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Query point:
+   *       const coordd &Pos;
+   *   - Gradient (out, dEx/dx, dEx/dy = dEy/dx, dEy/dy):
+   *       dbl (&D)[3];
+   */
+  void EvalGradientScalar( const charge_pool &Charges, const coordd &Pos, dbl (&D)[3] );
+
+  /* Scalar reference potential evaluation function.
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Query point:
+   *       const coordd &Pos;
+   * RETURNS:
+   *   (dbl) Potential.
+   */
+  dbl EvalPotentialScalar( const charge_pool &Charges, const coordd &Pos );
+
+  /* Field vectors output in structure of arrays layout */
+  template<typename type>
+    struct field_vectors
+    {
+      std::span<type> X, Y;
+    }; /* end of 'field_vectors' structure */
+
+  /* Field vectors for arbitrary points set evaluation function.
+   * Points are split between threads pool threads, every chunk is vectorized
+   * over charges (many charges) or over points (few charges).
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Query points:
+   *       std::span<const coordd> Points;
+   *   - Field vectors (size must be not less than points count):
+   *       field_vectors<dbl> Out;
+   *   - Threads count (default: 0 <=> auto):
+   *       size_t Threads;
+   *   - Periodic lattice evaluator (default: nullptr - charges are isolated):
+   *       const ewald_sum *Periodic;
+   *   - Grounded conductor boundary (default: none):
+   *       const boundary &Boundary;
+   */
+  void EvalField( const charge_pool &Charges, std::span<const coordd> Points, field_vectors<dbl> Out, size_t Threads = 0,
+                  const ewald_sum *Periodic = nullptr, const boundary &Boundary = {} );
+
+  /* Field vectors for arbitrary points set evaluation function (single precision input/output).
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Query points:
+   *       std::span<const coordf> Points;
+   *   - Field vectors (size must be not less than points count):
+   *       field_vectors<flt> Out;
+   *   - Threads count (default: 0 <=> auto):
+   *       size_t Threads;
+   *   - Periodic lattice evaluator (default: nullptr - charges are isolated):
+   *       const ewald_sum *Periodic;
+   *   - Grounded conductor boundary (default: none):
+   *       const boundary &Boundary;
+   */
+  void EvalField( const charge_pool &Charges, std::span<const coordf> Points, field_vectors<flt> Out, size_t Threads = 0,
+                  const ewald_sum *Periodic = nullptr, const boundary &Boundary = {} );
+
+  /* Points set field evaluation scaling by threads count benchmark function.
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Query points count:
+   *       size_t Count;
+   * RETURNS:
+   *   (std::string) Report.
+   */
+  std::string BenchmarkFieldScaling( const charge_pool &Charges, size_t Count );
+
+  /* Batched kernel versus separate scalar evaluations benchmark function.
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Query points count (points are spread over charges bounding box):
+   *       size_t Count;
+   * RETURNS:
+   *   (std::string) Report.
+   */
+  std::string BenchmarkField( const charge_pool &Charges, size_t Count );
+
+  /* Implicit boundary images versus explicitly added image charges benchmark function.
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Grounded conductor boundary:
+   *       const boundary &Boundary;
+   *   - Query points count:
+   *       size_t Count;
+   * RETURNS:
+   *   (std::string) Report.
+   */
+  std::string BenchmarkBoundary( const charge_pool &Charges, const boundary &Boundary, size_t Count );
+} /* end of 'prj::phys' namespace */
+
+#endif /* __ef_field_h__ */
+
+/* END OF 'ef_field.h' FILE */
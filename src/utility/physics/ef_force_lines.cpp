@@ -2,16 +2,93 @@
  * PURPOSE     : Physics module.
  *               Electric field force lines evaluation class implementation file.
  * PROGRAMMER  : Fedor Borodulin.
- * LAST UPDATE : 10.04.2023.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : Module namespace 'prj::phys'.
  */
 
 #include <pch.h>
 
 #include "ef_force_lines.h"
+#include "utility/cpu_isa/cpu_isa.h"
+#include "utility/threads_pool/threads_pool.hpp"
 
 using namespace prj::phys;
 
+/* Constructor from charges pool.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ */
+charges_cluster::charges_cluster( const charge_pool &Charges )
+{
+  if (Charges.IsEmpty())
+    return;
+
+  coordd Min {Charges[0].Coord}, Max {Min};
+
+  for (const auto &Elm : Charges)
+  {
+    Min = {std::min(Min.X, Elm.Coord.X), std::min(Min.Y, Elm.Coord.Y)};
+    Max = {std::max(Max.X, Elm.Coord.X), std::max(Max.Y, Elm.Coord.Y)};
+    /* Multipoles have zero total charge (their charge is moment) */
+    if (!IsMultipole(Elm))
+      Charge += Elm.Charge;
+  }
+
+  Center = {(Min.X + Max.X) * 0.5, (Min.Y + Max.Y) * 0.5};
+
+  for (const auto &Elm : Charges)
+    Radius = std::max(Radius, hypot(Elm.Coord.X - Center.X, Elm.Coord.Y - Center.Y) + SourceRadius(Elm.Shape) + Elm.Size);
+} /* End of 'charges_cluster::charges_cluster' function */
+
+/* Constructor from charges pool.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Grounded conductor boundary:
+ *       const boundary &NewBoundary;
+ */
+line_environment::line_environment( const charge_pool &Charges, const boundary &NewBoundary ) :
+  Cluster {Charges}, Boundary {NewBoundary}, Sources {Charges, NewBoundary}
+{
+  for (const auto &Elm : Charges)
+  {
+    /* Line sinks are negative charges (positive ones for backward line), multipoles are sinks for both directions,
+     * multipole lines start on seed circle, so they are finished inside its drawn radius */
+    const bool IsMulti {IsMultipole(Elm)};
+    const line_sink Sink {Elm.Coord, IsMulti ? Elm.Size * Elm.Size : Elm.Size * Elm.Size * 4, IsExtended(Elm) && !IsMulti ? &Elm : nullptr};
+
+    if (Elm.Charge < 0 || IsMulti)
+      Sinks[0].push_back(Sink);
+    if (Elm.Charge > 0 || IsMulti)
+      Sinks[1].push_back(Sink);
+
+    /* Extended sources are evaluated by their analytic elements */
+    if (IsExtended(Elm))
+      continue;
+
+    /* Boundary image is packed with charge, screened charges give no force */
+    if (Boundary.IsValid())
+    {
+      coordd ImageCoord;
+      dbl ImageCharge;
+
+      if (!Boundary.Image(Elm.Coord, Elm.Charge, ImageCoord, ImageCharge))
+        continue;
+      PackX.push_back(ImageCoord.X), PackY.push_back(ImageCoord.Y), PackQ.push_back(ImageCharge);
+    }
+
+    PackX.push_back(Elm.Coord.X), PackY.push_back(Elm.Coord.Y), PackQ.push_back(Elm.Charge);
+  }
+
+  /* Every kernels table pads count to its vector width (not greater than packing one) */
+  PackCount = PackX.size();
+
+  const size_t Padded {(PackCount + PackWidth - 1) / PackWidth * PackWidth};
+
+  PackX.resize(Padded, 1e30), PackY.resize(Padded, 1e30), PackQ.resize(Padded, 0);
+} /* End of 'line_environment::line_environment' function */
+
 /* Force evaluation function
  * ARGUMENTS:
  *    - Position:
@@ -19,128 +96,269 @@ using namespace prj::phys;
  * RETURNS:
  *   (__m128d) Force vector.
  */
-__m128d __vectorcall ef_force_line::EvalForce( __m128d PosVec )
+__m128d __vectorcall ef_force_line::EvalForce( __m128d PosVec ) const
 {
   __m128d Res = _mm_setzero_pd();
 
-  for (const auto &Elm : Charges)
+  if (Periodic != nullptr)
   {
-    auto Dir = _mm_sub_pd(PosVec, _mm_load_pd((dbl *)&Elm.Coord));
+    alignas(16) dbl P[2];
+
+    _mm_store_pd(P, PosVec);
+
+    const coordd Force {Periodic->EvalField(coordd {P[0], P[1]})};
+
+    return _mm_set_pd(Force.Y, Force.X);
+  }
+
+  /* Single charge force accumulation */
+  auto Accumulate = [&]( __m128d Coord, dbl Charge )
+    {
+      auto Dir = _mm_sub_pd(PosVec, Coord);
+
+      auto Len = _mm_mul_pd(Dir, Dir);
+      Len = _mm_hadd_pd(Len, Len);
+
+      auto DistCorr = _mm_mul_pd(_mm_mul_pd(Len, Len), Len);
+      DistCorr = _mm_sqrt_pd(DistCorr);
 
-    auto Len = _mm_mul_pd(Dir, Dir);
-    Len = _mm_hadd_pd(Len, Len);
+      auto Val = _mm_mul_pd(_mm_set1_pd(Charge), Dir);
+      Val = _mm_div_pd(Val, DistCorr);
 
-    dbl SqrLength;
-    _mm_store_sd(&SqrLength, Len);
+      Res = _mm_add_pd(Res, Val);
+    };
 
-    auto DistCorr = _mm_mul_pd(_mm_mul_pd(Len, Len), Len);
-    DistCorr = _mm_sqrt_pd(DistCorr);
+  for (const auto &Elm : Charges)
+  {
+    /* Extended sources are evaluated by their analytic elements */
+    if (IsExtended(Elm))
+      continue;
+
+    /* Boundary image is generated from charge, screened charges give no force */
+    if (Env->Boundary.IsValid())
+    {
+      coordd ImageCoord;
+      dbl ImageCharge;
+
+      if (!Env->Boundary.Image(Elm.Coord, Elm.Charge, ImageCoord, ImageCharge))
+        continue;
+      Accumulate(_mm_set_pd(ImageCoord.Y, ImageCoord.X), ImageCharge);
+    }
+
+    Accumulate(_mm_load_pd((dbl *)&Elm.Coord), Elm.Charge);
+  }
+
+  if (!Env->Sources.IsEmpty())
+  {
+    alignas(16) dbl P[2];
 
-    auto Val = _mm_mul_pd(_mm_set1_pd(Elm.Charge), Dir);
-    Val = _mm_div_pd(Val, DistCorr);
+    _mm_store_pd(P, PosVec);
 
-    Res = _mm_add_pd(Res, Val);
+    const coordd Force {Env->Sources.EvalField(coordd {P[0], P[1]})};
+
+    Res = _mm_add_pd(Res, _mm_set_pd(Force.Y, Force.X));
   }
 
   return Res;
 } /* End of 'ef_force_line::EvalForce' function */
 
-/* Next point evaluation function.
- * Standard version.
+/* Whole force callback for charges pool step kernels.
+ * ARGUMENTS:
+ *   - Force line:
+ *       const void *Line;
+ *   - Position:
+ *       __m128d Pos;
  * RETURNS:
- *   (coordf) Next coordinate.
+ *   (__m128d) Force vector.
  */
-coordf ef_force_line::Next1( void )
+__m128d __vectorcall ef_force_line::ListForce( const void *Line, __m128d Pos )
 {
-  auto Pos {_mm_load_pd(this->Pos)};
+  return reinterpret_cast<const ef_force_line *>(Line)->EvalForce(Pos);
+} /* End of 'ef_force_line::ListForce' function */
 
-  if (Continue)
-  {
-    auto Offset = EvalForce(Pos);
-    auto TmpOffset = _mm_mul_pd(Offset, Offset);
-    Offset = _mm_div_pd(Offset, _mm_sqrt_pd(_mm_hadd_pd(TmpOffset, TmpOffset)));
+/* Extended sources force callback for packed charges step kernels.
+ * ARGUMENTS:
+ *   - Extended sources elements:
+ *       const void *Elements;
+ *   - Position:
+ *       __m128d Pos;
+ * RETURNS:
+ *   (__m128d) Force vector.
+ */
+__m128d __vectorcall ef_force_line::SourcesForce( const void *Elements, __m128d Pos )
+{
+  alignas(16) dbl P[2];
 
-    Pos = _mm_add_pd(Pos, _mm_mul_pd(Offset, _mm_set1_pd(0.30)));
-    _mm_store_pd(this->Pos, Pos);
+  _mm_store_pd(P, Pos);
 
-    Pos = CheckIntersection(Pos);
-    _mm_store_pd(this->Pos, Pos);
-  }
+  const coordd Force {reinterpret_cast<const source_elements *>(Elements)->EvalField(coordd {P[0], P[1]})};
 
-  coordf Tmp;
-  _mm_store_sd((dbl *)&Tmp, _mm_castps_pd(_mm_cvtpd_ps(Pos)));
+  return _mm_set_pd(Force.Y, Force.X);
+} /* End of 'ef_force_line::SourcesForce' function */
 
-  return Tmp;
-} /* End of 'ef_force_line::Next1' function */
+/* Far field reaching check (line is finished with analytic ray to bounds)
+ * ARGUMENTS:
+ *   - Position:
+ *       __m128d Pos;
+ *   - Last step direction:
+ *       __m128d Step;
+ * RETURNS:
+ *   (__m128d) New position.
+ */
+__m128d __vectorcall ef_force_line::CheckFarField( __m128d Pos, __m128d Step )
+{
+  /* Lines escape to infinity only from positive total charge (negative for backward lines) */
+  if (FarCharge * Direction <= 0)
+    return Pos;
 
-/* Next point evaluation function.
+  auto Dir = _mm_sub_pd(Pos, _mm_load_pd(FarCenter));
+  auto DirLen = _mm_mul_pd(Dir, Dir);
+  DirLen = _mm_hadd_pd(DirLen, DirLen);
+
+  if (_mm_cvtsd_f64(DirLen) < FarDist2)
+    return Pos;
+
+  /* Check line is going radially */
+  auto StepLen = _mm_mul_pd(Step, Step);
+  StepLen = _mm_hadd_pd(StepLen, StepLen);
+
+  auto Dot = _mm_mul_pd(Dir, Step);
+  Dot = _mm_hadd_pd(Dot, Dot);
+
+  if (_mm_cvtsd_f64(Dot) < FarFieldCos * sqrt(_mm_cvtsd_f64(DirLen) * _mm_cvtsd_f64(StepLen)))
+    return Pos;
+
+  /* Far from cluster field is monopole, so line is a ray from cluster center */
+  dbl P[2], D[2];
+
+  _mm_storeu_pd(P, Pos);
+  _mm_storeu_pd(D, _mm_div_pd(Dir, _mm_sqrt_pd(DirLen)));
+
+  dbl T {std::numeric_limits<dbl>::max()};
+
+  for (INT i = 0; i < 2; i++)
+    if (D[i] > 0)
+      T = std::min(T, (BoundsMax[i] - P[i]) / D[i]);
+    else if (D[i] < 0)
+      T = std::min(T, (BoundsMin[i] - P[i]) / D[i]);
+
+  T = std::max(T, 0.0);
+
+  Continue = false;
+  Reason = line_end::FarField;
+
+  return _mm_set_pd(P[1] + D[1] * T, P[0] + D[0] * T);
+} /* End of 'ef_force_line::CheckFarField' function */
+
+/* Null points neighbourhood reaching and stall check
+ * ARGUMENTS:
+ *   - Position:
+ *       __m128d Pos;
  * RETURNS:
- *   (coordf) Next coordinate.
+ *   (__m128d) New position.
  */
-coordf ef_force_line::Next2( void )
+__m128d __vectorcall ef_force_line::CheckStall( __m128d Pos )
 {
-  auto Pos {_mm_load_pd(this->Pos)};
+  Steps++;
 
-  if (Continue)
-  {
-    const auto HalfPack {_mm_load_pd(this->HalfPack)};
-    const auto Rev3 {_mm_load_pd(this->Rev3)};
-    const auto Rev6 {_mm_load_pd(this->Rev6)};
+  /* Lines stop at null points instead of jittering around them */
+  if (Nulls != nullptr)
+    for (const auto &Elm : *Nulls)
+    {
+      auto Dir = WrapOffset(_mm_sub_pd(Pos, _mm_loadu_pd((dbl *)&Elm)));
+      const auto NullCoord {_mm_sub_pd(Pos, Dir)};
 
-    auto Offset1 = EvalForceLen(Pos);
-    auto Offset2 = EvalForceLen(_mm_fmadd_pd(Offset1, HalfPack, Pos));
-    auto Offset3 = EvalForceLen(_mm_fmadd_pd(Offset2, HalfPack, Pos));
-    auto Offset4 = EvalForceLen(_mm_add_pd(Offset3, Pos));
+      Dir = _mm_mul_pd(Dir, Dir);
+      if (_mm_cvtsd_f64(_mm_hadd_pd(Dir, Dir)) < NullRadius2)
+      {
+        Continue = false;
+        Reason = line_end::Null;
 
-    auto Offset = _mm_fmadd_pd(Offset4, Rev6,
-                               _mm_fmadd_pd(Offset3, Rev3,
-                                            _mm_fmadd_pd(Offset2, Rev3,
-                                                         _mm_mul_pd(Offset1, Rev6))));
+        return NullCoord;
+      }
+    }
 
-    Pos = _mm_add_pd(Offset, Pos);
+  if (++WindowSteps < StallWindow)
+    return Pos;
 
-    Pos = CheckIntersection(Pos);
-    _mm_store_pd(this->Pos, Pos);
+  /* Net displacement over window check */
+  auto Dir = _mm_sub_pd(Pos, _mm_loadu_pd(WindowStart));
+  Dir = _mm_mul_pd(Dir, Dir);
+
+  const dbl MinDisplacement {StallMinPart * StallWindow * LengthPack[0]};
+
+  if (_mm_cvtsd_f64(_mm_hadd_pd(Dir, Dir)) < MinDisplacement * MinDisplacement)
+  {
+    Continue = false;
+    Reason = line_end::Stall;
   }
 
-  coordf Tmp;
-  _mm_store_sd((dbl *)&Tmp, _mm_castps_pd(_mm_cvtpd_ps(Pos)));
+  _mm_storeu_pd(WindowStart, Pos);
+  WindowSteps = 0;
 
-  return Tmp;
-} /* End of 'ef_force_line::Next2' function */
+  return Pos;
+} /* End of 'ef_force_line::CheckStall' function */
+
+/* Charges pool step kernels forcing function (reference path for benchmark) */
+void ef_force_line::SetListKernels( void )
+{
+  SelectKernels();
+  (Kernels != nullptr ? *Kernels : GetSimdKernels()).ListLineKernels(StepKernels);
+  IsListKernels = true;
+} /* End of 'ef_force_line::SetListKernels' function */
+
+/* Step kernels selection function (called once before first step) */
+void ef_force_line::SelectKernels( void )
+{
+  const simd_kernels &Table {Kernels != nullptr ? *Kernels : GetSimdKernels()};
+
+  PackCount = Env->PackCount;
+
+  /* Lattice field is not a charges sum */
+  IsListKernels = Periodic != nullptr;
+  if (IsListKernels)
+  {
+    Table.ListLineKernels(StepKernels);
+    return;
+  }
+
+  /* Kernels are selected by charges count (environment padding covers vector width of every instruction set) */
+  PackCount = Table.SelectLineKernels(PackCount, StepKernels);
+} /* End of 'ef_force_line::SelectKernels' function */
 
 /* Next point evaluation function.
+ * ARGUMENTS:
+ *   - Method index (in 'StepKernels'):
+ *       INT Method;
  * RETURNS:
  *   (coordf) Next coordinate.
  */
-coordf ef_force_line::Next3( void )
+coordf ef_force_line::Advance( INT Method )
 {
   auto Pos {_mm_load_pd(this->Pos)};
 
   if (Continue)
   {
-    const auto LengthPack {_mm_load_pd(this->LengthPack)};
-    const auto HalfPack {_mm_load_pd(this->HalfPack)};
-    const auto Rev3 {_mm_load_pd(this->Rev3)};
-    const auto Rev6 {_mm_load_pd(this->Rev6)};
-
-    auto Offset1 = EvalForceNormLen(Pos);
-
-    auto Offset2 = EvalForceNormLen(_mm_fmadd_pd(Offset1, HalfPack, Pos));
-    auto Offset3 = EvalForceNormLen(_mm_fmadd_pd(Offset2, HalfPack, Pos));
-    auto Offset4 = EvalForceNormLen(_mm_add_pd(Offset3, Pos));
-
-    auto Offset = _mm_fmadd_pd(Offset4, Rev6,
-                               _mm_fmadd_pd(Offset3, Rev3,
-                                            _mm_fmadd_pd(Offset2, Rev3,
-                                                         _mm_mul_pd(Offset1, Rev6))));
-
-    auto OffsetSqr = _mm_mul_pd(Offset, Offset);
-    Offset = _mm_div_pd(_mm_mul_pd(Offset, LengthPack), _mm_sqrt_pd(_mm_hadd_pd(OffsetSqr, OffsetSqr)));
+    /* Kernels are selected once for line environment */
+    if (StepKernels[0] == nullptr)
+      SelectKernels();
+
+    /* Step data is gathered every step (line may be moved between steps) */
+    const line_step_data Data
+    {
+      Env->PackX.data(), Env->PackY.data(), Env->PackQ.data(), PackCount, LengthPack[0],
+      IsListKernels ? ListForce : Env->Sources.IsEmpty() ? nullptr : SourcesForce,
+      IsListKernels ? (const void *)this : &Env->Sources
+    };
+    const auto Offset {StepKernels[Method](Data, Pos)};
 
     Pos = _mm_add_pd(Offset, Pos);
 
     Pos = CheckIntersection(Pos);
+    if (Continue)
+      Pos = CheckFarField(Pos, Offset);
+    if (Continue)
+      Pos = CheckStall(Pos);
     _mm_store_pd(this->Pos, Pos);
   }
 
@@ -148,6 +366,34 @@ coordf ef_force_line::Next3( void )
   _mm_store_sd((dbl *)&Tmp, _mm_castps_pd(_mm_cvtpd_ps(Pos)));
 
   return Tmp;
+} /* End of 'ef_force_line::Advance' function */
+
+/* Next point evaluation function.
+ * Euler method with normalized force (fast low precision version).
+ * RETURNS:
+ *   (coordf) Next coordinate.
+ */
+coordf ef_force_line::Next1( void )
+{
+  return Advance(0);
+} /* End of 'ef_force_line::Next1' function */
+
+/* Next point evaluation function.
+ * RETURNS:
+ *   (coordf) Next coordinate.
+ */
+coordf ef_force_line::Next2( void )
+{
+  return Advance(1);
+} /* End of 'ef_force_line::Next2' function */
+
+/* Next point evaluation function.
+ * RETURNS:
+ *   (coordf) Next coordinate.
+ */
+coordf ef_force_line::Next3( void )
+{
+  return Advance(2);
 } /* End of 'ef_force_line::Next3' function */
 
 /* Next point evaluation function.
@@ -156,35 +402,219 @@ coordf ef_force_line::Next3( void )
  */
 coordf ef_force_line::Next4( void )
 {
-  auto Pos {_mm_load_pd(this->Pos)};
+  return Advance(3);
+} /* End of 'ef_force_line::Next4' function */
 
-  if (Continue)
+/* Force line step latency by charges count (unrolled packed kernels versus charges pool kernel) benchmark function.
+ * ARGUMENTS:
+ *   - Steps per charges count:
+ *       size_t Steps;
+ * RETURNS:
+ *   (std::string) Report.
+ */
+std::string prj::phys::BenchmarkLineSteps( size_t Steps )
+{
+  const size_t Counts[] {1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 64};
+
+  UINT64 Freq;
+  std::string Res {"Force line step latency benchmark (Runge-Kutta with post-normalization, " + std::to_string(Steps) +
+                   " steps, " + GetSimdKernels().Name + " kernels):\n"};
+
+  QueryPerformanceFrequency((LARGE_INTEGER *)&Freq);
+
+  for (const size_t N : Counts)
   {
-    const auto HalfPack {_mm_load_pd(this->HalfPack)};
-    const auto Rev3 {_mm_load_pd(this->Rev3)};
-    const auto Rev6 {_mm_load_pd(this->Rev6)};
+    /* Alternating charges on circle, lines start between them */
+    charge_pool Charges {};
+
+    for (size_t i = 0; i < N; i++)
+    {
+      const dbl Angle {2 * M_PI * i / N}, Q {i % 2 == 0 || N == 1 ? 1.0 : -1.0};
+
+      Charges.Add({{5 * cos(Angle), 5 * sin(Angle)}, Q, 0.1});
+    }
+
+    const line_environment Env {Charges};
+
+    /* Lines are restarted after end, so all steps are counted */
+    auto Run = [&]( bool IsPacked, dbl &Delta ) -> UINT64
+      {
+        UINT64 Start, End;
+        size_t Done {0}, Index {0};
+
+        QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+        while (Done < Steps)
+        {
+          const dbl Angle {0.37 * Index++};
+          ef_force_line Line {{0.3 * cos(Angle), 0.3 * sin(Angle)}, 0.01, Charges, Env};
+
+          if (!IsPacked)
+            Line.SetListKernels();
+          for (size_t i = 0; i < 1000 && Done < Steps && Line.Continue; i++, Done++)
+          {
+            const coordf P {Line.Next3()};
+
+            Delta += P.X + P.Y;
+          }
+        }
+        QueryPerformanceCounter((LARGE_INTEGER *)&End);
+
+        return End - Start;
+      };
+
+    dbl PackedSum {0}, ListSum {0};
+    const UINT64
+      PackedTime {Run(true, PackedSum)},
+      ListTime {Run(false, ListSum)};
+
+    CHAR Buf[0x100];
+
+    sprintf(Buf, "  - %zu charges: unrolled %.1f ns/step, charges pool %.1f ns/step (%.2fx), points sum difference %.2e\n",
+            N, PackedTime * 1e9 / Freq / std::max<size_t>(Steps, 1), ListTime * 1e9 / Freq / std::max<size_t>(Steps, 1),
+            (dbl)ListTime / std::max<UINT64>(PackedTime, 1), abs(PackedSum - ListSum) / std::max(abs(ListSum), 1e-12));
+    Res += Buf;
+  }
 
-    auto Offset1 = EvalForceNormLen(Pos);
+  return Res;
+} /* End of 'prj::phys::BenchmarkLineSteps' function */
 
-    auto Offset2 = EvalForceNormLen(_mm_fmadd_pd(Offset1, HalfPack, Pos));
-    auto Offset3 = EvalForceNormLen(_mm_fmadd_pd(Offset2, HalfPack, Pos));
-    auto Offset4 = EvalForceNormLen(_mm_add_pd(Offset3, Pos));
+/* Deterministic tracing self-check (line points hash by threads count and kernels table) function.
+ * ARGUMENTS:
+ *   - Lines count:
+ *       size_t Lines;
+ *   - Steps per line:
+ *       size_t Steps;
+ * RETURNS:
+ *   (std::string) Report.
+ */
+std::string prj::phys::BenchmarkDeterminism( size_t Lines, size_t Steps )
+{
+  /* Charges count is not multiple of any vector width, so all kernel tails are used */
+  charge_pool Charges {};
 
-    auto Offset = _mm_fmadd_pd(Offset4, Rev6,
-                               _mm_fmadd_pd(Offset3, Rev3,
-                                            _mm_fmadd_pd(Offset2, Rev3,
-                                                         _mm_mul_pd(Offset1, Rev6))));
+  for (size_t i = 0; i < 27; i++)
+  {
+    const dbl Angle {2.39996 * i}, Radius {1 + 7 * fmod(0.618034 * i, 1.0)};
 
-    Pos = _mm_add_pd(Offset, Pos);
+    Charges.Add({{Radius * cos(Angle), Radius * sin(Angle)}, (i % 3 == 0 ? -1.0 : 1.0) * (0.5 + 0.1 * (i % 5)), 0.1});
+  }
 
-    Pos = CheckIntersection(Pos);
-    _mm_store_pd(this->Pos, Pos);
+  const line_environment Env {Charges};
+
+  /* Line task: line and its points */
+  struct trace_task
+  {
+    ef_force_line Line;
+    std::vector<coordf> *Points;
+  }; /* end of 'trace_task' structure */
+
+  UINT64 Freq;
+
+  QueryPerformanceFrequency((LARGE_INTEGER *)&Freq);
+
+  /* All lines points FNV-1a hash (lines are started around charges, negative ones are traced backward) */
+  auto Trace = [&]( const simd_kernels *Table, size_t Threads, dbl &Time ) -> UINT64
+    {
+      std::vector<std::vector<coordf>> Points(Lines);
+      util::threads_pool<trace_task, 8> Pool {[Steps]( trace_task *Task ) -> bool
+        {
+          Task->Points->push_back(Task->Line.Next3());
+          return !Task->Line.Continue || Task->Points->size() >= Steps;
+        }};
+      size_t Index {0};
+
+      for (auto It {Charges.begin()}; Index < Lines; Index++)
+      {
+        const dbl Angle {0.61 * Index};
+        ef_force_line Line {{It->Coord.X + 0.25 * cos(Angle), It->Coord.Y + 0.25 * sin(Angle)}, 0.01, Charges, Env};
+
+        if (It->Charge < 0)
+          Line.SetBackward();
+        if (Table == nullptr)
+          Line.SetDeterministic();
+        else
+          Line.SetKernels(*Table);
+        Pool.AddTask(trace_task {Line, &Points[Index]});
+
+        if (++It == Charges.end())
+          It = Charges.begin();
+      }
+
+      UINT64 Start, End;
+
+      QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+      Pool.Run(Threads);
+      Pool.Wait();
+      QueryPerformanceCounter((LARGE_INTEGER *)&End);
+      Time = (End - Start) * 1000.0 / Freq;
+
+      UINT64 Hash {0xCBF29CE484222325};
+
+      for (const auto &Line : Points)
+        for (const auto &P : Line)
+          for (size_t i = 0; i < sizeof(P); i++)
+            Hash = (Hash ^ ((const BYTE *)&P)[i]) * 0x100000001B3;
+
+      return Hash;
+    };
+
+  /* Threads counts: powers of two and all cores */
+  const size_t MaxThreads {std::max<size_t>(std::thread::hardware_concurrency(), 1)};
+  std::vector<size_t> ThreadsCounts {};
+
+  for (size_t Threads = 1; Threads < MaxThreads; Threads *= 2)
+    ThreadsCounts.push_back(Threads);
+  ThreadsCounts.push_back(MaxThreads);
+
+  /* Deterministic mode and every supported kernels table */
+  const simd_kernels *const Tables[] {nullptr, &SimdKernelsSse42, &SimdKernelsAvx2, &SimdKernelsAvx512};
+  const size_t TablesCount {2 + (size_t)util::GetIsa()};
+
+  std::string Res {"Deterministic tracing self-check (" + std::to_string(Charges.Size()) + " charges, " + std::to_string(Lines) +
+                   " lines, up to " + std::to_string(Steps) + " steps, Runge-Kutta with post-normalization):\n"};
+  dbl DeterministicTime {0}, ActiveTime {0};
+  bool IsReproducible {true};
+
+  for (size_t t = 0; t < TablesCount; t++)
+  {
+    const simd_kernels *Table {Tables[t]};
+    UINT64 FirstHash {0};
+    bool IsEqual {true};
+    dbl SingleTime {0};
+
+    Res += Table == nullptr ? std::string {"  - deterministic:"} : "  - fast " + std::string {Table->Name} + ":";
+    for (const size_t Threads : ThreadsCounts)
+    {
+      dbl Time;
+      const UINT64 Hash {Trace(Table, Threads, Time)};
+      CHAR Buf[0x40];
+
+      if (Threads == 1)
+        FirstHash = Hash, SingleTime = Time;
+      IsEqual &= Hash == FirstHash;
+
+      sprintf(Buf, " %zu threads %016llX%s", Threads, Hash, Threads == MaxThreads ? "" : ",");
+      Res += Buf;
+    }
+
+    CHAR Buf[0x80];
+
+    sprintf(Buf, "\n      %s by threads, single thread %.3f ms\n", IsEqual ? "identical" : "DIFFERENT", SingleTime);
+    Res += Buf;
+
+    if (Table == nullptr)
+      DeterministicTime = SingleTime, IsReproducible = IsEqual;
+    else if (Table == &GetSimdKernels())
+      ActiveTime = SingleTime;
   }
 
-  coordf Tmp;
-  _mm_store_sd((dbl *)&Tmp, _mm_castps_pd(_mm_cvtpd_ps(Pos)));
+  CHAR Buf[0x100];
 
-  return Tmp;
-} /* End of 'ef_force_line::Next4' function */
+  sprintf(Buf, "  Deterministic mode %s, cost %.2fx of active %s kernels time (fast kernels hashes may differ by instruction set: summation order and fused multiply-add)\n",
+          IsReproducible ? "is reproducible" : "IS NOT REPRODUCIBLE", DeterministicTime / std::max(ActiveTime, 1e-9), GetSimdKernels().Name);
+  Res += Buf;
+
+  return Res;
+} /* End of 'prj::phys::BenchmarkDeterminism' function */
 
 /* END OF 'ef_force_lines.cpp' FILE */
@@ -2,40 +2,173 @@
  * PURPOSE     : Physics module.
  *               Electric field force lines evaluation class handle file
  * PROGRAMMER  : Fedor Borodulin.
- * LAST UPDATE : 10.04.2023.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : Module namespace 'prj::phys'.
  */
 
 #ifndef __ef_force_lines_h__
 #define __ef_force_lines_h__
 
-#include "physics_def.h"
+#include "ef_ewald.h"
+#include "ef_kernels.h"
 
 /* Project namespace // Physics module */
 namespace prj::phys
 {
+  /* Force line evaluation termination reasons enum */
+  enum class line_end : UINT
+  {
+    None,     /* Line is still evaluated */
+    Charge,   /* Line reached negative (positive for backward line) charge */
+    FarField, /* Line is finished with straight ray in monopole far field */
+    Null,     /* Line reached field null point neighbourhood */
+    Stall,    /* Line net displacement over steps window is too small */
+    Separation, /* Line came closer than separation distance to other line (evenly spaced lines) */
+    Boundary, /* Line reached grounded conductor boundary */
+    Length,   /* Line points limit reached */
+    Count     /* Reasons count */
+  }; /* end of 'line_end' enum */
+
+  /* Charges cluster (far field monopole approximation) parameters.
+   * Evaluated once per charges change and shared by all lines, so line construction does not pass over charges.
+   */
+  struct charges_cluster
+  {
+    coordd Center {0, 0}; /* Charges bounding circle center */
+    dbl Radius {1};       /* Charges bounding circle radius (with sources extents, not less than 1) */
+    dbl Charge {0};       /* Total charge (multipoles have zero total charge) */
+
+    /* Default constructor */
+    charges_cluster( void ) = default;
+
+    /* Constructor from charges pool.
+     * ARGUMENTS:
+     *   - Charges pool:
+     *       const charge_pool &Charges;
+     */
+    charges_cluster( const charge_pool &Charges );
+  }; /* end of 'charges_cluster' structure */
+
+  /* Line sink (charge which finishes line) */
+  struct line_sink
+  {
+    coordd Coord;          /* Sink center */
+    dbl Radius2;           /* Squared reaching radius around center */
+    const charge *Source;  /* Extended source reached on its contour (nullptr - center is checked) */
+  }; /* end of 'line_sink' structure */
+
+  /* Force lines shared environment: charges cluster, point charges with their boundary images packed for step kernels,
+   * extended sources elements and lines sinks. Built once per charges (or boundary) change and referenced by all lines,
+   * so it must live unchanged (with its charges pool) while lines are evaluated.
+   */
+  struct line_environment
+  {
+    /* Charges cluster (far field parameters) */
+    charges_cluster Cluster {};
+
+    /* Grounded conductor boundary (charges images are added to force) */
+    boundary Boundary {};
+
+    /* Point charges with their boundary images (screened charges are dropped), real count
+     * and padding to widest kernels vector width with zero charges far away */
+    std::vector<dbl> PackX {}, PackY {}, PackQ {};
+    size_t PackCount {0};
+    static constexpr size_t PackWidth {8};
+
+    /* Extended sources analytic elements (with boundary images) */
+    source_elements Sources {};
+
+    /* Line sinks for lines along field (negative charges) and for backward lines (positive charges),
+     * multipoles are sinks for both directions */
+    std::vector<line_sink> Sinks[2] {};
+
+    /* Default constructor */
+    line_environment( void ) = default;
+
+    /* Constructor from charges pool.
+     * ARGUMENTS:
+     *   - Charges pool:
+     *       const charge_pool &Charges;
+     *   - Grounded conductor boundary (default: none):
+     *       const boundary &NewBoundary;
+     */
+    line_environment( const charge_pool &Charges, const boundary &NewBoundary = {} );
+  }; /* end of 'line_environment' structure */
+
   /* Field line points sequence evaluator */
   class ef_force_line
   {
   private:
-    /* Current position */
-    dbl Pos[2];
+    /* Current position (packed data is aligned for SSE loads) */
+    alignas(16) dbl Pos[2];
   
     /* Evaluation environment */
-    const std::list<charge> &Charges;
+    const charge_pool &Charges;
   
     /* Auxilary packed data */
-    dbl
+    alignas(16) dbl
       LengthPack[2];
 
-    const dbl
-      HalfPack[2] {0.5, 0.5},
-      Rev3[2] {1 / 3.0, 1 / 3.0},
-      Rev6[2] {1 / 6.0, 1 / 6.0};
+    /* Tracing direction (1 - along field, -1 - backward) */
+    dbl Direction {1};
+
+    /* Charges cluster center, squared far field distance and total charge */
+    alignas(16) dbl
+      FarCenter[2] {0, 0};
+    dbl
+      FarDist2 {0},
+      FarCharge {0};
+
+    /* Far field rays bounding box */
+    dbl
+      BoundsMin[2] {-1e4, -1e4},
+      BoundsMax[2] {1e4, 1e4};
+
+    /* Far field distance (in cluster radiuses) and line direction to radial direction minimal cosine */
+    static constexpr dbl
+      FarFieldRadius {4},
+      FarFieldCos {0.999};
+
+    /* Periodic lattice evaluator (nullptr - charges are isolated) */
+    const ewald_sum *Periodic {nullptr};
+
+    /* Shared environment (charges images, sources, sinks and packed charges) */
+    const line_environment *Env {nullptr};
+
+    /* Field null points and their neighbourhood squared radius */
+    const std::vector<coordd> *Nulls {nullptr};
+    dbl NullRadius2 {0};
+
+    /* Stall detection window start position and steps */
+    dbl WindowStart[2];
+    UINT WindowSteps {0};
+
+    /* Stall detection window length and minimal net displacement (in window path length) */
+    static constexpr UINT StallWindow {32};
+    static constexpr dbl StallMinPart {0.1};
+
+    /* Environment packed charges count padded to kernel bucket */
+    size_t PackCount {0};
+
+    /* Step offset kernel (for Euler, Runge-Kutta, Runge-Kutta with post-normalization
+     * and Runge-Kutta with normalized forces methods, taken from active instruction set level kernels) */
+    line_step_kernel StepKernels[4] {};
+
+    /* Step kernels evaluate whole force by callback (charges pool kernels) flag */
+    bool IsListKernels {false};
+
+    /* Step kernels table (nullptr - active instruction set level one) */
+    const simd_kernels *Kernels {nullptr};
   
   public:
     /* Evaluations continuing flag */
     bool Continue {true};
+
+    /* Evaluation termination reason */
+    line_end Reason {line_end::None};
+
+    /* Evaluated steps count */
+    size_t Steps {0};
   
   private:
     /* Force evaluation function
@@ -45,55 +178,61 @@ namespace prj::phys
      * RETURNS:
      *   (__m128d) Force vector.
      */
-    __m128d __vectorcall EvalForce( __m128d PosVec );
+    __m128d __vectorcall EvalForce( __m128d PosVec ) const;
 
-    /* Normalized force evaluation function.
+    /* Whole force callback for charges pool step kernels.
      * ARGUMENTS:
-     *    - Position:
-     *        __m128d PosVec;
+     *   - Force line:
+     *       const void *Line;
+     *   - Position:
+     *       __m128d Pos;
      * RETURNS:
      *   (__m128d) Force vector.
      */
-    inline __m128d __vectorcall EvalForceNorm( __m128d PosVec )
-    {
-      auto Force = EvalForce(PosVec);
-  
-      auto ForceLen = _mm_mul_pd(Force, Force);
-      ForceLen = _mm_hadd_pd(ForceLen, ForceLen);
-  
-      return _mm_div_pd(Force, _mm_sqrt_pd(ForceLen));
-    } /* End of 'EvalForceNorm' function */
-  
-    /* Length multiplied force evaluation function.
+    static __m128d __vectorcall ListForce( const void *Line, __m128d Pos );
+
+    /* Extended sources force callback for packed charges step kernels.
      * ARGUMENTS:
-     *    - Position:
-     *        __m128d PosVec;
+     *   - Extended sources elements:
+     *       const void *Elements;
+     *   - Position:
+     *       __m128d Pos;
      * RETURNS:
      *   (__m128d) Force vector.
      */
-    inline __m128d __vectorcall EvalForceLen( __m128d PosVec )
-    {
-      auto Force = EvalForce(PosVec);
-  
-      return _mm_mul_pd(Force, _mm_load_pd(LengthPack));
-    } /* End of 'EvalForceLen' function */
-  
-    /* Normalized and length multiplied force evaluation function.
+    static __m128d __vectorcall SourcesForce( const void *Elements, __m128d Pos );
+
+    /* Step kernels selection function (called once before first step) */
+    void SelectKernels( void );
+
+    /* Next point evaluation function.
      * ARGUMENTS:
-     *    - Position:
-     *        __m128d PosVec;
+     *   - Method index (in 'StepKernels'):
+     *       INT Method;
      * RETURNS:
-     *   (__m128d) Force vector.
+     *   (coordf) Next coordinate.
      */
-    inline __m128d __vectorcall EvalForceNormLen( __m128d PosVec )
+    coordf Advance( INT Method );
+
+    /* Nearest charge (or null point) image offset evaluation function.
+     * ARGUMENTS:
+     *   - Offset to cell content point:
+     *       __m128d Dir;
+     * RETURNS:
+     *   (__m128d) Offset to nearest image (same offset for isolated charges).
+     */
+    inline __m128d __vectorcall WrapOffset( __m128d Dir ) const
     {
-      auto Force = EvalForce(PosVec);
-  
-      auto ForceLen = _mm_mul_pd(Force, Force);
-      ForceLen = _mm_hadd_pd(ForceLen, ForceLen);
-  
-      return _mm_div_pd(_mm_mul_pd(Force, _mm_load_pd(LengthPack)), _mm_sqrt_pd(ForceLen));
-    } /* End of 'EvalForceNormLen' function */
+      if (Periodic == nullptr)
+        return Dir;
+
+      alignas(16) dbl D[2];
+
+      _mm_store_pd(D, Dir);
+      Periodic->Wrap(D[0], D[1]);
+
+      return _mm_load_pd(D);
+    } /* End of 'WrapOffset' function */
 
     /* Charges intersection check
      * ARGUMENTS:
@@ -104,31 +243,84 @@ namespace prj::phys
      */
     inline __m128d __vectorcall CheckIntersection( __m128d Pos )
     {
-      for (const auto &Elm : Charges)
+      /* Grounded conductor is sink for lines of both directions */
+      if (Env->Boundary.IsValid())
       {
-        if ((*(UINT64 *)&Elm.Charge) & (1ui64 << 63))
+        alignas(16) dbl P[2];
+
+        _mm_store_pd(P, Pos);
+        if (Env->Boundary.Distance({P[0], P[1]}) <= 0)
         {
-          const auto ElmCoord {_mm_load_pd((dbl *)&Elm.Coord)};
-          auto Dir = _mm_sub_pd(Pos, ElmCoord);
+          const coordd End {Env->Boundary.Project({P[0], P[1]})};
+
+          Continue = false;
+          Reason = line_end::Boundary;
+
+          return _mm_set_pd(End.Y, End.X);
+        }
+      }
+
+      for (const auto &Sink : Env->Sinks[Direction < 0])
+      {
+        auto Dir = WrapOffset(_mm_sub_pd(Pos, _mm_loadu_pd((dbl *)&Sink.Coord)));
 
-          auto Len = _mm_mul_pd(Dir, Dir);
-          Len = _mm_hadd_pd(Len, Len);
+        /* Line ends in reached charge image */
+        const auto ElmCoord {_mm_sub_pd(Pos, Dir)};
 
-          auto Size = _mm_set_sd(Elm.Size * 2.0);
-          Size = _mm_mul_sd(Size, Size);
+        /* Extended sink is reached on its seed contour, line ends in nearest source point */
+        if (Sink.Source != nullptr)
+        {
+          const auto &Elm {*Sink.Source};
+          alignas(16) dbl D[2];
+          coordd Nearest;
 
-          if (_mm_comile_sd(Len, Size))
+          _mm_store_pd(D, Dir);
+          if (SourceDistance(Elm, {Elm.Coord.X + D[0], Elm.Coord.Y + D[1]}, &Nearest) <= Elm.Size * 2.0)
           {
             Continue = false;
-            Pos = ElmCoord;
+            Reason = line_end::Charge;
+            Pos = _mm_add_pd(ElmCoord, _mm_set_pd(Nearest.Y - Elm.Coord.Y, Nearest.X - Elm.Coord.X));
 
             break;
           }
+          continue;
+        }
+
+        auto Len = _mm_mul_pd(Dir, Dir);
+        Len = _mm_hadd_pd(Len, Len);
+
+        if (_mm_comile_sd(Len, _mm_set_sd(Sink.Radius2)))
+        {
+          Continue = false;
+          Reason = line_end::Charge;
+          Pos = ElmCoord;
+
+          break;
         }
       }
 
       return Pos;
     } /* End of 'CheckIntersection' function */
+
+    /* Far field reaching check (line is finished with analytic ray to bounds)
+     * ARGUMENTS:
+     *   - Position:
+     *       __m128d Pos;
+     *   - Last step direction:
+     *       __m128d Step;
+     * RETURNS:
+     *   (__m128d) New position.
+     */
+    __m128d __vectorcall CheckFarField( __m128d Pos, __m128d Step );
+
+    /* Null points neighbourhood reaching and stall check
+     * ARGUMENTS:
+     *   - Position:
+     *       __m128d Pos;
+     * RETURNS:
+     *   (__m128d) New position.
+     */
+    __m128d __vectorcall CheckStall( __m128d Pos );
   
   public:
     /* Default constructor
@@ -138,18 +330,104 @@ namespace prj::phys
      *   - Movement length coefficient:
      *       double LengthCoeff;
      *   - Charges pool:
-     *        const std::list<charge> &ChargesPool;
+     *        const charge_pool &ChargesPool;
+     *   - Charges pool shared environment (must live while line is evaluated):
+     *        const line_environment &Environment;
      */
     ef_force_line( const coordd &BasePos, double LengthCoeff,
-                const std::list<charge> &ChargesPool ) :
+                const charge_pool &ChargesPool, const line_environment &Environment ) :
       Pos {BasePos.X, BasePos.Y},
       Charges {ChargesPool},
-      LengthPack {LengthCoeff, LengthCoeff}
-    { }
+      LengthPack {LengthCoeff, LengthCoeff},
+      FarCenter {Environment.Cluster.Center.X, Environment.Cluster.Center.Y},
+      FarCharge {Environment.Boundary.IsValid() ? 0 : Environment.Cluster.Charge},
+      Env {&Environment},
+      WindowStart {BasePos.X, BasePos.Y}
+    {
+      FarDist2 = Environment.Cluster.Radius * FarFieldRadius;
+      FarDist2 *= FarDist2;
+    } /* End of constructor */
+
+    /* Far field rays bounding box setting function.
+     * ARGUMENTS:
+     *   - Box corners:
+     *       const coordd &Min, &Max;
+     */
+    void SetBounds( const coordd &Min, const coordd &Max )
+    {
+      BoundsMin[0] = Min.X, BoundsMin[1] = Min.Y;
+      BoundsMax[0] = Max.X, BoundsMax[1] = Max.Y;
+    } /* End of 'SetBounds' function */
+
+    /* Periodic lattice setting function (lines are traced across cells, far field rays are disabled).
+     * ARGUMENTS:
+     *   - Lattice evaluator (must live while line is evaluated):
+     *       const ewald_sum *Lattice;
+     */
+    void SetPeriodic( const ewald_sum *Lattice )
+    {
+      Periodic = Lattice;
+      StepKernels[0] = nullptr;
+      if (Periodic != nullptr)
+        FarCharge = 0;
+    } /* End of 'SetPeriodic' function */
+
+    /* Field null points setting function.
+     * ARGUMENTS:
+     *   - Null points (must live while line is evaluated):
+     *       const std::vector<coordd> *NullPoints;
+     *   - Null point neighbourhood radius:
+     *       dbl Radius;
+     */
+    void SetNulls( const std::vector<coordd> *NullPoints, dbl Radius )
+    {
+      Nulls = NullPoints;
+      NullRadius2 = Radius * Radius;
+    } /* End of 'SetNulls' function */
+
+    /* Backward (against field) tracing setting function */
+    void SetBackward( void )
+    {
+      Direction = -1;
+      LengthPack[0] = -LengthPack[0], LengthPack[1] = -LengthPack[1];
+      StepKernels[0] = nullptr;
+    } /* End of 'SetBackward' function */
+
+    /* Evaluation after far field ray to old bounds resuming function */
+    void Resume( void )
+    {
+      if (Reason == line_end::FarField)
+        Continue = true, Reason = line_end::None;
+    } /* End of 'Resume' function */
+
+    /* Charges pool step kernels forcing function (reference path for benchmark) */
+    void SetListKernels( void );
+
+    /* Step kernels table setting function.
+     * ARGUMENTS:
+     *   - Kernels table (must be static one of 'SimdKernels***'):
+     *       const simd_kernels &Table;
+     */
+    void SetKernels( const simd_kernels &Table )
+    {
+      Kernels = &Table;
+      StepKernels[0] = nullptr;
+    } /* End of 'SetKernels' function */
+
+    /* Bit-reproducible tracing setting function.
+     * Charges are summed by SSE kernels: two lane accumulators (even and odd packed charges) in packing order,
+     * reduced once per force, without fused multiply-add. Order does not depend on active vector width,
+     * so line points are equal on every x64 processor and for any threads count (line is traced by single task).
+     * Cost is vector width: steps are up to about 1.2x slower than AVX2 and AVX-512 kernels (see 'BenchmarkDeterminism').
+     */
+    void SetDeterministic( void )
+    {
+      SetKernels(SimdKernelsSse42);
+    } /* End of 'SetDeterministic' function */
   
     /* Different implementations of next point getting function */
     /* Next point evaluation function.
-     * Standard version.
+     * Euler method with normalized force (fast low precision version).
      * RETURNS:
      *   (coordf) Next coordinate.
      */
@@ -176,6 +454,26 @@ namespace prj::phys
      */
     coordf Next4( void );
   }; /* end of 'ef_force_line' class */
+
+  /* Force line step latency by charges count (unrolled packed kernels versus charges pool kernel) benchmark function.
+   * ARGUMENTS:
+   *   - Steps per charges count:
+   *       size_t Steps;
+   * RETURNS:
+   *   (std::string) Report.
+   */
+  std::string BenchmarkLineSteps( size_t Steps );
+
+  /* Deterministic tracing self-check (line points hash by threads count and kernels table) function.
+   * ARGUMENTS:
+   *   - Lines count:
+   *       size_t Lines;
+   *   - Steps per line:
+   *       size_t Steps;
+   * RETURNS:
+   *   (std::string) Report.
+   */
+  std::string BenchmarkDeterminism( size_t Lines, size_t Steps );
 } /* end of 'prj::phys' namespace */
 
 #endif /* __ef_force_lines_h__ */
@@ -0,0 +1,422 @@
+/* FILE NAME   : 'ef_heatmap.cpp'
+ * PURPOSE     : Physics module.
+ *               Field magnitude / potential heatmap rasterizer implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#include <pch.h>
+
+#include "ef_heatmap.h"
+#include "utility/cpu_isa/cpu_isa.h"
+#include "utility/threads_pool/threads_pool.hpp"
+
+using namespace prj::phys;
+
+/* Field length logarithmic scale range and potential scale */
+static constexpr flt
+  FieldLogMin {-3.5f},
+  FieldLogMax {0.5f},
+  PotentialScale {0.5f};
+
+/* Rounding down integer division function.
+ * ARGUMENTS:
+ *   - Dividend and divisor:
+ *       INT A, B;
+ * RETURNS:
+ *   (INT) Quotient.
+ */
+static inline INT FloorDiv( INT A, INT B )
+{
+  return A >= 0 ? A / B : -((-A + B - 1) / B);
+} /* End of 'FloorDiv' function */
+
+/* Linear color interpolation to BGRA function.
+ * ARGUMENTS:
+ *   - Colors (RGB in [0;1]):
+ *       const flt (&C0)[3], (&C1)[3];
+ *   - Interpolation parameter:
+ *       flt T;
+ * RETURNS:
+ *   (DWORD) Color.
+ */
+static DWORD LerpColor( const flt (&C0)[3], const flt (&C1)[3], flt T )
+{
+  DWORD Res {0xFF000000};
+
+  for (INT i = 0; i < 3; i++)
+    Res |= (DWORD)((C0[i] + (C1[i] - C0[i]) * T) * 255.f + 0.5f) << (16 - 8 * i);
+
+  return Res;
+} /* End of 'LerpColor' function */
+
+/* Default constructor */
+heatmap::heatmap( void )
+{
+  /* Pale palettes, so force lines stay visible above */
+  static const flt
+    White[3] {1.f, 1.f, 1.f},
+    Strong[3] {.42f, .5f, .78f},
+    Negative[3] {.55f, .68f, 1.f},
+    Positive[3] {1.f, .6f, .55f};
+
+  for (INT i = 0; i < 256; i++)
+  {
+    const flt T {i / 255.f};
+
+    Palette[(size_t)heatmap_mode::None][i] = 0xFFFFFFFF;
+    Palette[(size_t)heatmap_mode::Field][i] = LerpColor(White, Strong, T);
+    Palette[(size_t)heatmap_mode::Potential][i] =
+      T < .5f ? LerpColor(Negative, White, T * 2) : LerpColor(White, Positive, T * 2 - 1);
+  }
+} /* End of 'heatmap::heatmap' function */
+
+/* Value mode setting function.
+ * ARGUMENTS:
+ *   - New mode:
+ *       heatmap_mode NewMode;
+ */
+void heatmap::SetMode( heatmap_mode NewMode )
+{
+  if (Mode != NewMode)
+  {
+    Mode = NewMode;
+    Tiles.clear();
+  }
+} /* End of 'heatmap::SetMode' function */
+
+/* Charges changing (all tiles invalidation) function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Periodic lattice evaluator (default: nullptr - charges are isolated, must live while heatmap is updated):
+ *       const ewald_sum *Periodic;
+ *   - Grounded conductor boundary (default: none):
+ *       const boundary &Boundary;
+ */
+void heatmap::Invalidate( const charge_pool &Charges, const ewald_sum *Periodic, const boundary &Boundary )
+{
+  Snapshot = field_snapshot {Charges, Periodic, Boundary};
+  Tiles.clear();
+} /* End of 'heatmap::Invalidate' function */
+
+/* Tile refinement to next sampling step function.
+ * ARGUMENTS:
+ *   - Tile:
+ *       tile &Tile;
+ */
+void heatmap::RefineTile( tile &Tile ) const
+{
+  const INT
+    OldStep {Tile.Step},
+    NewStep {OldStep == 0 ? CoarseStep : OldStep >> 1};
+
+  if (Tile.Values.empty())
+    Tile.Values.resize(TileSize * TileSize);
+
+  /* Charges relative to tile origin keep single precision accurate far from world center */
+  const dbl
+    OriginX {(dbl)Tile.X * TileSize * PixelW},
+    OriginY {(dbl)Tile.Y * TileSize * PixelH};
+  const bool IsField {Mode == heatmap_mode::Field};
+
+  /* Lattice field has no per-charge kernel, boundary images and extended sources are evaluated by snapshot kernel,
+   * per-charge kernel is AVX2 one - new samples are evaluated in one batch */
+  if (Snapshot.Periodic != nullptr || Snapshot.Boundary.IsValid() || Snapshot.HasSources() ||
+      prj::util::GetIsa() < prj::util::isa::Avx2)
+  {
+    std::vector<coordd> Points {};
+    std::vector<INT> Indices {};
+
+    for (INT j = 0; j < TileSize; j += NewStep)
+      for (INT i = 0; i < TileSize; i += NewStep)
+        if (OldStep == 0 || j % OldStep != 0 || i % OldStep != 0)
+        {
+          Points.push_back({OriginX + (i + .5) * PixelW, OriginY + (j + .5) * PixelH});
+          Indices.push_back(j * TileSize + i);
+        }
+
+    std::vector<dbl> A(Points.size()), B(Points.size());
+    field_out Out {};
+
+    if (IsField)
+      Out.Ex = A.data(), Out.Ey = B.data();
+    else
+      Out.Phi = A.data();
+    EvalField(Snapshot, Points.data(), Points.size(), Out);
+
+    for (size_t k = 0; k < Points.size(); k++)
+      Tile.Values[Indices[k]] = (flt)(IsField ? hypot(A[k], B[k]) : A[k]);
+
+    Tile.Step = NewStep;
+    return;
+  }
+
+  const size_t Count {Snapshot.Count};
+  std::vector<flt> CX(Count), CY(Count), CQ(Count);
+
+  for (size_t c = 0; c < Count; c++)
+  {
+    CX[c] = (flt)(Snapshot.X[c] - OriginX);
+    CY[c] = (flt)(Snapshot.Y[c] - OriginY);
+    CQ[c] = (flt)Snapshot.Q[c];
+  }
+
+  const auto
+    StepX {_mm256_set1_ps((flt)PixelW)},
+    HalfOne {_mm256_set1_ps(.5f)},
+    One {_mm256_set1_ps(1.f)};
+
+  for (INT j = 0; j < TileSize; j += NewStep)
+  {
+    /* Samples of previous step are already evaluated */
+    const bool IsOldRow {OldStep != 0 && j % OldStep == 0};
+    INT Columns[TileSize], ColumnsCount {0};
+
+    for (INT i = 0; i < TileSize; i += NewStep)
+      if (!IsOldRow || i % OldStep != 0)
+        Columns[ColumnsCount++] = i;
+
+    const auto PY {_mm256_set1_ps((flt)((j + .5) * PixelH))};
+
+    /* SIMD over 8 row pixels */
+    for (INT k = 0; k < ColumnsCount; k += 8)
+    {
+      alignas(32) INT Lanes[8];
+      alignas(32) flt Res[8];
+
+      for (INT l = 0; l < 8; l++)
+        Lanes[l] = Columns[std::min(k + l, ColumnsCount - 1)];
+
+      const auto PX {_mm256_mul_ps(_mm256_add_ps(_mm256_cvtepi32_ps(_mm256_load_si256((const __m256i *)Lanes)), HalfOne), StepX)};
+      auto Ex {_mm256_setzero_ps()}, Ey {Ex}, Phi {Ex};
+
+      for (size_t c = 0; c < Count; c++)
+      {
+        const auto
+          DX {_mm256_sub_ps(PX, _mm256_set1_ps(CX[c]))},
+          DY {_mm256_sub_ps(PY, _mm256_set1_ps(CY[c]))},
+          Q {_mm256_set1_ps(CQ[c])},
+          RevR {_mm256_div_ps(One, _mm256_sqrt_ps(_mm256_fmadd_ps(DX, DX, _mm256_mul_ps(DY, DY))))};
+
+        if (IsField)
+        {
+          const auto QR3 {_mm256_mul_ps(Q, _mm256_mul_ps(RevR, _mm256_mul_ps(RevR, RevR)))};
+
+          Ex = _mm256_fmadd_ps(QR3, DX, Ex);
+          Ey = _mm256_fmadd_ps(QR3, DY, Ey);
+        }
+        else
+          Phi = _mm256_fmadd_ps(Q, RevR, Phi);
+      }
+
+      _mm256_store_ps(Res, IsField ? _mm256_sqrt_ps(_mm256_fmadd_ps(Ex, Ex, _mm256_mul_ps(Ey, Ey))) : Phi);
+
+      for (INT l = 0; l < 8 && k + l < ColumnsCount; l++)
+        Tile.Values[j * TileSize + Lanes[l]] = Res[l];
+    }
+  }
+
+  Tile.Step = NewStep;
+} /* End of 'heatmap::RefineTile' function */
+
+/* Tile colors update function.
+ * ARGUMENTS:
+ *   - Tile:
+ *       tile &Tile;
+ */
+void heatmap::ColorTile( tile &Tile ) const
+{
+  const INT Step {Tile.Step};
+  const DWORD *Colors {Palette[(size_t)Mode]};
+
+  Tile.Colors.resize(TileSize * TileSize);
+
+  for (INT j = 0; j < TileSize; j += Step)
+    for (INT i = 0; i < TileSize; i += Step)
+    {
+      const flt Value {Tile.Values[j * TileSize + i]};
+      flt T;
+
+      if (Mode == heatmap_mode::Field)
+        T = (log10f(Value) - FieldLogMin) / (FieldLogMax - FieldLogMin);
+      else
+        T = .5f + .5f * tanhf(Value / PotentialScale);
+
+      /* Charge centers give infinite or undefined values */
+      if (std::isnan(T))
+        T = 1;
+
+      const DWORD Color {Colors[(size_t)(std::clamp(T, 0.f, 1.f) * 255.f)]};
+
+      /* Not evaluated pixels take nearest sample */
+      for (INT y = j; y < j + Step; y++)
+        std::fill_n(Tile.Colors.begin() + y * TileSize + i, Step, Color);
+    }
+} /* End of 'heatmap::ColorTile' function */
+
+/* Single refinement pass for view function.
+ * ARGUMENTS:
+ *   - View:
+ *       const heatmap_view &View;
+ * RETURNS:
+ *   (bool) true if any tile was changed.
+ */
+bool heatmap::Update( const heatmap_view &View )
+{
+  if (Mode == heatmap_mode::None || View.Width <= 0 || View.Height <= 0)
+    return false;
+
+  /* Tiles are valid only for same pixels lattice */
+  if (abs(View.PixelW - PixelW) > PixelW * 1e-9 || abs(View.PixelH - PixelH) > PixelH * 1e-9)
+  {
+    Tiles.clear();
+    PixelW = View.PixelW, PixelH = View.PixelH;
+  }
+
+  const INT
+    X0 {(INT)llround(View.Left / PixelW)},
+    Y0 {(INT)llround(View.Bottom / PixelH)},
+    TileX0 {FloorDiv(X0, TileSize)},
+    TileY0 {FloorDiv(Y0, TileSize)},
+    TileX1 {FloorDiv(X0 + View.Width - 1, TileSize)},
+    TileY1 {FloorDiv(Y0 + View.Height - 1, TileSize)};
+
+  /* Tiles far from view are dropped */
+  std::erase_if(Tiles, [&]( const auto &Elm ) -> bool
+    {
+      const tile &Tile {Elm.second};
+
+      return Tile.X < TileX0 - 1 || Tile.X > TileX1 + 1 || Tile.Y < TileY0 - 1 || Tile.Y > TileY1 + 1;
+    });
+
+  std::vector<tile *> Work {};
+
+  for (INT y = TileY0; y <= TileY1; y++)
+    for (INT x = TileX0; x <= TileX1; x++)
+    {
+      auto [It, IsNew] {Tiles.try_emplace(TileKey(x, y), tile {x, y, 0, {}, {}})};
+
+      if (It->second.Step != 1)
+        Work.push_back(&It->second);
+      else if (X0 != LastX0 || Y0 != LastY0)
+        Stats.TilesReused++;
+    }
+
+  LastX0 = X0, LastY0 = Y0;
+
+  if (Work.empty())
+    return false;
+
+  UINT64 Freq, Start, End;
+
+  QueryPerformanceFrequency((LARGE_INTEGER *)&Freq);
+  QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+
+  {
+    prj::util::threads_pool<tile *> Pool {[&]( tile **Tile ) -> bool
+      {
+        RefineTile(**Tile);
+        ColorTile(**Tile);
+        return true;
+      }};
+
+    for (auto *Tile : Work)
+    {
+      const INT
+        Old {Tile->Step == 0 ? 0 : TileSize / Tile->Step},
+        New {Tile->Step == 0 ? TileSize / CoarseStep : Old * 2};
+
+      Stats.Pixels += (size_t)(New * New - Old * Old);
+      Pool.AddTask(Tile);
+    }
+
+    Pool.Run();
+    Pool.Wait();
+  }
+
+  QueryPerformanceCounter((LARGE_INTEGER *)&End);
+
+  Stats.Passes++;
+  Stats.TilesEvaluated += Work.size();
+  Stats.LastTime = (End - Start) * 1000.0 / Freq;
+
+  return true;
+} /* End of 'heatmap::Update' function */
+
+/* View pixels composing function.
+ * ARGUMENTS:
+ *   - View:
+ *       const heatmap_view &View;
+ *   - Output pixels (BGRA, View.Width * View.Height):
+ *       DWORD *Pixels;
+ */
+void heatmap::Compose( const heatmap_view &View, DWORD *Pixels ) const
+{
+  const INT
+    X0 {(INT)llround(View.Left / PixelW)},
+    Y0 {(INT)llround(View.Bottom / PixelH)};
+
+  for (INT y = 0; y < View.Height; y++)
+  {
+    const INT
+      TileY {FloorDiv(Y0 + y, TileSize)},
+      Row {Y0 + y - TileY * TileSize};
+    DWORD *Dst {Pixels + (size_t)y * View.Width};
+
+    /* Row is copied by tile spans */
+    for (INT x = 0; x < View.Width;)
+    {
+      const INT
+        TileX {FloorDiv(X0 + x, TileSize)},
+        Column {X0 + x - TileX * TileSize},
+        Span {std::min(TileSize - Column, View.Width - x)};
+      const auto It {Tiles.find(TileKey(TileX, TileY))};
+
+      if (It == Tiles.end() || It->second.Step == 0)
+        std::fill_n(Dst + x, Span, 0xFFFFFFFF);
+      else
+        std::copy_n(It->second.Colors.begin() + Row * TileSize + Column, Span, Dst + x);
+
+      x += Span;
+    }
+  }
+} /* End of 'heatmap::Compose' function */
+
+/* Headless full resolution rasterization function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Value mode:
+ *       heatmap_mode Mode;
+ *   - View:
+ *       const heatmap_view &View;
+ *   - Periodic lattice evaluator (default: nullptr - charges are isolated):
+ *       const ewald_sum *Periodic;
+ *   - Grounded conductor boundary (default: none):
+ *       const boundary &Boundary;
+ * RETURNS:
+ *   (std::vector<DWORD>) Pixels (BGRA).
+ */
+std::vector<DWORD> heatmap::Rasterize( const charge_pool &Charges, heatmap_mode Mode, const heatmap_view &View,
+                                       const ewald_sum *Periodic, const boundary &Boundary )
+{
+  heatmap Heatmap {};
+  std::vector<DWORD> Pixels((size_t)View.Width * View.Height, 0xFFFFFFFF);
+
+  if (Mode == heatmap_mode::None)
+    return Pixels;
+
+  Heatmap.SetMode(Mode);
+  Heatmap.Invalidate(Charges, Periodic, Boundary);
+
+  /* Refinement passes evaluate only new samples, so it costs same as single full resolution pass */
+  while (Heatmap.Update(View))
+    ;
+
+  Heatmap.Compose(View, Pixels.data());
+  return Pixels;
+} /* End of 'heatmap::Rasterize' function */
+
+/* END OF 'ef_heatmap.cpp' FILE */
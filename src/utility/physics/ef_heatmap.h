@@ -0,0 +1,195 @@
+/* FILE NAME   : 'ef_heatmap.h'
+ * PURPOSE     : Physics module.
+ *               Field magnitude / potential heatmap rasterizer handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#ifndef __ef_heatmap_h__
+#define __ef_heatmap_h__
+
+#include "ef_charges.h"
+#include "ef_field.h"
+
+/* Project namespace // Physics module */
+namespace prj::phys
+{
+  /* Heatmap value mode */
+  enum class heatmap_mode : UINT
+  {
+    None,      /* No heatmap */
+    Field,     /* Field length (logarithmic scale) */
+    Potential, /* Potential (signed scale) */
+    Count
+  }; /* end of 'heatmap_mode' enumeration */
+
+  /* Heatmap pixels view (pixel (0, 0) is at (Left, Bottom) corner) */
+  struct heatmap_view
+  {
+    dbl Left, Bottom;     /* World coordinates of first pixel corner */
+    dbl PixelW, PixelH;   /* Pixel size in world units */
+    INT Width, Height;    /* Size in pixels */
+  }; /* end of 'heatmap_view' structure */
+
+  /* Field heatmap rasterizer.
+   * Pixels are grouped to tiles anchored to world pixels lattice, so panning by whole pixels reuses tiles.
+   * Every refinement pass halves tiles sampling step (coarse first) and evaluates only new samples.
+   */
+  class heatmap
+  {
+  public:
+    /* Rasterizer statistics structure */
+    struct stats
+    {
+      size_t
+        Passes {0},          /* Refinement passes */
+        TilesEvaluated {0},  /* Tiles refinement steps */
+        TilesReused {0},     /* Tiles kept after view change */
+        Pixels {0};          /* Evaluated pixels */
+      dbl
+        LastTime {0};        /* Last pass time (in ms) */
+    }; /* end of 'stats' structure */
+
+  private:
+    /* Tile size in pixels and coarsest sampling step */
+    static constexpr INT TileSize {64}, CoarseStep {8};
+
+    /* Single tile data */
+    struct tile
+    {
+      INT X, Y;                   /* Tile indices in pixels lattice */
+      INT Step;                   /* Current sampling step (0 <=> not evaluated) */
+      std::vector<flt> Values;    /* Pixels values */
+      std::vector<DWORD> Colors;  /* Pixels colors (BGRA) */
+    }; /* end of 'tile' structure */
+
+    /* Value mode */
+    heatmap_mode Mode {heatmap_mode::None};
+
+    /* Charges snapshot */
+    field_snapshot Snapshot {};
+
+    /* Pixels lattice scale and last view first pixel indices */
+    dbl PixelW {0}, PixelH {0};
+    INT LastX0 {0}, LastY0 {0};
+
+    /* Tiles by packed indices */
+    std::unordered_map<UINT64, tile> Tiles {};
+
+    /* Color palettes by mode */
+    DWORD Palette[(size_t)heatmap_mode::Count][256] {};
+
+    /* Statistics */
+    stats Stats {};
+
+    /* Tile key evaluation function.
+     * ARGUMENTS:
+     *   - Tile indices:
+     *       INT X, Y;
+     * RETURNS:
+     *   (UINT64) Key.
+     */
+    static UINT64 TileKey( INT X, INT Y )
+    {
+      return ((UINT64)(UINT32)X << 32) | (UINT32)Y;
+    } /* End of 'TileKey' function */
+
+    /* Tile refinement to next sampling step function.
+     * ARGUMENTS:
+     *   - Tile:
+     *       tile &Tile;
+     */
+    void RefineTile( tile &Tile ) const;
+
+    /* Tile colors update function.
+     * ARGUMENTS:
+     *   - Tile:
+     *       tile &Tile;
+     */
+    void ColorTile( tile &Tile ) const;
+
+  public:
+    /* Default constructor */
+    heatmap( void );
+
+    /* Value mode setting function.
+     * ARGUMENTS:
+     *   - New mode:
+     *       heatmap_mode NewMode;
+     */
+    void SetMode( heatmap_mode NewMode );
+
+    /* Value mode getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (heatmap_mode) Mode.
+     */
+    heatmap_mode GetMode( void ) const
+    {
+      return Mode;
+    } /* End of 'GetMode' function */
+
+    /* Charges changing (all tiles invalidation) function.
+     * ARGUMENTS:
+     *   - Charges pool:
+     *       const charge_pool &Charges;
+     *   - Periodic lattice evaluator (default: nullptr - charges are isolated, must live while heatmap is updated):
+     *       const ewald_sum *Periodic;
+     *   - Grounded conductor boundary (default: none):
+     *       const boundary &Boundary;
+     */
+    void Invalidate( const charge_pool &Charges, const ewald_sum *Periodic = nullptr, const boundary &Boundary = {} );
+
+    /* Single refinement pass for view function.
+     * Tiles out of view are dropped, missing tiles are added, all visible tiles are refined once.
+     * ARGUMENTS:
+     *   - View:
+     *       const heatmap_view &View;
+     * RETURNS:
+     *   (bool) true if any tile was changed.
+     */
+    bool Update( const heatmap_view &View );
+
+    /* View pixels composing function.
+     * ARGUMENTS:
+     *   - View:
+     *       const heatmap_view &View;
+     *   - Output pixels (BGRA, View.Width * View.Height):
+     *       DWORD *Pixels;
+     */
+    void Compose( const heatmap_view &View, DWORD *Pixels ) const;
+
+    /* Headless full resolution rasterization function.
+     * ARGUMENTS:
+     *   - Charges pool:
+     *       const charge_pool &Charges;
+     *   - Value mode:
+     *       heatmap_mode Mode;
+     *   - View:
+     *       const heatmap_view &View;
+     *   - Periodic lattice evaluator (default: nullptr - charges are isolated):
+     *       const ewald_sum *Periodic;
+     *   - Grounded conductor boundary (default: none):
+     *       const boundary &Boundary;
+     * RETURNS:
+     *   (std::vector<DWORD>) Pixels (BGRA).
+     */
+    static std::vector<DWORD> Rasterize( const charge_pool &Charges, heatmap_mode Mode, const heatmap_view &View,
+                                         const ewald_sum *Periodic = nullptr, const boundary &Boundary = {} );
+
+    /* Statistics getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const stats &) Statistics.
+     */
+    const stats &GetStats( void ) const
+    {
+      return Stats;
+    } /* End of 'GetStats' function */
+  }; /* end of 'heatmap' class */
+} /* end of 'prj::phys' namespace */
+
+#endif /* __ef_heatmap_h__ */
+
+/* END OF 'ef_heatmap.h' FILE */
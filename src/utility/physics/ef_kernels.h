@@ -0,0 +1,96 @@
+/* FILE NAME   : 'ef_kernels.h'
+ * PURPOSE     : Physics module.
+ *               Instruction set specific vector kernels handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ *               Kernels are compiled in separate translation units for every instruction set level
+ *               ('ef_kernels_sse42.cpp', 'ef_kernels_avx2.cpp', 'ef_kernels_avx512.cpp'), so those units
+ *               must not call inline functions of shared headers (linker may keep their wider instruction set copy).
+ */
+
+#ifndef __ef_kernels_h__
+#define __ef_kernels_h__
+
+#include "ef_field.h"
+
+/* Project namespace // Physics module */
+namespace prj::phys
+{
+  /* Force line step kernel input */
+  struct line_step_data
+  {
+    /* Packed point charges (padded to kernel charges count with zero charges far away) and their count */
+    const dbl *X, *Y, *Q;
+    size_t Count;
+
+    /* Signed step length */
+    dbl Length;
+
+    /* Force evaluation callback (whole force for charges pool kernels,
+     * extended sources force for packed charges kernels, nullptr - no sources) and its context */
+    __m128d (__vectorcall *Force)( const void *Context, __m128d Pos );
+    const void *Context;
+  }; /* end of 'line_step_data' structure */
+
+  /* Force line step offset kernel pointer type */
+  using line_step_kernel = __m128d (__vectorcall *)( const line_step_data &Data, __m128d Pos );
+
+  /* Instruction set level kernels table */
+  struct simd_kernels
+  {
+    /* Instruction set level name */
+    const CHAR *Name;
+
+    /* Point charges field values for points array evaluation kernel (points are processed by vector width).
+     * ARGUMENTS:
+     *   - Point charges coordinates and values:
+     *       const dbl *X, *Y, *Q;
+     *   - Point charges count:
+     *       size_t Charges;
+     *   - Grounded conductor boundary (images are generated from charges, screened charges are skipped):
+     *       const boundary &Boundary;
+     *   - Query points:
+     *       const coordd *Points;
+     *   - Query points count:
+     *       size_t Count;
+     *   - Outputs (only requested are set):
+     *       const field_out &Out;
+     */
+    void (*FieldPoints)( const dbl *X, const dbl *Y, const dbl *Q, size_t Charges, const boundary &Boundary,
+                         const coordd *Points, size_t Count, const field_out &Out );
+
+    /* Packed charges step kernels (for Euler, Runge-Kutta, Runge-Kutta with post-normalization
+     * and Runge-Kutta with normalized forces methods) selection function.
+     * ARGUMENTS:
+     *   - Charges count:
+     *       size_t Count;
+     *   - Kernels (out):
+     *       line_step_kernel (&Kernels)[4];
+     * RETURNS:
+     *   (size_t) Charges count with padding required by selected kernels.
+     */
+    size_t (*SelectLineKernels)( size_t Count, line_step_kernel (&Kernels)[4] );
+
+    /* Force callback step kernels (lattice and reference path) getting function.
+     * ARGUMENTS:
+     *   - Kernels (out):
+     *       line_step_kernel (&Kernels)[4];
+     */
+    void (*ListLineKernels)( line_step_kernel (&Kernels)[4] );
+  }; /* end of 'simd_kernels' structure */
+
+  /* Kernels tables of all instruction set levels */
+  extern const simd_kernels SimdKernelsSse42, SimdKernelsAvx2, SimdKernelsAvx512;
+
+  /* Active instruction set level kernels table getting function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (const simd_kernels &) Kernels table.
+   */
+  const simd_kernels &GetSimdKernels( void );
+} /* end of 'prj::phys' namespace */
+
+#endif /* __ef_kernels_h__ */
+
+/* END OF 'ef_kernels.h' FILE */
@@ -0,0 +1,21 @@
+/* FILE NAME   : 'ef_kernels_avx2.cpp'
+ * PURPOSE     : Physics module.
+ *               AVX2 with FMA3 level vector kernels file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ *               Unit is compiled without precompiled header with its own instruction set option.
+ */
+
+#include <def.h>
+
+#define EF_KERNELS_AVX2
+#include "ef_kernels_impl.h"
+
+/* AVX2 with FMA3 level kernels table */
+const prj::phys::simd_kernels prj::phys::SimdKernelsAvx2
+{
+  "avx2", FieldPoints, SelectLineKernels, ListLineKernels
+};
+
+/* END OF 'ef_kernels_avx2.cpp' FILE */
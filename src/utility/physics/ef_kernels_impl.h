@@ -0,0 +1,579 @@
+/* FILE NAME   : 'ef_kernels_impl.h'
+ * PURPOSE     : Physics module.
+ *               Instruction set specific vector kernels implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ *               File is included once by every instruction set level unit after one of
+ *               'EF_KERNELS_SSE42', 'EF_KERNELS_AVX2', 'EF_KERNELS_AVX512' definitions.
+ *               All functions are static, so every unit has its own copies compiled for its level.
+ */
+
+#ifndef __ef_kernels_impl_h__
+#define __ef_kernels_impl_h__
+
+#include "ef_kernels.h"
+
+/* Project namespace // Physics module */
+namespace prj::phys
+{
+  /***
+   * Widest vector operations
+   ***/
+
+#if defined(EF_KERNELS_AVX512)
+  using vecd = __m512d;
+  static constexpr size_t VecWidth {8};
+#elif defined(EF_KERNELS_AVX2)
+  using vecd = __m256d;
+  static constexpr size_t VecWidth {4};
+#elif defined(EF_KERNELS_SSE42)
+  using vecd = __m128d;
+  static constexpr size_t VecWidth {2};
+#else
+#  error Kernels instruction set level is not defined
+#endif /* EF_KERNELS_*** */
+
+  /* Pair multiply-add function.
+   * ARGUMENTS:
+   *   - Multipliers and addend:
+   *       __m128d A, B, C;
+   * RETURNS:
+   *   (__m128d) A * B + C.
+   */
+  static inline __m128d __vectorcall FmAdd( __m128d A, __m128d B, __m128d C )
+  {
+#ifdef EF_KERNELS_SSE42
+    return _mm_add_pd(_mm_mul_pd(A, B), C);
+#else
+    return _mm_fmadd_pd(A, B, C);
+#endif /* EF_KERNELS_SSE42 */
+  } /* End of 'FmAdd' function */
+
+  /* Pair vector operations (SSE level and tails of wider levels) */
+  static inline __m128d __vectorcall Set1( __m128d, dbl V ) { return _mm_set1_pd(V); }
+  static inline __m128d __vectorcall Load( __m128d, const dbl *P ) { return _mm_loadu_pd(P); }
+  static inline void __vectorcall Store( dbl *P, __m128d A ) { _mm_storeu_pd(P, A); }
+  static inline __m128d __vectorcall Add( __m128d A, __m128d B ) { return _mm_add_pd(A, B); }
+  static inline __m128d __vectorcall Sub( __m128d A, __m128d B ) { return _mm_sub_pd(A, B); }
+  static inline __m128d __vectorcall Mul( __m128d A, __m128d B ) { return _mm_mul_pd(A, B); }
+  static inline __m128d __vectorcall Div( __m128d A, __m128d B ) { return _mm_div_pd(A, B); }
+  static inline __m128d __vectorcall Sqrt( __m128d A ) { return _mm_sqrt_pd(A); }
+
+  /* Components sums pair (sum of A, sum of B) evaluation function.
+   * ARGUMENTS:
+   *   - Vectors:
+   *       __m128d A, B;
+   * RETURNS:
+   *   (__m128d) Sums.
+   */
+  static inline __m128d __vectorcall SumPair( __m128d A, __m128d B )
+  {
+    return _mm_hadd_pd(A, B);
+  } /* End of 'SumPair' function */
+
+#if defined(EF_KERNELS_AVX2) || defined(EF_KERNELS_AVX512)
+  /* Quad vector operations (AVX2 level and tails of wider levels) */
+  static inline __m256d __vectorcall Set1( __m256d, dbl V ) { return _mm256_set1_pd(V); }
+  static inline __m256d __vectorcall Load( __m256d, const dbl *P ) { return _mm256_loadu_pd(P); }
+  static inline void __vectorcall Store( dbl *P, __m256d A ) { _mm256_storeu_pd(P, A); }
+  static inline __m256d __vectorcall Add( __m256d A, __m256d B ) { return _mm256_add_pd(A, B); }
+  static inline __m256d __vectorcall Sub( __m256d A, __m256d B ) { return _mm256_sub_pd(A, B); }
+  static inline __m256d __vectorcall Mul( __m256d A, __m256d B ) { return _mm256_mul_pd(A, B); }
+  static inline __m256d __vectorcall Div( __m256d A, __m256d B ) { return _mm256_div_pd(A, B); }
+  static inline __m256d __vectorcall Sqrt( __m256d A ) { return _mm256_sqrt_pd(A); }
+  static inline __m256d __vectorcall FmAdd( __m256d A, __m256d B, __m256d C ) { return _mm256_fmadd_pd(A, B, C); }
+
+  /* Components sums pair (sum of A, sum of B) evaluation function.
+   * ARGUMENTS:
+   *   - Vectors:
+   *       __m256d A, B;
+   * RETURNS:
+   *   (__m128d) Sums.
+   */
+  static inline __m128d __vectorcall SumPair( __m256d A, __m256d B )
+  {
+    /* (A0 + A1, B0 + B1, A2 + A3, B2 + B3) halves sum */
+    const auto Sum {_mm256_hadd_pd(A, B)};
+
+    return _mm_add_pd(_mm256_castpd256_pd128(Sum), _mm256_extractf128_pd(Sum, 1));
+  } /* End of 'SumPair' function */
+#endif /* EF_KERNELS_AVX2 || EF_KERNELS_AVX512 */
+
+#ifdef EF_KERNELS_AVX512
+  /* Octet vector operations (AVX-512 level) */
+  static inline __m512d __vectorcall Set1( __m512d, dbl V ) { return _mm512_set1_pd(V); }
+  static inline __m512d __vectorcall Load( __m512d, const dbl *P ) { return _mm512_loadu_pd(P); }
+  static inline void __vectorcall Store( dbl *P, __m512d A ) { _mm512_storeu_pd(P, A); }
+  static inline __m512d __vectorcall Add( __m512d A, __m512d B ) { return _mm512_add_pd(A, B); }
+  static inline __m512d __vectorcall Sub( __m512d A, __m512d B ) { return _mm512_sub_pd(A, B); }
+  static inline __m512d __vectorcall Mul( __m512d A, __m512d B ) { return _mm512_mul_pd(A, B); }
+  static inline __m512d __vectorcall Div( __m512d A, __m512d B ) { return _mm512_div_pd(A, B); }
+  static inline __m512d __vectorcall Sqrt( __m512d A ) { return _mm512_sqrt_pd(A); }
+  static inline __m512d __vectorcall FmAdd( __m512d A, __m512d B, __m512d C ) { return _mm512_fmadd_pd(A, B, C); }
+
+  /* Components sums pair (sum of A, sum of B) evaluation function.
+   * ARGUMENTS:
+   *   - Vectors:
+   *       __m512d A, B;
+   * RETURNS:
+   *   (__m128d) Sums.
+   */
+  static inline __m128d __vectorcall SumPair( __m512d A, __m512d B )
+  {
+    return SumPair(_mm256_add_pd(_mm512_castpd512_pd256(A), _mm512_extractf64x4_pd(A, 1)),
+                   _mm256_add_pd(_mm512_castpd512_pd256(B), _mm512_extractf64x4_pd(B, 1)));
+  } /* End of 'SumPair' function */
+#endif /* EF_KERNELS_AVX512 */
+
+  /* Point charges group field at point accumulation function.
+   * ARGUMENTS:
+   *   - Point (broadcasted):
+   *       vec PX, PY;
+   *   - Charges coordinates and values:
+   *       vec CX, CY, CQ;
+   *   - Field accumulators:
+   *       vec &Ex, &Ey;
+   */
+  template<typename vec>
+    static inline void __vectorcall AccumulateCharges( vec PX, vec PY, vec CX, vec CY, vec CQ, vec &Ex, vec &Ey )
+    {
+      const vec
+        DX {Sub(PX, CX)}, DY {Sub(PY, CY)},
+        R2 {FmAdd(DX, DX, Mul(DY, DY))},
+        QR3 {Div(CQ, Mul(R2, Sqrt(R2)))};
+
+      Ex = FmAdd(QR3, DX, Ex);
+      Ey = FmAdd(QR3, DY, Ey);
+    } /* End of 'AccumulateCharges' function */
+
+  /***
+   * Force line step kernels
+   ***/
+
+  /* Step offset evaluation function.
+   * ARGUMENTS:
+   *   - Force evaluation function:
+   *       force_func &&Force;
+   *   - Position:
+   *       __m128d Pos;
+   *   - Step length (packed):
+   *       __m128d LengthPack;
+   * RETURNS:
+   *   (__m128d) Step offset.
+   */
+  template<INT Method, typename force_func>
+    static inline __m128d __vectorcall StepOffset( force_func &&Force, __m128d Pos, __m128d LengthPack )
+    {
+      /* Normalized and length multiplied force */
+      auto NormLen = [&]( __m128d P )
+        {
+          const auto F {Force(P)};
+          auto FLen = _mm_mul_pd(F, F);
+
+          FLen = _mm_hadd_pd(FLen, FLen);
+          return _mm_div_pd(_mm_mul_pd(F, LengthPack), _mm_sqrt_pd(FLen));
+        };
+
+      /* Euler method with normalized force (fast low precision version) */
+      if constexpr (Method == 0)
+        return NormLen(Pos);
+      else
+      {
+        auto Stage = [&]( __m128d P )
+          {
+            if constexpr (Method == 1)
+              return _mm_mul_pd(Force(P), LengthPack);
+            else
+              return NormLen(P);
+          };
+
+        const auto HalfPack {_mm_set1_pd(0.5)}, Rev3 {_mm_set1_pd(1 / 3.0)}, Rev6 {_mm_set1_pd(1 / 6.0)};
+
+        auto Offset1 = Stage(Pos);
+        auto Offset2 = Stage(FmAdd(Offset1, HalfPack, Pos));
+        auto Offset3 = Stage(FmAdd(Offset2, HalfPack, Pos));
+        auto Offset4 = Stage(_mm_add_pd(Offset3, Pos));
+
+        auto Offset = FmAdd(Offset4, Rev6,
+                            FmAdd(Offset3, Rev3,
+                                  FmAdd(Offset2, Rev3,
+                                        _mm_mul_pd(Offset1, Rev6))));
+
+        /* Post-normalization */
+        if constexpr (Method == 2)
+        {
+          auto OffsetSqr = _mm_mul_pd(Offset, Offset);
+          Offset = _mm_div_pd(_mm_mul_pd(Offset, LengthPack), _mm_sqrt_pd(_mm_hadd_pd(OffsetSqr, OffsetSqr)));
+        }
+
+        return Offset;
+      }
+    } /* End of 'StepOffset' function */
+
+  /* Step offset by force callback evaluation kernel (lattice and reference path).
+   * ARGUMENTS:
+   *   - Step data:
+   *       const line_step_data &Data;
+   *   - Position:
+   *       __m128d Pos;
+   * RETURNS:
+   *   (__m128d) Step offset.
+   */
+  template<INT Method>
+    static __m128d __vectorcall StepList( const line_step_data &Data, __m128d Pos )
+    {
+      return StepOffset<Method>([&]( __m128d P ) { return Data.Force(Data.Context, P); }, Pos, _mm_set1_pd(Data.Length));
+    } /* End of 'StepList' function */
+
+  /* Step offset by packed charges evaluation kernel.
+   * Charges are loaded to registers once per step and charges loop is unrolled for all method stages:
+   * charges are processed by widest vectors, tail by quad, pair and single charge (Count = 0 - runtime count loop).
+   * ARGUMENTS:
+   *   - Step data:
+   *       const line_step_data &Data;
+   *   - Position:
+   *       __m128d Pos;
+   * RETURNS:
+   *   (__m128d) Step offset.
+   */
+  template<size_t Count, INT Method>
+    static __m128d __vectorcall StepPacked( const line_step_data &Data, __m128d Pos )
+    {
+      constexpr size_t Groups {Count / VecWidth}, Tail {Count % VecWidth};
+      constexpr size_t QuadAt {Groups * VecWidth}, PairAt {QuadAt + Tail / 4 * 4};
+
+      const dbl *X {Data.X}, *Y {Data.Y}, *Q {Data.Q};
+
+      /* Charges stay in registers for all method stages */
+      vecd GX[Groups > 0 ? Groups : 1], GY[Groups > 0 ? Groups : 1], GQ[Groups > 0 ? Groups : 1];
+#ifdef EF_KERNELS_AVX512
+      __m256d QuadX, QuadY, QuadQ;
+#endif /* EF_KERNELS_AVX512 */
+      __m128d PairX, PairY, PairQ, SingleCoord;
+      dbl SingleQ {0};
+
+      for (size_t g = 0; g < Groups; g++)
+      {
+        GX[g] = Load(vecd {}, X + g * VecWidth);
+        GY[g] = Load(vecd {}, Y + g * VecWidth);
+        GQ[g] = Load(vecd {}, Q + g * VecWidth);
+      }
+#ifdef EF_KERNELS_AVX512
+      if constexpr (Tail >= 4)
+      {
+        QuadX = _mm256_loadu_pd(X + QuadAt);
+        QuadY = _mm256_loadu_pd(Y + QuadAt);
+        QuadQ = _mm256_loadu_pd(Q + QuadAt);
+      }
+#endif /* EF_KERNELS_AVX512 */
+      if constexpr (Tail % 4 >= 2 && VecWidth > 2)
+      {
+        PairX = _mm_loadu_pd(X + PairAt);
+        PairY = _mm_loadu_pd(Y + PairAt);
+        PairQ = _mm_loadu_pd(Q + PairAt);
+      }
+      if constexpr (Tail % 2 == 1)
+      {
+        SingleCoord = _mm_set_pd(Y[Count - 1], X[Count - 1]);
+        SingleQ = Q[Count - 1];
+      }
+
+      auto Force = [&]( __m128d P ) -> __m128d
+        {
+          __m128d Res {_mm_setzero_pd()};
+          const auto PXPair {_mm_unpacklo_pd(P, P)}, PYPair {_mm_unpackhi_pd(P, P)};
+
+          if constexpr (Count == 0 || Groups > 0)
+          {
+            const vecd PX {Set1(vecd {}, _mm_cvtsd_f64(P))}, PY {Set1(vecd {}, _mm_cvtsd_f64(PYPair))};
+            vecd Ex {Set1(vecd {}, 0)}, Ey {Ex};
+
+            if constexpr (Count == 0)
+              for (size_t i = 0; i < Data.Count; i += VecWidth)
+                AccumulateCharges(PX, PY, Load(vecd {}, X + i), Load(vecd {}, Y + i), Load(vecd {}, Q + i), Ex, Ey);
+            else
+              [&]<size_t... G>( std::index_sequence<G...> )
+              {
+                (AccumulateCharges(PX, PY, GX[G], GY[G], GQ[G], Ex, Ey), ...);
+              }(std::make_index_sequence<Groups> {});
+
+            Res = SumPair(Ex, Ey);
+          }
+
+#ifdef EF_KERNELS_AVX512
+          if constexpr (Tail >= 4)
+          {
+            const auto PX {_mm256_set1_pd(_mm_cvtsd_f64(P))}, PY {_mm256_set1_pd(_mm_cvtsd_f64(PYPair))};
+            auto Ex {_mm256_setzero_pd()}, Ey {Ex};
+
+            AccumulateCharges(PX, PY, QuadX, QuadY, QuadQ, Ex, Ey);
+            Res = _mm_add_pd(Res, SumPair(Ex, Ey));
+          }
+#endif /* EF_KERNELS_AVX512 */
+
+          if constexpr (Tail % 4 >= 2 && VecWidth > 2)
+          {
+            auto Ex {_mm_setzero_pd()}, Ey {Ex};
+
+            AccumulateCharges(PXPair, PYPair, PairX, PairY, PairQ, Ex, Ey);
+            Res = _mm_add_pd(Res, SumPair(Ex, Ey));
+          }
+
+          if constexpr (Tail % 2 == 1)
+          {
+            const auto Dir {_mm_sub_pd(P, SingleCoord)};
+            auto Len = _mm_mul_pd(Dir, Dir);
+
+            Len = _mm_hadd_pd(Len, Len);
+            Res = _mm_add_pd(Res, _mm_div_pd(_mm_mul_pd(_mm_set1_pd(SingleQ), Dir), _mm_sqrt_pd(_mm_mul_pd(_mm_mul_pd(Len, Len), Len))));
+          }
+
+          /* Extended sources */
+          if (Data.Force != nullptr)
+            Res = _mm_add_pd(Res, Data.Force(Data.Context, P));
+
+          return Res;
+        };
+
+      return StepOffset<Method>(Force, Pos, _mm_set1_pd(Data.Length));
+    } /* End of 'StepPacked' function */
+
+  /* Kernels for packed charges count setting function.
+   * ARGUMENTS:
+   *   - Kernels (out):
+   *       line_step_kernel (&Kernels)[4];
+   */
+  template<size_t Count>
+    static void SetPackedKernels( line_step_kernel (&Kernels)[4] )
+    {
+      Kernels[0] = StepPacked<Count, 0>;
+      Kernels[1] = StepPacked<Count, 1>;
+      Kernels[2] = StepPacked<Count, 2>;
+      Kernels[3] = StepPacked<Count, 3>;
+    } /* End of 'SetPackedKernels' function */
+
+  /* Maximal charges count with unrolled kernel (counts up to 16 have own kernels, greater ones are padded by vector width) */
+  static constexpr size_t MaxUnrolled {32};
+
+  /* Packed charges step kernels selection function.
+   * ARGUMENTS:
+   *   - Charges count:
+   *       size_t Count;
+   *   - Kernels (out):
+   *       line_step_kernel (&Kernels)[4];
+   * RETURNS:
+   *   (size_t) Charges count with padding required by selected kernels.
+   */
+  static size_t SelectLineKernels( size_t Count, line_step_kernel (&Kernels)[4] )
+  {
+    /* Counts greater than 16 are padded by vector width (runtime loop is used for counts greater than unrolled ones) */
+    const size_t Padded {Count <= 16 ? Count : (Count + VecWidth - 1) / VecWidth * VecWidth};
+
+    if (Padded == 0 || Padded > MaxUnrolled)
+      SetPackedKernels<0>(Kernels);
+    else if (Padded <= 16)
+      [&]<size_t... Counts>( std::index_sequence<Counts...> )
+      {
+        ((Padded == Counts + 1 ? SetPackedKernels<Counts + 1>(Kernels) : void()), ...);
+      }(std::make_index_sequence<16> {});
+    else
+      [&]<size_t... Steps>( std::index_sequence<Steps...> )
+      {
+        ((Padded == 16 + (Steps + 1) * VecWidth ? SetPackedKernels<16 + (Steps + 1) * VecWidth>(Kernels) : void()), ...);
+      }(std::make_index_sequence<(MaxUnrolled - 16) / VecWidth> {});
+
+    return Padded;
+  } /* End of 'SelectLineKernels' function */
+
+  /* Force callback step kernels (lattice and reference path) getting function.
+   * ARGUMENTS:
+   *   - Kernels (out):
+   *       line_step_kernel (&Kernels)[4];
+   */
+  static void ListLineKernels( line_step_kernel (&Kernels)[4] )
+  {
+    Kernels[0] = StepList<0>;
+    Kernels[1] = StepList<1>;
+    Kernels[2] = StepList<2>;
+    Kernels[3] = StepList<3>;
+  } /* End of 'ListLineKernels' function */
+
+  /***
+   * Field kernels
+   ***/
+
+  /* Point charges field values for points array evaluation kernel (points are processed by vector width).
+   * Boundary image is generated from charge in same loop (inline boundary functions are not called), so no charges are stored.
+   * ARGUMENTS:
+   *   - Point charges coordinates and values:
+   *       const dbl *X, *Y, *Q;
+   *   - Point charges count:
+   *       size_t Charges;
+   *   - Grounded conductor boundary:
+   *       const boundary &Boundary;
+   *   - Query points:
+   *       const coordd *Points;
+   *   - Query points count:
+   *       size_t Count;
+   *   - Outputs (only requested are set):
+   *       const field_out &Out;
+   */
+  template<boundary_type Type, bool IsField, bool IsGradient, bool IsPotential>
+    static void FieldPointsKernel( const dbl *X, const dbl *Y, const dbl *Q, size_t Charges, const boundary &Boundary,
+                                   const coordd *Points, size_t Count, const field_out &Out )
+    {
+      const vecd One {Set1(vecd {}, 1)}, Three {Set1(vecd {}, 3)};
+      const dbl
+        BX {Boundary.Point.X}, BY {Boundary.Point.Y},
+        NX {Boundary.Normal.X}, NY {Boundary.Normal.Y},
+        BR2 {Boundary.Radius * Boundary.Radius};
+
+      for (size_t p = 0; p < Count; p += VecWidth)
+      {
+        /* Points to structure of arrays (tail lanes repeat first point) */
+        const size_t Lanes {Count - p < VecWidth ? Count - p : VecWidth};
+        alignas(64) dbl Values[6][VecWidth];
+
+        for (size_t l = 0; l < VecWidth; l++)
+        {
+          Values[0][l] = Points[p + (l < Lanes ? l : 0)].X;
+          Values[1][l] = Points[p + (l < Lanes ? l : 0)].Y;
+        }
+
+        const vecd PX {Load(vecd {}, Values[0])}, PY {Load(vecd {}, Values[1])};
+        vecd Ex {Set1(vecd {}, 0)}, Ey {Ex}, Dxx {Ex}, Dxy {Ex}, Dyy {Ex}, Phi {Ex};
+
+        /* Single charge contribution accumulation */
+        auto Accumulate = [&]( dbl CX, dbl CY, dbl Charge )
+          {
+            const vecd
+              CQ {Set1(vecd {}, Charge)},
+              DX {Sub(PX, Set1(vecd {}, CX))},
+              DY {Sub(PY, Set1(vecd {}, CY))},
+              R2 {FmAdd(DX, DX, Mul(DY, DY))},
+              RevR {Div(One, Sqrt(R2))},
+              QR {Mul(CQ, RevR)},
+              RevR2 {Mul(RevR, RevR)},
+              QR3 {Mul(QR, RevR2)};
+
+            if constexpr (IsField)
+            {
+              Ex = FmAdd(QR3, DX, Ex);
+              Ey = FmAdd(QR3, DY, Ey);
+            }
+
+            if constexpr (IsGradient)
+            {
+              /* dEx/dx = q / r^3 - 3q dx^2 / r^5, dEx/dy = -3q dx dy / r^5 */
+              const vecd QR5 {Mul(Three, Mul(QR3, RevR2))}, QR5X {Mul(QR5, DX)}, QR5Y {Mul(QR5, DY)};
+
+              Dxx = Add(Dxx, Sub(QR3, Mul(QR5X, DX)));
+              Dxy = Sub(Dxy, Mul(QR5X, DY));
+              Dyy = Add(Dyy, Sub(QR3, Mul(QR5Y, DY)));
+            }
+
+            if constexpr (IsPotential)
+              Phi = Add(Phi, QR);
+          };
+
+        for (size_t i = 0; i < Charges; i++)
+        {
+          const dbl DX {X[i] - BX}, DY {Y[i] - BY};
+
+          /* Mirror over line, screened charges (behind line) give no field */
+          if constexpr (Type == boundary_type::Line)
+          {
+            const dbl D {DX * NX + DY * NY};
+
+            if (!(D > 0))
+              continue;
+            Accumulate(X[i] - 2 * D * NX, Y[i] - 2 * D * NY, -Q[i]);
+          }
+
+          /* Inversion in circle, screened charges (inside circle) give no field */
+          if constexpr (Type == boundary_type::Circle)
+          {
+            const dbl D2 {DX * DX + DY * DY};
+
+            if (!(D2 > BR2))
+              continue;
+
+            const dbl K {BR2 / D2};
+
+            Accumulate(BX + DX * K, BY + DY * K, -Q[i] * sqrt(K));
+          }
+
+          Accumulate(X[i], Y[i], Q[i]);
+        }
+
+        /* Only real lanes are stored */
+        auto Write = [&]( dbl *Dst, vecd V, size_t Row )
+          {
+            Store(Values[Row], V);
+            for (size_t l = 0; l < Lanes; l++)
+              Dst[p + l] = Values[Row][l];
+          };
+
+        if constexpr (IsField)
+          Write(Out.Ex, Ex, 0), Write(Out.Ey, Ey, 1);
+
+        if constexpr (IsGradient)
+          Write(Out.Dxx, Dxx, 2), Write(Out.Dxy, Dxy, 3), Write(Out.Dyy, Dyy, 4);
+
+        if constexpr (IsPotential)
+          Write(Out.Phi, Phi, 5);
+      }
+    } /* End of 'FieldPointsKernel' function */
+
+  /* Point charges field values kernels by requested outputs (1 - field, 2 - gradient, 4 - potential) */
+  using field_points_kernel = void (*)( const dbl *, const dbl *, const dbl *, size_t, const boundary &, const coordd *, size_t,
+                                        const field_out & );
+
+  template<boundary_type Type>
+    static const field_points_kernel FieldPointsKernels[8]
+    {
+      nullptr, FieldPointsKernel<Type, true, false, false>,
+      FieldPointsKernel<Type, false, true, false>, FieldPointsKernel<Type, true, true, false>,
+      FieldPointsKernel<Type, false, false, true>, FieldPointsKernel<Type, true, false, true>,
+      FieldPointsKernel<Type, false, true, true>, FieldPointsKernel<Type, true, true, true>,
+    };
+
+  /* Point charges field values for points array evaluation function (kernel is selected by boundary and requested outputs).
+   * ARGUMENTS:
+   *   - Point charges coordinates and values:
+   *       const dbl *X, *Y, *Q;
+   *   - Point charges count:
+   *       size_t Charges;
+   *   - Grounded conductor boundary (images are added, screened charges are skipped):
+   *       const boundary &Boundary;
+   *   - Query points:
+   *       const coordd *Points;
+   *   - Query points count:
+   *       size_t Count;
+   *   - Outputs (only requested are set):
+   *       const field_out &Out;
+   */
+  static void FieldPoints( const dbl *X, const dbl *Y, const dbl *Q, size_t Charges, const boundary &Boundary,
+                           const coordd *Points, size_t Count, const field_out &Out )
+  {
+    static const field_points_kernel *const Kernels[3]
+    {
+      FieldPointsKernels<boundary_type::None>, FieldPointsKernels<boundary_type::Line>, FieldPointsKernels<boundary_type::Circle>
+    };
+
+    const size_t Index
+    {
+      (size_t)(Out.Ex != nullptr && Out.Ey != nullptr) |
+      (size_t)(Out.Dxx != nullptr && Out.Dxy != nullptr && Out.Dyy != nullptr) << 1 |
+      (size_t)(Out.Phi != nullptr) << 2
+    };
+
+    if (Index != 0)
+      Kernels[(size_t)Boundary.Type][Index](X, Y, Q, Charges, Boundary, Points, Count, Out);
+  } /* End of 'FieldPoints' function */
+} /* end of 'prj::phys' namespace */
+
+#endif /* __ef_kernels_impl_h__ */
+
+/* END OF 'ef_kernels_impl.h' FILE */
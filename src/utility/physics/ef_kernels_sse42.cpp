@@ -0,0 +1,21 @@
+/* FILE NAME   : 'ef_kernels_sse42.cpp'
+ * PURPOSE     : Physics module.
+ *               SSE4.2 level vector kernels file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ *               Unit is compiled without precompiled header with its own instruction set option.
+ */
+
+#include <def.h>
+
+#define EF_KERNELS_SSE42
+#include "ef_kernels_impl.h"
+
+/* SSE4.2 level kernels table */
+const prj::phys::simd_kernels prj::phys::SimdKernelsSse42
+{
+  "sse42", FieldPoints, SelectLineKernels, ListLineKernels
+};
+
+/* END OF 'ef_kernels_sse42.cpp' FILE */
@@ -0,0 +1,321 @@
+/* FILE NAME   : 'ef_lic.cpp'
+ * PURPOSE     : Physics module.
+ *               Line integral convolution field texture implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#include <pch.h>
+
+#include "ef_lic.h"
+#include "utility/threads_pool/threads_pool.hpp"
+
+using namespace prj::phys;
+
+/* World pixel lattice noise value function.
+ * ARGUMENTS:
+ *   - Pixel global indices:
+ *       INT X, Y;
+ * RETURNS:
+ *   (flt) Value in [0;1).
+ */
+static inline flt NoiseValue( INT X, INT Y )
+{
+  UINT32 H {(UINT32)X * 0x9E3779B1u ^ (UINT32)Y * 0x85EBCA77u};
+
+  H ^= H >> 15, H *= 0x2C1B3C6Du;
+  H ^= H >> 12, H *= 0x297A2D39u;
+  H ^= H >> 15;
+
+  return (H >> 8) * (1.f / (1 << 24));
+} /* End of 'NoiseValue' function */
+
+/* Direction in pixels space sampling function.
+ * ARGUMENTS:
+ *   - Position (in pixels):
+ *       flt X, Y;
+ *   - Direction (out):
+ *       flt &DX, &DY;
+ * RETURNS:
+ *   (bool) true if direction is defined.
+ */
+bool lic::SampleDir( flt X, flt Y, flt &DX, flt &DY ) const
+{
+  const flt
+    GX {std::clamp(X / GridStep, 0.f, (flt)(GridW - 1) - 1e-3f)},
+    GY {std::clamp(Y / GridStep, 0.f, (flt)(GridH - 1) - 1e-3f)},
+    FX {GX - floorf(GX)},
+    FY {GY - floorf(GY)};
+  const size_t I {(size_t)GY * GridW + (size_t)GX};
+
+  /* Bilinear interpolation of normalized directions */
+  DX = (DirX[I] * (1 - FX) + DirX[I + 1] * FX) * (1 - FY) + (DirX[I + GridW] * (1 - FX) + DirX[I + GridW + 1] * FX) * FY;
+  DY = (DirY[I] * (1 - FX) + DirY[I + 1] * FX) * (1 - FY) + (DirY[I + GridW] * (1 - FX) + DirY[I + GridW + 1] * FX) * FY;
+
+  const flt Len2 {DX * DX + DY * DY};
+
+  if (!(Len2 > 1e-8f))
+    return false;
+
+  const flt RevLen {1 / sqrtf(Len2)};
+
+  DX *= RevLen, DY *= RevLen;
+  return true;
+} /* End of 'lic::SampleDir' function */
+
+/* Single tile convolution function.
+ * ARGUMENTS:
+ *   - Tile first pixel:
+ *       INT X0, Y0;
+ * RETURNS:
+ *   (size_t) Traced streamlines count.
+ */
+size_t lic::ConvolveTile( INT X0, INT Y0 )
+{
+  constexpr INT HalfPoints {KernelLength + Extension};
+
+  const INT
+    X1 {std::min(X0 + TileSize, Width)},
+    Y1 {std::min(Y0 + TileSize, Height)};
+
+  flt Accum[TileSize * TileSize] {};
+  WORD Hits[TileSize * TileSize] {};
+
+  /* Streamline points (seed is in the middle) and noise along it */
+  coordf Points[HalfPoints * 2 + 1];
+  flt Values[HalfPoints * 2 + 1];
+  size_t Streamlines {0};
+
+  for (INT y = Y0; y < Y1; y++)
+    for (INT x = X0; x < X1; x++)
+    {
+      if (Hits[(y - Y0) * TileSize + (x - X0)] != 0)
+        continue;
+
+      /* Trace streamline both ways with steps of one pixel (grid directions are smooth enough for Euler steps) */
+      INT First {HalfPoints}, Last {HalfPoints};
+
+      Points[HalfPoints] = {x + .5f, y + .5f};
+      for (const INT Dir : {1, -1})
+      {
+        coordf Pos {Points[HalfPoints]};
+
+        for (INT k = 1; k <= HalfPoints; k++)
+        {
+          flt MX, MY;
+
+          if (!SampleDir(Pos.X, Pos.Y, MX, MY))
+            break;
+
+          Pos.X += MX * Dir, Pos.Y += MY * Dir;
+          if (Pos.X < 0 || Pos.Y < 0 || Pos.X >= Width || Pos.Y >= Height)
+            break;
+
+          Points[HalfPoints + k * Dir] = Pos;
+          (Dir > 0 ? Last : First) = HalfPoints + k * Dir;
+        }
+      }
+
+      for (INT k = First; k <= Last; k++)
+        Values[k] = Noise[(size_t)Points[k].Y * Width + (size_t)Points[k].X];
+
+      /* Box filter slides along streamline, so every point costs two additions */
+      const INT
+        Lo {std::max(First, HalfPoints - Extension)},
+        Hi {std::min(Last, HalfPoints + Extension)};
+      flt Sum {0};
+      INT Count {0};
+
+      for (INT k = std::max(First, Lo - KernelLength); k <= std::min(Last, Lo + KernelLength); k++)
+        Sum += Values[k], Count++;
+
+      for (INT k = Lo; k <= Hi; k++)
+      {
+        const INT
+          PX {(INT)Points[k].X - X0},
+          PY {(INT)Points[k].Y - Y0};
+
+        /* Only own tile pixels are written, other tiles convolve their pixels themselves */
+        if (PX >= 0 && PY >= 0 && PX < X1 - X0 && PY < Y1 - Y0)
+        {
+          Accum[PY * TileSize + PX] += Sum / Count;
+          Hits[PY * TileSize + PX]++;
+        }
+
+        if (k + KernelLength + 1 <= Last)
+          Sum += Values[k + KernelLength + 1], Count++;
+        if (k - KernelLength >= First)
+          Sum -= Values[k - KernelLength], Count--;
+      }
+
+      Streamlines++;
+    }
+
+  /* Box filter mean of uniform noise has small variance, so contrast is stretched */
+  const flt Contrast {sqrtf(2.f * KernelLength + 1) * .6f};
+
+  for (INT y = Y0; y < Y1; y++)
+    for (INT x = X0; x < X1; x++)
+    {
+      const INT I {(y - Y0) * TileSize + (x - X0)};
+      const flt
+        Value {Accum[I] / std::max<WORD>(Hits[I], 1)},
+        T {std::clamp(.5f + (Value - .5f) * Contrast, 0.f, 1.f)};
+      const DWORD Gray {(DWORD)((.4f + .6f * T) * 255.f + .5f)};
+
+      Pixels[(size_t)y * Width + x] = 0xFF000000 | Gray << 16 | Gray << 8 | Gray;
+    }
+
+  return Streamlines;
+} /* End of 'lic::ConvolveTile' function */
+
+/* Texture evaluation function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - View:
+ *       const heatmap_view &View;
+ *   - Periodic lattice evaluator (default: nullptr - charges are isolated):
+ *       const ewald_sum *Periodic;
+ *   - Grounded conductor boundary (default: none):
+ *       const boundary &Boundary;
+ */
+void lic::Update( const charge_pool &Charges, const heatmap_view &View, const ewald_sum *Periodic, const boundary &Boundary )
+{
+  UINT64 Freq, Start, FieldEnd, End;
+
+  QueryPerformanceFrequency((LARGE_INTEGER *)&Freq);
+  QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+
+  Width = std::max(View.Width, 1), Height = std::max(View.Height, 1);
+  GridW = Width / GridStep + 2, GridH = Height / GridStep + 2;
+
+  /* Field grid with batched points evaluation */
+  {
+    std::vector<coordd> Nodes {};
+    std::vector<dbl> EX((size_t)GridW * GridH), EY((size_t)GridW * GridH);
+
+    Nodes.reserve((size_t)GridW * GridH);
+    for (INT j = 0; j < GridH; j++)
+      for (INT i = 0; i < GridW; i++)
+        Nodes.push_back({View.Left + i * GridStep * View.PixelW, View.Bottom + j * GridStep * View.PixelH});
+
+    EvalField(Charges, std::span<const coordd> {Nodes}, field_vectors<dbl> {EX, EY}, 0, Periodic, Boundary);
+
+    DirX.resize(Nodes.size()), DirY.resize(Nodes.size());
+    for (size_t i = 0; i < Nodes.size(); i++)
+    {
+      const dbl
+        DX {EX[i] / View.PixelW},
+        DY {EY[i] / View.PixelH},
+        Len {hypot(DX, DY)};
+
+      if (Len > 0 && std::isfinite(Len))
+        DirX[i] = (flt)(DX / Len), DirY[i] = (flt)(DY / Len);
+      else
+        DirX[i] = DirY[i] = 0;
+    }
+  }
+
+  QueryPerformanceCounter((LARGE_INTEGER *)&FieldEnd);
+
+  /* Noise is anchored to world pixels, so texture does not swim on pan */
+  const INT
+    LatticeX {(INT)llround(View.Left / View.PixelW)},
+    LatticeY {(INT)llround(View.Bottom / View.PixelH)};
+
+  Noise.resize((size_t)Width * Height);
+  for (INT j = 0; j < Height; j++)
+    for (INT i = 0; i < Width; i++)
+      Noise[(size_t)j * Width + i] = NoiseValue(LatticeX + i, LatticeY + j);
+
+  Pixels.resize((size_t)Width * Height);
+
+  /* Tile-parallel convolution */
+  struct tile_task
+  {
+    INT X0, Y0;
+    size_t Streamlines;
+  }; /* end of 'tile_task' structure */
+
+  std::vector<tile_task> Tasks {};
+
+  for (INT y = 0; y < Height; y += TileSize)
+    for (INT x = 0; x < Width; x += TileSize)
+      Tasks.push_back({x, y, 0});
+
+  {
+    prj::util::threads_pool<tile_task *> Pool {[&]( tile_task **Task ) -> bool
+      {
+        (*Task)->Streamlines = ConvolveTile((*Task)->X0, (*Task)->Y0);
+        return true;
+      }};
+
+    for (auto &Task : Tasks)
+      Pool.AddTask(&Task);
+
+    Pool.Run();
+    Pool.Wait();
+  }
+
+  QueryPerformanceCounter((LARGE_INTEGER *)&End);
+
+  Stats.Updates++;
+  Stats.Pixels = Pixels.size();
+  Stats.Streamlines = 0;
+  for (const auto &Task : Tasks)
+    Stats.Streamlines += Task.Streamlines;
+
+  Stats.FieldTime = (FieldEnd - Start) * 1000.0 / Freq;
+  Stats.ConvolutionTime = (End - FieldEnd) * 1000.0 / Freq;
+  Stats.LastTime = (End - Start) * 1000.0 / Freq;
+} /* End of 'lic::Update' function */
+
+/* Texture evaluation time by resolution benchmark function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Window size:
+ *       INT W, H;
+ *   - Frame time target (in ms):
+ *       dbl Target;
+ * RETURNS:
+ *   (std::string) Report.
+ */
+std::string prj::phys::BenchmarkLic( const charge_pool &Charges, INT W, INT H, dbl Target )
+{
+  std::string Report {"LIC texture (" + std::to_string(Charges.Size()) + " charges, target " +
+                      std::to_string((INT)Target) + " ms):\n"};
+
+  /* View over charges bounding box */
+  dbl MinX {-18}, MinY {-18}, MaxX {18}, MaxY {18};
+
+  for (const auto &Elm : Charges)
+  {
+    const dbl Margin {4 + SourceRadius(Elm.Shape)};
+
+    MinX = std::min(MinX, Elm.Coord.X - Margin), MaxX = std::max(MaxX, Elm.Coord.X + Margin);
+    MinY = std::min(MinY, Elm.Coord.Y - Margin), MaxY = std::max(MaxY, Elm.Coord.Y + Margin);
+  }
+
+  for (const INT Scale : {1, 2, 4})
+  {
+    const INT SW {W / Scale}, SH {H / Scale};
+    lic Lic {};
+
+    Lic.Update(Charges, {MinX, MinY, (MaxX - MinX) / SW, (MaxY - MinY) / SH, SW, SH});
+
+    const auto &Stats {Lic.GetStats()};
+    CHAR Buf[0x100];
+
+    sprintf(Buf, "  - %dx%d: %.2f ms (field %.2f ms, convolution %.2f ms, %zu streamlines) - %s\n",
+            SW, SH, Stats.LastTime, Stats.FieldTime, Stats.ConvolutionTime, Stats.Streamlines,
+            Stats.LastTime <= Target ? "in target" : "over target");
+    Report += Buf;
+  }
+
+  return Report;
+} /* End of 'prj::phys::BenchmarkLic' function */
+
+/* END OF 'ef_lic.cpp' FILE */
@@ -0,0 +1,130 @@
+/* FILE NAME   : 'ef_lic.h'
+ * PURPOSE     : Physics module.
+ *               Line integral convolution field texture handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#ifndef __ef_lic_h__
+#define __ef_lic_h__
+
+#include "ef_charges.h"
+#include "ef_heatmap.h"
+
+/* Project namespace // Physics module */
+namespace prj::phys
+{
+  /* Line integral convolution (FastLIC) field direction texture.
+   * Field is sampled on coarse grid once per update, every long streamline
+   * gives convolution for all its pixels with sliding box filter.
+   */
+  class lic
+  {
+  public:
+    /* Texture statistics structure */
+    struct stats
+    {
+      size_t
+        Updates {0},           /* Texture evaluations */
+        Streamlines {0},       /* Streamlines in last update */
+        Pixels {0};            /* Pixels in last update */
+      dbl
+        FieldTime {0},         /* Last field grid evaluation time (in ms) */
+        ConvolutionTime {0},   /* Last convolution time (in ms) */
+        LastTime {0};          /* Last update time (in ms) */
+    }; /* end of 'stats' structure */
+
+  private:
+    /* Field grid step, tile size (in pixels), convolution half length and streamline extension (in steps) */
+    static constexpr INT GridStep {4}, TileSize {128}, KernelLength {16}, Extension {48};
+
+    /* Texture size */
+    INT Width {0}, Height {0};
+
+    /* Field grid size and normalized directions (in pixels space) */
+    INT GridW {0}, GridH {0};
+    std::vector<flt> DirX {}, DirY {};
+
+    /* White noise (anchored to world pixels lattice) */
+    std::vector<flt> Noise {};
+
+    /* Resulting pixels (BGRA) */
+    std::vector<DWORD> Pixels {};
+
+    /* Statistics */
+    stats Stats {};
+
+    /* Direction in pixels space sampling function.
+     * ARGUMENTS:
+     *   - Position (in pixels):
+     *       flt X, Y;
+     *   - Direction (out):
+     *       flt &DX, &DY;
+     * RETURNS:
+     *   (bool) true if direction is defined.
+     */
+    bool SampleDir( flt X, flt Y, flt &DX, flt &DY ) const;
+
+    /* Single tile convolution function.
+     * ARGUMENTS:
+     *   - Tile first pixel:
+     *       INT X0, Y0;
+     * RETURNS:
+     *   (size_t) Traced streamlines count.
+     */
+    size_t ConvolveTile( INT X0, INT Y0 );
+
+  public:
+    /* Texture evaluation function.
+     * ARGUMENTS:
+     *   - Charges pool:
+     *       const charge_pool &Charges;
+     *   - View:
+     *       const heatmap_view &View;
+     *   - Periodic lattice evaluator (default: nullptr - charges are isolated):
+     *       const ewald_sum *Periodic;
+     *   - Grounded conductor boundary (default: none):
+     *       const boundary &Boundary;
+     */
+    void Update( const charge_pool &Charges, const heatmap_view &View, const ewald_sum *Periodic = nullptr,
+                 const boundary &Boundary = {} );
+
+    /* Resulting pixels getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const std::vector<DWORD> &) Pixels (BGRA, row by row).
+     */
+    const std::vector<DWORD> &GetPixels( void ) const
+    {
+      return Pixels;
+    } /* End of 'GetPixels' function */
+
+    /* Statistics getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const stats &) Statistics.
+     */
+    const stats &GetStats( void ) const
+    {
+      return Stats;
+    } /* End of 'GetStats' function */
+  }; /* end of 'lic' class */
+
+  /* Texture evaluation time by resolution benchmark function.
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Window size:
+   *       INT W, H;
+   *   - Frame time target (in ms):
+   *       dbl Target;
+   * RETURNS:
+   *   (std::string) Report.
+   */
+  std::string BenchmarkLic( const charge_pool &Charges, INT W, INT H, dbl Target );
+} /* end of 'prj::phys' namespace */
+
+#endif /* __ef_lic_h__ */
+
+/* END OF 'ef_lic.h' FILE */
@@ -0,0 +1,187 @@
+/* FILE NAME   : 'ef_nulls.cpp'
+ * PURPOSE     : Physics module.
+ *               Electric field null points search implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#include <pch.h>
+
+#include "ef_nulls.h"
+#include "ef_ewald.h"
+
+using namespace prj::phys;
+
+/* Field null points search function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Periodic lattice evaluator (default: nullptr - charges are isolated, otherwise nulls in cell are searched):
+ *       const ewald_sum *Periodic;
+ *   - Grounded conductor boundary (default: none, nulls inside conductor are skipped):
+ *       const boundary &Boundary;
+ *   - Seeding grid size (in each direction, default: 32):
+ *       size_t GridSize;
+ * RETURNS:
+ *   (std::vector<coordd>) Found null points.
+ */
+std::vector<coordd> prj::phys::FindNulls( const charge_pool &Charges, const ewald_sum *Periodic, const boundary &Boundary,
+                                          size_t GridSize )
+{
+  std::vector<coordd> Res {};
+
+  /* Single charge lattice has nulls (between images), single charge near boundary may have null too */
+  if (Charges.IsEmpty() || (Charges.Size() < 2 && Periodic == nullptr && !Boundary.IsValid()))
+    return Res;
+
+  GridSize = std::max<size_t>(GridSize, 4);
+
+  coordd Min {Charges[0].Coord}, Max {Min};
+  dbl Scale;
+
+  if (Periodic != nullptr)
+  {
+    /* Seeding area - periodic cell with margin (for minimums on cell border) */
+    const auto &Lattice {Periodic->GetCell()};
+
+    Scale = std::max(Lattice.W, Lattice.H);
+    Min = {-Lattice.W * 0.1, -Lattice.H * 0.1};
+    Max = {Lattice.W * 1.1, Lattice.H * 1.1};
+  }
+  else
+  {
+    /* Seeding area - charges bounding box with margin */
+    for (const auto &Elm : Charges)
+    {
+      const dbl Radius {SourceRadius(Elm.Shape) + Elm.Size};
+
+      Min = {std::min(Min.X, Elm.Coord.X - Radius), std::min(Min.Y, Elm.Coord.Y - Radius)};
+      Max = {std::max(Max.X, Elm.Coord.X + Radius), std::max(Max.Y, Elm.Coord.Y + Radius)};
+    }
+
+    Scale = std::max(Max.X - Min.X, Max.Y - Min.Y);
+    Min = {Min.X - Scale * 0.25, Min.Y - Scale * 0.25};
+    Max = {Max.X + Scale * 0.25, Max.Y + Scale * 0.25};
+  }
+
+  const coordd Cell {(Max.X - Min.X) / (GridSize - 1), (Max.Y - Min.Y) / (GridSize - 1)};
+
+  /* Offset between points (to nearest image for lattice) */
+  auto Offset = [&]( const coordd &A, const coordd &B ) -> dbl
+    {
+      dbl DX {A.X - B.X}, DY {A.Y - B.Y};
+
+      if (Periodic != nullptr)
+        Periodic->Wrap(DX, DY);
+      return hypot(DX, DY);
+    };
+
+  /* Distance from point to source (to nearest source image for lattice) */
+  auto Distance = [&]( const coordd &Pos, const charge &Elm ) -> dbl
+    {
+      dbl DX {Pos.X - Elm.Coord.X}, DY {Pos.Y - Elm.Coord.Y};
+
+      if (Periodic != nullptr)
+        Periodic->Wrap(DX, DY);
+      return SourceDistance(Elm, {Elm.Coord.X + DX, Elm.Coord.Y + DY});
+    };
+
+  /* Point inside some charge (or inside conductor with zero field) check */
+  auto IsInCharge = [&]( const coordd &Pos ) -> bool
+    {
+      if (Periodic == nullptr && Boundary.Distance(Pos) <= 0)
+        return true;
+      for (const auto &Elm : Charges)
+        if (Distance(Pos, Elm) <= Elm.Size)
+          return true;
+      return false;
+    };
+
+  /* Field length squares on grid */
+  const field_snapshot Snapshot {Charges, Periodic, Boundary};
+  std::vector<coordd> Grid {};
+  std::vector<dbl> Field(GridSize * GridSize), FieldY(GridSize * GridSize);
+
+  Grid.reserve(GridSize * GridSize);
+  for (size_t y = 0; y < GridSize; y++)
+    for (size_t x = 0; x < GridSize; x++)
+      Grid.push_back({Min.X + Cell.X * x, Min.Y + Cell.Y * y});
+
+  field_out Out {};
+
+  Out.Ex = Field.data(), Out.Ey = FieldY.data();
+  EvalField(Snapshot, Grid.data(), Grid.size(), Out);
+
+  for (size_t i = 0; i < Grid.size(); i++)
+    Field[i] = IsInCharge(Grid[i]) ? std::numeric_limits<dbl>::max() : Field[i] * Field[i] + FieldY[i] * FieldY[i];
+
+  /* Refine every local minimum */
+  for (size_t y = 1; y + 1 < GridSize; y++)
+    for (size_t x = 1; x + 1 < GridSize; x++)
+    {
+      const dbl Val {Field[y * GridSize + x]};
+      bool IsMin {Val != std::numeric_limits<dbl>::max()};
+
+      for (INT dy = -1; dy <= 1 && IsMin; dy++)
+        for (INT dx = -1; dx <= 1 && IsMin; dx++)
+          if ((dx != 0 || dy != 0) && Field[(y + dy) * GridSize + x + dx] < Val)
+            IsMin = false;
+
+      if (!IsMin)
+        continue;
+
+      /* Newton iterations */
+      coordd Pos {Min.X + Cell.X * x, Min.Y + Cell.Y * y};
+      bool IsFound {false};
+
+      for (INT i = 0; i < 32; i++)
+      {
+        const auto [E, J, Phi] {EvalSample(Snapshot, Pos)};
+        const dbl Det {J[0] * J[2] - J[1] * J[1]};
+
+        if (abs(Det) < std::numeric_limits<dbl>::min())
+          break;
+
+        const coordd Delta {(J[2] * E.X - J[1] * E.Y) / Det, (J[0] * E.Y - J[1] * E.X) / Det};
+
+        /* Step is limited with seeding cell */
+        const dbl
+          DeltaLen {hypot(Delta.X, Delta.Y)},
+          StepMul {std::min(1.0, Cell.X / DeltaLen)};
+
+        Pos = {Pos.X - Delta.X * StepMul, Pos.Y - Delta.Y * StepMul};
+
+        if (Pos.X < Min.X || Pos.X > Max.X || Pos.Y < Min.Y || Pos.Y > Max.Y)
+          break;
+
+        if (DeltaLen < Scale * 1e-10)
+        {
+          IsFound = true;
+          break;
+        }
+      }
+
+      if (!IsFound || IsInCharge(Pos))
+        continue;
+
+      /* Lattice nulls are kept inside cell */
+      if (Periodic != nullptr)
+      {
+        const auto &Lattice {Periodic->GetCell()};
+
+        Pos = {Pos.X - Lattice.W * floor(Pos.X / Lattice.W), Pos.Y - Lattice.H * floor(Pos.Y / Lattice.H)};
+      }
+
+      /* Neighbour minimums (and margin minimums for lattice) may converge to same point */
+      if (std::none_of(Res.begin(), Res.end(), [&]( const coordd &Elm ) -> bool
+            {
+              return Offset(Elm, Pos) < Cell.X * 0.5;
+            }))
+        Res.push_back(Pos);
+    }
+
+  return Res;
+} /* End of 'prj::phys::FindNulls' function */
+
+/* END OF 'ef_nulls.cpp' FILE */
@@ -0,0 +1,37 @@
+/* FILE NAME   : 'ef_nulls.h'
+ * PURPOSE     : Physics module.
+ *               Electric field null points search handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#ifndef __ef_nulls_h__
+#define __ef_nulls_h__
+
+#include "ef_field.h"
+
+/* Project namespace // Physics module */
+namespace prj::phys
+{
+  /* Field null points search function.
+   * Local minimums of field length on coarse grid over charges are refined with Newton iterations.
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Periodic lattice evaluator (default: nullptr - charges are isolated, otherwise nulls in cell are searched):
+   *       const ewald_sum *Periodic;
+   *   - Grounded conductor boundary (default: none, nulls inside conductor are skipped):
+   *       const boundary &Boundary;
+   *   - Seeding grid size (in each direction, default: 32):
+   *       size_t GridSize;
+   * RETURNS:
+   *   (std::vector<coordd>) Found null points.
+   */
+  std::vector<coordd> FindNulls( const charge_pool &Charges, const ewald_sum *Periodic = nullptr, const boundary &Boundary = {},
+                                 size_t GridSize = 32 );
+} /* end of 'prj::phys' namespace */
+
+#endif /* __ef_nulls_h__ */
+
+/* END OF 'ef_nulls.h' FILE */
@@ -0,0 +1,261 @@
+/* FILE NAME   : 'ef_seeding.cpp'
+ * PURPOSE     : Physics module.
+ *               Force lines seeds placement implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#include <pch.h>
+
+#include "ef_seeding.h"
+
+using namespace prj::phys;
+
+/* Flux through seed circles sampling function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Sampled charges:
+ *       std::span<const charge *const> Sources;
+ *   - Samples on every circle (sample j is center of [2pi * j / Samples; 2pi * (j + 1) / Samples] arc):
+ *       size_t Samples;
+ *   - Sampling start angles for every source (empty - zero):
+ *       std::span<const dbl> Offsets;
+ *   - Periodic lattice evaluator (nullptr - charges are isolated):
+ *       const ewald_sum *Periodic;
+ *   - Grounded conductor boundary (default: none):
+ *       const boundary &Boundary;
+ * RETURNS:
+ *   (std::vector<dbl>) Line-wise flux (positive where lines start or end on charge) by samples of all sources.
+ */
+static std::vector<dbl> CircleFlux( const charge_pool &Charges, std::span<const charge *const> Sources, size_t Samples,
+                                    std::span<const dbl> Offsets = {}, const ewald_sum *Periodic = nullptr,
+                                    const boundary &Boundary = {} )
+{
+  std::vector<coordd> Points {};
+  std::vector<dbl> Cos(Sources.size() * Samples), Sin(Sources.size() * Samples);
+
+  /* Samples are uniform in contour length (angle for point charge), normals are directed from source */
+  Points.reserve(Sources.size() * Samples);
+  for (size_t i = 0; i < Sources.size(); i++)
+    for (size_t j = 0; j < Samples; j++)
+    {
+      const size_t I {i * Samples + j};
+      const dbl Param {(i < Offsets.size() ? Offsets[i] : 0) + 2 * M_PI * (j + 0.5) / Samples};
+      coordd Base;
+      const coordd P {SourceContour(*Sources[i], Param, Sources[i]->Size * 2, Base)};
+      const dbl Len {std::max(hypot(P.X - Base.X, P.Y - Base.Y), 1e-300)};
+
+      Cos[I] = (P.X - Base.X) / Len, Sin[I] = (P.Y - Base.Y) / Len;
+      Points.push_back(P);
+    }
+
+  /* All circles are evaluated in one batch */
+  std::vector<dbl> EX(Points.size()), EY(Points.size()), Flux(Points.size());
+
+  EvalField(Charges, std::span<const coordd> {Points}, field_vectors<dbl> {EX, EY}, 0, Periodic, Boundary);
+
+  for (size_t i = 0; i < Sources.size(); i++)
+  {
+    const dbl Sign {Sources[i]->Charge < 0 ? -1.0 : 1.0};
+
+    for (size_t j = 0; j < Samples; j++)
+    {
+      const size_t I {i * Samples + j};
+
+      Flux[I] = std::max((EX[I] * Cos[I] + EY[I] * Sin[I]) * Sign, 0.0);
+    }
+  }
+
+  return Flux;
+} /* End of 'CircleFlux' function */
+
+/* Force lines seed angles on charges seed circles (radius is doubled charge size) placement function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Seeds count for every charge (in pool order, 0 - no seeds):
+ *       std::span<const size_t> Counts;
+ *   - Flux weighted placement flag (otherwise angles are uniform):
+ *       bool IsFluxWeighted;
+ *   - First seed angle for every charge (in pool order, empty - zero):
+ *       std::span<const dbl> Offsets;
+ *   - Periodic lattice evaluator (default: nullptr - charges are isolated):
+ *       const ewald_sum *Periodic;
+ *   - Grounded conductor boundary (default: none):
+ *       const boundary &Boundary;
+ * RETURNS:
+ *   (std::vector<std::vector<dbl>>) Seed angles for every charge.
+ */
+std::vector<std::vector<dbl>> prj::phys::SeedAngles( const charge_pool &Charges, std::span<const size_t> Counts, bool IsFluxWeighted,
+                                                     std::span<const dbl> Offsets, const ewald_sum *Periodic, const boundary &Boundary )
+{
+  /* Samples per seed circle */
+  constexpr size_t Samples {256};
+
+  std::vector<std::vector<dbl>> Angles(Charges.Size());
+  std::vector<const charge *> Sources {};
+  std::vector<size_t> Indices {};
+  std::vector<dbl> SourceOffsets {};
+  size_t Index {0};
+
+  for (const auto &Elm : Charges)
+  {
+    const size_t Count {Index < Counts.size() ? Counts[Index] : 0};
+    const dbl Offset {Index < Offsets.size() ? Offsets[Index] : 0};
+
+    /* Uniform angles (first seed at offset angle) */
+    for (size_t i = 0; i < Count; i++)
+      Angles[Index].push_back(Offset + 2 * M_PI * i / Count);
+
+    /* Single charge flux is distorted only by its lattice or boundary images,
+     * multipole flux leaves only part of its circle, so multipole seeds are always flux weighted */
+    if (IsMultipole(Elm) ? Count > 0 : IsFluxWeighted && Count > 1 && (Charges.Size() > 1 || Periodic != nullptr || Boundary.IsValid()))
+      Sources.push_back(&Elm), Indices.push_back(Index), SourceOffsets.push_back(Offset);
+    Index++;
+  }
+
+  if (Sources.empty())
+    return Angles;
+
+  const std::vector<dbl> Flux {CircleFlux(Charges, Sources, Samples, SourceOffsets, Periodic, Boundary)};
+
+  for (size_t i = 0; i < Sources.size(); i++)
+  {
+    auto &Res {Angles[Indices[i]]};
+    const dbl *F {&Flux[i * Samples]};
+    const size_t Count {Res.size()};
+    dbl Total {0};
+
+    for (size_t j = 0; j < Samples; j++)
+      Total += F[j];
+
+    /* Charge flux is hidden by other charge - uniform angles are kept */
+    if (!(Total > 0))
+      continue;
+
+    /* Seeds at flux cumulative distribution quantiles (linear inside sample arc),
+     * multipole flux starts from zero, so its quantiles are centered in flux parts */
+    const dbl Shift {IsMultipole(*Sources[i]) ? 0.5 : 0};
+    dbl Accum {0};
+    size_t j {0};
+
+    for (size_t k = 0; k < Count; k++)
+    {
+      const dbl Target {Total * (k + Shift) / Count};
+
+      while (j + 1 < Samples && Accum + F[j] <= Target)
+        Accum += F[j++];
+
+      const dbl Part {F[j] > 0 ? std::clamp((Target - Accum) / F[j], 0.0, 1.0) : 0.0};
+
+      Res[k] = SourceOffsets[i] + 2 * M_PI * (j + Part) / Samples;
+    }
+  }
+
+  return Angles;
+} /* End of 'prj::phys::SeedAngles' function */
+
+/* Uniform and flux weighted seeds placement comparison benchmark function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Lines per unit charge:
+ *       dbl LinesPerCharge;
+ * RETURNS:
+ *   (std::string) Report.
+ */
+std::string prj::phys::BenchmarkSeeding( const charge_pool &Charges, dbl LinesPerCharge )
+{
+  /* Flux between seeds is measured with fine sampling */
+  constexpr size_t Samples {4096};
+
+  std::vector<size_t> Counts {};
+  std::vector<const charge *> Sources {};
+  size_t Lines {0};
+
+  for (const auto &Elm : Charges)
+  {
+    Counts.push_back(Elm.Charge < 0 ? 0 : (size_t)round(LinesPerCharge * abs(Elm.Charge)));
+    Lines += Counts.back();
+    Sources.push_back(&Elm);
+  }
+
+  const std::vector<dbl> Flux {CircleFlux(Charges, Sources, Samples)};
+  UINT64 Freq;
+
+  QueryPerformanceFrequency((LARGE_INTEGER *)&Freq);
+
+  /* Flux per line deviation (sector flux to mean line flux): maximal sector and empty sectors */
+  struct result
+  {
+    dbl Time {0}, MaxShare {0};
+    size_t EmptySectors {0};
+  }; /* end of 'result' structure */
+
+  auto Run = [&]( bool IsFluxWeighted ) -> result
+    {
+      result Res {};
+      UINT64 Start, End;
+
+      QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+      const auto Angles {SeedAngles(Charges, Counts, IsFluxWeighted)};
+      QueryPerformanceCounter((LARGE_INTEGER *)&End);
+
+      Res.Time = (End - Start) * 1000.0 / Freq;
+
+      for (size_t i = 0; i < Angles.size(); i++)
+      {
+        const auto &A {Angles[i]};
+        const dbl *F {&Flux[i * Samples]};
+        dbl Total {0};
+
+        if (A.size() < 2)
+          continue;
+
+        for (size_t j = 0; j < Samples; j++)
+          Total += F[j];
+        if (!(Total > 0))
+          continue;
+
+        /* Every seed represents flux from half way to previous seed to half way to next one */
+        for (size_t k = 0; k < A.size(); k++)
+        {
+          const dbl
+            Prev {k == 0 ? A.back() - 2 * M_PI : A[k - 1]},
+            Next {k + 1 == A.size() ? A[0] + 2 * M_PI : A[k + 1]},
+            From {(Prev + A[k]) * 0.5},
+            To {(A[k] + Next) * 0.5};
+          dbl Sector {0};
+
+          for (INT64 j = (INT64)ceil(From / (2 * M_PI) * Samples - 0.5); j + 0.5 < To / (2 * M_PI) * Samples; j++)
+            Sector += F[(j % (INT64)Samples + (INT64)Samples) % (INT64)Samples];
+
+          const dbl Share {Sector / Total * A.size()};
+
+          Res.MaxShare = std::max(Res.MaxShare, Share);
+          Res.EmptySectors += Share < 0.05;
+        }
+      }
+
+      return Res;
+    };
+
+  const result
+    Uniform {Run(false)},
+    Weighted {Run(true)};
+  CHAR Buf[0x200];
+
+  sprintf(Buf,
+          "Seeds placement (%zu lines, flux per line relative to mean):\n"
+          "  - Uniform angles: %.3f ms, maximal %.2f, near empty lines %zu\n"
+          "  - Flux weighted: %.3f ms, maximal %.2f, near empty lines %zu\n",
+          Lines,
+          Uniform.Time, Uniform.MaxShare, Uniform.EmptySectors,
+          Weighted.Time, Weighted.MaxShare, Weighted.EmptySectors);
+
+  return Buf;
+} /* End of 'prj::phys::BenchmarkSeeding' function */
+
+/* END OF 'ef_seeding.cpp' FILE */
@@ -0,0 +1,54 @@
+/* FILE NAME   : 'ef_seeding.h'
+ * PURPOSE     : Physics module.
+ *               Force lines seeds placement handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#ifndef __ef_seeding_h__
+#define __ef_seeding_h__
+
+#include "ef_field.h"
+
+/* Project namespace // Physics module */
+namespace prj::phys
+{
+  /* Force lines seed angles on charges seed circles (radius is doubled charge size) placement function.
+   * Field is sampled on all seed circles in one batch, seeds are placed at equal quantiles of flux
+   * leaving positive charge (or coming to negative one), so neighbour charges distortion is accounted.
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Seeds count for every charge (in pool order, 0 - no seeds):
+   *       std::span<const size_t> Counts;
+   *   - Flux weighted placement flag (otherwise angles are uniform):
+   *       bool IsFluxWeighted;
+   *   - First seed angle for every charge (in pool order, empty - zero):
+   *       std::span<const dbl> Offsets;
+   *   - Periodic lattice evaluator (default: nullptr - charges are isolated):
+   *       const ewald_sum *Periodic;
+   *   - Grounded conductor boundary (default: none):
+   *       const boundary &Boundary;
+   * RETURNS:
+   *   (std::vector<std::vector<dbl>>) Seed angles for every charge.
+   */
+  std::vector<std::vector<dbl>> SeedAngles( const charge_pool &Charges, std::span<const size_t> Counts, bool IsFluxWeighted,
+                                            std::span<const dbl> Offsets = {}, const ewald_sum *Periodic = nullptr,
+                                            const boundary &Boundary = {} );
+
+  /* Uniform and flux weighted seeds placement comparison benchmark function.
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Lines per unit charge:
+   *       dbl LinesPerCharge;
+   * RETURNS:
+   *   (std::string) Report.
+   */
+  std::string BenchmarkSeeding( const charge_pool &Charges, dbl LinesPerCharge );
+} /* end of 'prj::phys' namespace */
+
+#endif /* __ef_seeding_h__ */
+
+/* END OF 'ef_seeding.h' FILE */
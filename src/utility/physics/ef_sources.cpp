@@ -0,0 +1,782 @@
+/* FILE NAME   : 'ef_sources.cpp'
+ * PURPOSE     : Physics module.
+ *               Extended (continuous) charge sources implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#include <pch.h>
+
+#include "ef_field.h"
+
+using namespace prj::phys;
+
+/* Complete elliptic integrals evaluation (arithmetic-geometric mean) function.
+ * ARGUMENTS:
+ *   - Modulus and complementary modulus:
+ *       dbl Mod, CoMod;
+ *   - Integrals of first and second kind (out):
+ *       dbl &K, &E;
+ */
+static void EllipticKE( dbl Mod, dbl CoMod, dbl &K, dbl &E )
+{
+  /* Iterations count is fixed (enough for complementary modulus down to 1e-15) */
+  constexpr INT Iterations {10};
+
+  dbl A {1}, B {CoMod}, Sum {Mod * Mod * 0.5}, Pow {0.5};
+
+  for (INT i = 0; i < Iterations; i++)
+  {
+    const dbl C {(A - B) * 0.5};
+
+    B = sqrt(A * B);
+    A -= C;
+    Pow *= 2;
+    Sum += Pow * C * C;
+  }
+
+  K = M_PI / (2 * A);
+  E = K * (1 - Sum);
+} /* End of 'EllipticKE' function */
+
+/* Uniformly charged segment field values evaluation function.
+ * Segment local frame: T - along direction, H - along normal (-Dir.Y, Dir.X), ends are at T1, T2 relative to point.
+ * ARGUMENTS:
+ *   - Segment:
+ *       const source_segment &Seg;
+ *   - Query point:
+ *       const coordd &P;
+ *   - Field vector, gradient and potential (values are added):
+ *       coordd &E;
+ *       dbl *D;
+ *       dbl *Phi;
+ */
+template<bool IsAll>
+  static void EvalSegment( const source_segment &Seg, const coordd &P, coordd &E, dbl *D, dbl *Phi )
+  {
+    const dbl
+      DX {P.X - Seg.Center.X}, DY {P.Y - Seg.Center.Y},
+      UX {Seg.Dir.X}, UY {Seg.Dir.Y},
+      L {Seg.HalfLength}, Lambda {Seg.Density},
+      T {DX * UX + DY * UY}, H {DY * UX - DX * UY},
+      T1 {-L - T}, T2 {L - T},
+      R1 {sqrt(T1 * T1 + H * H)}, R2 {sqrt(T2 * T2 + H * H)};
+
+    /* Normal component is (T2 / R2 - T1 / R1) / H, near segment line out of segment it is rewritten without cancellation */
+    const dbl S
+    {
+      T1 * T2 > 0 ?
+        -4 * L * T / (R1 * R2 * (T2 * R1 + T1 * R2)) :
+        (T2 / R2 - T1 / R1) / (H * H)
+    };
+    const dbl Ea {Lambda * (1 / R2 - 1 / R1)}, Eh {Lambda * H * S};
+
+    E.X += Ea * UX - Eh * UY;
+    E.Y += Ea * UY + Eh * UX;
+
+    if constexpr (IsAll)
+    {
+      const dbl
+        RevR13 {1 / (R1 * R1 * R1)}, RevR23 {1 / (R2 * R2 * R2)},
+        Daa {Lambda * (T2 * RevR23 - T1 * RevR13)},
+        Dah {Lambda * H * (RevR13 - RevR23)},
+        Dhh {-Daa - Lambda * S};
+
+      D[0] += UX * UX * Daa - 2 * UX * UY * Dah + UY * UY * Dhh;
+      D[1] += UX * UY * (Daa - Dhh) + (UX * UX - UY * UY) * Dah;
+      D[2] += UY * UY * Daa + 2 * UX * UY * Dah + UX * UX * Dhh;
+
+      /* Logarithm argument is taken from side without cancellation */
+      *Phi += Lambda * log(T >= 0 ? (R1 - T1) / (R2 - T2) : (T2 + R2) / (T1 + R1));
+    }
+  } /* End of 'EvalSegment' function */
+
+/* Uniformly charged disk (in plane points) field values evaluation function.
+ * Outside: Er = 4s (K(k) - E(k)), k = R / r, inside: Er = 4s (K(k) - E(k)) / k, k = r / R.
+ * ARGUMENTS:
+ *   - Disk:
+ *       const source_disk &Disk;
+ *   - Query point:
+ *       const coordd &P;
+ *   - Field vector, gradient and potential (values are added):
+ *       coordd &E;
+ *       dbl *D;
+ *       dbl *Phi;
+ */
+template<bool IsAll>
+  static void EvalDisk( const source_disk &Disk, const coordd &P, coordd &E, dbl *D, dbl *Phi )
+  {
+    const dbl
+      DX {P.X - Disk.Center.X}, DY {P.Y - Disk.Center.Y},
+      R {Disk.Radius}, Sigma4 {Disk.Density * 4},
+      Dist {std::max(sqrt(DX * DX + DY * DY), R * 1e-12)};
+    const bool IsOutside {Dist > R};
+
+    /* Small inner modulus is limited - field near center is almost zero, but its gradient has 0 / 0 */
+    const dbl
+      Mod {IsOutside ? R / Dist : std::max(Dist / R, 1e-4)},
+      CoMod2 {std::max(1 - Mod * Mod, 1e-30)};
+    dbl K, EI;
+
+    EllipticKE(Mod, sqrt(CoMod2), K, EI);
+
+    const dbl Er {IsOutside ? Sigma4 * (K - EI) : Sigma4 * (K - EI) / Mod};
+
+    E.X += Er * DX / Dist;
+    E.Y += Er * DY / Dist;
+
+    if constexpr (IsAll)
+    {
+      const dbl
+        DEr
+        {
+          IsOutside ?
+            -Sigma4 * EI * Mod * Mod / (Dist * CoMod2) :
+            Sigma4 / (R * Mod * Mod) * (EI * Mod * Mod / CoMod2 - K + EI)
+        },
+        CX {DX / Dist}, CY {DY / Dist}, ErR {Er / Dist};
+
+      D[0] += DEr * CX * CX + ErR * (1 - CX * CX);
+      D[1] += (DEr - ErR) * CX * CY;
+      D[2] += DEr * CY * CY + ErR * (1 - CY * CY);
+      *Phi += IsOutside ? Sigma4 * Dist * (EI - CoMod2 * K) : Sigma4 * R * EI;
+    }
+  } /* End of 'EvalDisk' function */
+
+/* Ideal point multipole field values evaluation function.
+ * With X = P - C, s = (u, X): dipole potential is p s / r^3, linear quadrupole one is Q (3s^2 - r^2) / 2r^5,
+ * so field is combination Cx X + Cu u and gradient is combination of I, X X^T, u u^T and (X u^T + u X^T).
+ * ARGUMENTS:
+ *   - Multipole:
+ *       const source_multipole &Mul;
+ *   - Query point:
+ *       const coordd &P;
+ *   - Field vector, gradient and potential (values are added):
+ *       coordd &E;
+ *       dbl *D;
+ *       dbl *Phi;
+ */
+template<bool IsAll>
+  static void EvalMultipole( const source_multipole &Mul, const coordd &P, coordd &E, dbl *D, dbl *Phi )
+  {
+    const dbl
+      DX {P.X - Mul.Center.X}, DY {P.Y - Mul.Center.Y},
+      UX {Mul.Dir.X}, UY {Mul.Dir.Y},
+      Dp {Mul.Dipole}, Qd {Mul.Quadrupole},
+      S {DX * UX + DY * UY},
+      R2 {DX * DX + DY * DY}, RevR2 {1 / R2},
+      RevR3 {RevR2 / sqrt(R2)}, RevR5 {RevR3 * RevR2}, RevR7 {RevR5 * RevR2},
+      Cx {3 * Dp * S * RevR5 + Qd * (7.5 * S * S * RevR7 - 1.5 * RevR5)},
+      Cu {-Dp * RevR3 - 3 * Qd * S * RevR5};
+
+    E.X += Cx * DX + Cu * UX;
+    E.Y += Cx * DY + Cu * UY;
+
+    if constexpr (IsAll)
+    {
+      const dbl
+        Dxu {3 * Dp * RevR5 + 15 * Qd * S * RevR7},
+        Dxx {-15 * Dp * S * RevR7 + Qd * (7.5 * RevR7 - 52.5 * S * S * RevR7 * RevR2)},
+        Duu {-3 * Qd * RevR5};
+
+      D[0] += Cx + 2 * Dxu * DX * UX + Dxx * DX * DX + Duu * UX * UX;
+      D[1] += Dxu * (DX * UY + UX * DY) + Dxx * DX * DY + Duu * UX * UY;
+      D[2] += Cx + 2 * Dxu * DY * UY + Dxx * DY * DY + Duu * UY * UY;
+      *Phi += Dp * S * RevR3 + Qd * (1.5 * S * S - 0.5 * R2) * RevR5;
+    }
+  } /* End of 'EvalMultipole' function */
+
+/* Constructor from charges pool (point charges are skipped).
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Grounded conductor boundary (default: none, screened sources are skipped):
+ *       const boundary &Boundary;
+ */
+source_elements::source_elements( const charge_pool &Charges, const boundary &Boundary )
+{
+  for (const auto &Elm : Charges)
+  {
+    /* Source with center inside conductor is screened */
+    if (!IsExtended(Elm) || (Boundary.IsValid() && Boundary.Distance(Elm.Coord) <= 0))
+      continue;
+
+    const auto &Shape {Elm.Shape};
+    const size_t FirstSegment {Segments.size()}, FirstDisk {Disks.size()}, FirstMultipole {Multipoles.size()};
+
+    switch (Shape.Type)
+    {
+    case source_type::Segment:
+      Segments.push_back({Elm.Coord, {cos(Shape.Angle), sin(Shape.Angle)}, Shape.Extent, Elm.Charge / (2 * Shape.Extent)});
+      break;
+    case source_type::Arc:
+      {
+        /* Equal chords with sagitta R (1 - cos(a / 2)) not greater than tolerance */
+        const dbl Sweep {std::clamp(Shape.Sweep, 1e-6, M_PI)};
+        const size_t Chords {std::clamp<size_t>((size_t)ceil(Sweep / acos(1 - ArcTolerance)), 1, MaxArcChords)};
+        const dbl
+          Half {Sweep / Chords},
+          Dist {Shape.Extent * cos(Half)},
+          HalfLength {Shape.Extent * sin(Half)};
+
+        for (size_t i = 0; i < Chords; i++)
+        {
+          const dbl Angle {Shape.Angle - Sweep + Half * (2 * i + 1)};
+
+          Segments.push_back({{Elm.Coord.X + Dist * cos(Angle), Elm.Coord.Y + Dist * sin(Angle)}, {-sin(Angle), cos(Angle)},
+                              HalfLength, Elm.Charge / Chords / (2 * HalfLength)});
+        }
+      }
+      break;
+    case source_type::Disk:
+      Disks.push_back({Elm.Coord, Shape.Extent, Elm.Charge / (M_PI * Shape.Extent * Shape.Extent)});
+      break;
+    case source_type::Dipole:
+      Multipoles.push_back({Elm.Coord, {cos(Shape.Angle), sin(Shape.Angle)}, Elm.Charge, 0});
+      break;
+    case source_type::Quadrupole:
+      Multipoles.push_back({Elm.Coord, {cos(Shape.Angle), sin(Shape.Angle)}, 0, Elm.Charge});
+      break;
+    default:
+      break;
+    }
+
+    /* Grounded plane image of element is mirrored element with opposite charge */
+    if (Boundary.Type == boundary_type::Line)
+    {
+      const coordd &N {Boundary.Normal};
+
+      auto Mirror = [&]( const coordd &P ) -> coordd
+        {
+          const dbl D {Boundary.Distance(P)};
+
+          return {P.X - N.X * 2 * D, P.Y - N.Y * 2 * D};
+        };
+
+      for (size_t i = FirstSegment, Count = Segments.size(); i < Count; i++)
+      {
+        const auto Seg {Segments[i]};
+        const dbl Dot {Seg.Dir.X * N.X + Seg.Dir.Y * N.Y};
+
+        Segments.push_back({Mirror(Seg.Center), {Seg.Dir.X - N.X * 2 * Dot, Seg.Dir.Y - N.Y * 2 * Dot}, Seg.HalfLength, -Seg.Density});
+      }
+
+      for (size_t i = FirstDisk, Count = Disks.size(); i < Count; i++)
+        Disks.push_back({Mirror(Disks[i].Center), Disks[i].Radius, -Disks[i].Density});
+
+      for (size_t i = FirstMultipole, Count = Multipoles.size(); i < Count; i++)
+      {
+        const auto Mul {Multipoles[i]};
+        const dbl Dot {Mul.Dir.X * N.X + Mul.Dir.Y * N.Y};
+
+        Multipoles.push_back({Mirror(Mul.Center), {Mul.Dir.X - N.X * 2 * Dot, Mul.Dir.Y - N.Y * 2 * Dot}, -Mul.Dipole, -Mul.Quadrupole});
+      }
+    }
+    /* Grounded sphere images of multipoles are exact: charge, dipole and quadrupole in inverse point
+     * (it is derivative of point charge image by charge position) */
+    else if (Boundary.Type == boundary_type::Circle && IsMultipole(Elm))
+    {
+      const auto Mul {Multipoles.back()};
+      const dbl
+        R {Boundary.Radius},
+        DX {Mul.Center.X - Boundary.Point.X}, DY {Mul.Center.Y - Boundary.Point.Y},
+        Dist {sqrt(DX * DX + DY * DY)}, NX {DX / Dist}, NY {DY / Dist},
+        Sn {Mul.Dir.X * NX + Mul.Dir.Y * NY}, K {R / Dist};
+      const coordd
+        IC {Boundary.Point.X + NX * R * K, Boundary.Point.Y + NY * R * K},
+        W {Mul.Dir.X - 2 * Sn * NX, Mul.Dir.Y - 2 * Sn * NY};
+
+      if (Mul.Dipole != 0)
+      {
+        Points.push_back({IC, Mul.Dipole * R * Sn / (Dist * Dist)});
+        Multipoles.push_back({IC, W, -Mul.Dipole * K * K * K, 0});
+      }
+      if (Mul.Quadrupole != 0)
+      {
+        /* Image dipole axis is not along quadrupole axis, so it is separate element */
+        const dbl
+          Qd {Mul.Quadrupole},
+          VX {3 * Sn * Mul.Dir.X + (1 - 6 * Sn * Sn) * NX},
+          VY {3 * Sn * Mul.Dir.Y + (1 - 6 * Sn * Sn) * NY},
+          Len {hypot(VX, VY)};
+
+        Points.push_back({IC, Qd * 0.5 * R * (1 - 3 * Sn * Sn) / (Dist * Dist * Dist)});
+        if (Len > 0)
+          Multipoles.push_back({IC, {VX / Len, VY / Len}, Qd * R * R * R / (Dist * Dist * Dist * Dist) * Len, 0});
+        Multipoles.push_back({IC, W, 0, -Qd * K * K * K * K * K});
+      }
+    }
+    /* Grounded sphere image of source is not uniform, so source samples images are used */
+    else if (Boundary.Type == boundary_type::Circle)
+    {
+      std::vector<std::pair<coordd, dbl>> Samples {};
+
+      SourcePoints(Elm, ImageSamples, Samples);
+      for (const auto &[C, Q] : Samples)
+      {
+        coordd IC;
+        dbl IQ;
+
+        if (Boundary.Image(C, Q, IC, IQ))
+          Points.push_back({IC, IQ});
+      }
+    }
+  }
+} /* End of 'source_elements::source_elements' function */
+
+/* Field vector evaluation function.
+ * ARGUMENTS:
+ *   - Query point:
+ *       const coordd &P;
+ * RETURNS:
+ *   (coordd) Field vector.
+ */
+coordd source_elements::EvalField( const coordd &P ) const
+{
+  coordd E {0, 0};
+
+  for (const auto &Seg : Segments)
+    EvalSegment<false>(Seg, P, E, nullptr, nullptr);
+  for (const auto &Disk : Disks)
+    EvalDisk<false>(Disk, P, E, nullptr, nullptr);
+  for (const auto &Mul : Multipoles)
+    EvalMultipole<false>(Mul, P, E, nullptr, nullptr);
+  for (const auto &[C, Q] : Points)
+  {
+    const dbl DX {P.X - C.X}, DY {P.Y - C.Y}, R {sqrt(DX * DX + DY * DY)}, QR3 {Q / (R * R * R)};
+
+    E.X += QR3 * DX, E.Y += QR3 * DY;
+  }
+
+  return E;
+} /* End of 'source_elements::EvalField' function */
+
+/* All field values accumulation function.
+ * ARGUMENTS:
+ *   - Query point:
+ *       const coordd &P;
+ *   - Field vector, gradient (dEx/dx, dEx/dy = dEy/dx, dEy/dy) and potential (values are added):
+ *       coordd &E;
+ *       dbl (&D)[3];
+ *       dbl &Phi;
+ */
+void source_elements::EvalSample( const coordd &P, coordd &E, dbl (&D)[3], dbl &Phi ) const
+{
+  for (const auto &Seg : Segments)
+    EvalSegment<true>(Seg, P, E, D, &Phi);
+  for (const auto &Disk : Disks)
+    EvalDisk<true>(Disk, P, E, D, &Phi);
+  for (const auto &Mul : Multipoles)
+    EvalMultipole<true>(Mul, P, E, D, &Phi);
+  for (const auto &[C, Q] : Points)
+  {
+    const dbl
+      DX {P.X - C.X}, DY {P.Y - C.Y},
+      R2 {DX * DX + DY * DY}, R {sqrt(R2)},
+      QR3 {Q / (R2 * R)}, QR5 {3 * QR3 / R2};
+
+    E.X += QR3 * DX, E.Y += QR3 * DY;
+    D[0] += QR3 - QR5 * DX * DX;
+    D[1] -= QR5 * DX * DY;
+    D[2] += QR3 - QR5 * DY * DY;
+    Phi += Q / R;
+  }
+} /* End of 'source_elements::EvalSample' function */
+
+/* Distance from point to source evaluation function.
+ * ARGUMENTS:
+ *   - Charge:
+ *       const charge &Elm;
+ *   - Point:
+ *       const coordd &P;
+ *   - Nearest source point (out, may be nullptr):
+ *       coordd *Nearest;
+ * RETURNS:
+ *   (dbl) Distance (zero inside disk).
+ */
+dbl prj::phys::SourceDistance( const charge &Elm, const coordd &P, coordd *Nearest )
+{
+  const auto &Shape {Elm.Shape};
+  const dbl DX {P.X - Elm.Coord.X}, DY {P.Y - Elm.Coord.Y};
+  coordd Res {Elm.Coord};
+
+  switch (Shape.Type)
+  {
+  case source_type::Segment:
+    {
+      const dbl
+        UX {cos(Shape.Angle)}, UY {sin(Shape.Angle)},
+        T {std::clamp(DX * UX + DY * UY, -Shape.Extent, Shape.Extent)};
+
+      Res = {Elm.Coord.X + UX * T, Elm.Coord.Y + UY * T};
+    }
+    break;
+  case source_type::Arc:
+    {
+      const dbl Angle {atan2(DY, DX)};
+
+      if (abs(remainder(Angle - Shape.Angle, 2 * M_PI)) <= Shape.Sweep)
+        Res = {Elm.Coord.X + Shape.Extent * cos(Angle), Elm.Coord.Y + Shape.Extent * sin(Angle)};
+      else
+      {
+        /* Nearest arc end */
+        const coordd
+          A {Elm.Coord.X + Shape.Extent * cos(Shape.Angle - Shape.Sweep), Elm.Coord.Y + Shape.Extent * sin(Shape.Angle - Shape.Sweep)},
+          B {Elm.Coord.X + Shape.Extent * cos(Shape.Angle + Shape.Sweep), Elm.Coord.Y + Shape.Extent * sin(Shape.Angle + Shape.Sweep)};
+
+        Res = hypot(P.X - A.X, P.Y - A.Y) < hypot(P.X - B.X, P.Y - B.Y) ? A : B;
+      }
+    }
+    break;
+  case source_type::Disk:
+    {
+      const dbl Dist {hypot(DX, DY)};
+
+      if (Dist <= Shape.Extent)
+        Res = P;
+      else
+        Res = {Elm.Coord.X + DX * Shape.Extent / Dist, Elm.Coord.Y + DY * Shape.Extent / Dist};
+    }
+    break;
+  default:
+    break;
+  }
+
+  if (Nearest != nullptr)
+    *Nearest = Res;
+  return hypot(P.X - Res.X, P.Y - Res.Y);
+} /* End of 'prj::phys::SourceDistance' function */
+
+/* Point on source contour (curve on fixed distance around source) evaluation function.
+ * ARGUMENTS:
+ *   - Charge:
+ *       const charge &Elm;
+ *   - Contour parameter (in [0; 2pi), wrapped):
+ *       dbl Param;
+ *   - Distance from source:
+ *       dbl Distance;
+ *   - Nearest source point (out, line start point):
+ *       coordd &Base;
+ * RETURNS:
+ *   (coordd) Contour point.
+ */
+coordd prj::phys::SourceContour( const charge &Elm, dbl Param, dbl Distance, coordd &Base )
+{
+  const auto &Shape {Elm.Shape};
+  const coordd &C {Elm.Coord};
+  const dbl Part {Param / (2 * M_PI) - floor(Param / (2 * M_PI))};
+
+  switch (Shape.Type)
+  {
+  case source_type::Segment:
+    {
+      /* Stadium: upper side, end cap, lower side, start cap */
+      const dbl
+        L {Shape.Extent}, D {Distance},
+        UX {cos(Shape.Angle)}, UY {sin(Shape.Angle)},
+        S {Part * (4 * L + 2 * M_PI * D)};
+      dbl A, H, BaseA;
+
+      if (S < 2 * L)
+        BaseA = A = S - L, H = D;
+      else if (S < 2 * L + M_PI * D)
+      {
+        const dbl Phi {(S - 2 * L) / D};
+
+        BaseA = L, A = L + D * sin(Phi), H = D * cos(Phi);
+      }
+      else if (S < 4 * L + M_PI * D)
+        BaseA = A = L - (S - 2 * L - M_PI * D), H = -D;
+      else
+      {
+        const dbl Phi {(S - 4 * L - M_PI * D) / D};
+
+        BaseA = -L, A = -L - D * sin(Phi), H = -D * cos(Phi);
+      }
+
+      Base = {C.X + UX * BaseA, C.Y + UY * BaseA};
+      return {C.X + UX * A - UY * H, C.Y + UY * A + UX * H};
+    }
+  case source_type::Arc:
+    {
+      /* Outer arc, end cap, inner arc, start cap */
+      const dbl
+        R {Shape.Extent}, D {Distance}, Sweep {Shape.Sweep},
+        Inner {std::max(R - D, 0.0)},
+        S {Part * (2 * Sweep * (R + D) + 2 * Sweep * Inner + 2 * M_PI * D)};
+      dbl Angle, Radius;
+
+      if (S < 2 * Sweep * (R + D))
+        Angle = Shape.Angle - Sweep + S / (R + D), Radius = R + D;
+      else if (S < 2 * Sweep * (R + D) + M_PI * D)
+      {
+        const dbl Phi {(S - 2 * Sweep * (R + D)) / D};
+
+        Angle = Shape.Angle + Sweep;
+        Base = {C.X + R * cos(Angle), C.Y + R * sin(Angle)};
+        return {Base.X + D * (cos(Phi) * cos(Angle) - sin(Phi) * sin(Angle)),
+                Base.Y + D * (cos(Phi) * sin(Angle) + sin(Phi) * cos(Angle))};
+      }
+      else if (S < 2 * Sweep * (R + D) + M_PI * D + 2 * Sweep * Inner)
+        Angle = Shape.Angle + Sweep - (S - 2 * Sweep * (R + D) - M_PI * D) / std::max(Inner, 1e-30), Radius = Inner;
+      else
+      {
+        const dbl Phi {(S - 2 * Sweep * (R + D) - M_PI * D - 2 * Sweep * Inner) / D};
+
+        Angle = Shape.Angle - Sweep;
+        Base = {C.X + R * cos(Angle), C.Y + R * sin(Angle)};
+        return {Base.X - D * (cos(Phi) * cos(Angle) - sin(Phi) * sin(Angle)),
+                Base.Y - D * (cos(Phi) * sin(Angle) + sin(Phi) * cos(Angle))};
+      }
+
+      Base = {C.X + R * cos(Angle), C.Y + R * sin(Angle)};
+      return {C.X + Radius * cos(Angle), C.Y + Radius * sin(Angle)};
+    }
+  case source_type::Disk:
+    Base = {C.X + Shape.Extent * cos(Param), C.Y + Shape.Extent * sin(Param)};
+    return {C.X + (Shape.Extent + Distance) * cos(Param), C.Y + (Shape.Extent + Distance) * sin(Param)};
+  default:
+    Base = C;
+    return {C.X + Distance * cos(Param), C.Y + Distance * sin(Param)};
+  }
+} /* End of 'prj::phys::SourceContour' function */
+
+/* Contour parameter of nearest to point contour point evaluation function (inverse of 'SourceContour').
+ * ARGUMENTS:
+ *   - Charge:
+ *       const charge &Elm;
+ *   - Point near source:
+ *       const coordd &P;
+ *   - Contour distance from source:
+ *       dbl Distance;
+ * RETURNS:
+ *   (dbl) Contour parameter in [0; 2pi).
+ */
+dbl prj::phys::SourceParam( const charge &Elm, const coordd &P, dbl Distance )
+{
+  const auto &Shape {Elm.Shape};
+  const dbl DX {P.X - Elm.Coord.X}, DY {P.Y - Elm.Coord.Y}, D {Distance};
+  dbl S, Length;
+
+  switch (Shape.Type)
+  {
+  case source_type::Segment:
+    {
+      const dbl
+        L {Shape.Extent},
+        UX {cos(Shape.Angle)}, UY {sin(Shape.Angle)},
+        A {DX * UX + DY * UY}, H {DY * UX - DX * UY};
+
+      Length = 4 * L + 2 * M_PI * D;
+      if (A >= L)
+        S = 2 * L + D * std::clamp(atan2(A - L, H), 0.0, M_PI);
+      else if (A <= -L)
+        S = 4 * L + M_PI * D + D * std::clamp(atan2(-A - L, -H), 0.0, M_PI);
+      else if (H >= 0)
+        S = A + L;
+      else
+        S = 2 * L + M_PI * D + L - A;
+    }
+    break;
+  case source_type::Arc:
+    {
+      const dbl
+        R {Shape.Extent}, Sweep {Shape.Sweep},
+        Inner {std::max(R - D, 0.0)},
+        Delta {remainder(atan2(DY, DX) - Shape.Angle, 2 * M_PI)};
+
+      Length = 2 * Sweep * (R + D) + 2 * Sweep * Inner + 2 * M_PI * D;
+      if (abs(Delta) <= Sweep)
+        S = hypot(DX, DY) >= R ?
+          (Delta + Sweep) * (R + D) :
+          2 * Sweep * (R + D) + M_PI * D + (Sweep - Delta) * Inner;
+      else
+      {
+        /* Cap around nearest end (angle from radial direction to tangent directed out of arc) */
+        const bool IsEnd {Delta > 0};
+        const dbl
+          Angle {Shape.Angle + (IsEnd ? Sweep : -Sweep)},
+          VX {DX - R * cos(Angle)}, VY {DY - R * sin(Angle)},
+          Radial {VX * cos(Angle) + VY * sin(Angle)},
+          Tangent {-VX * sin(Angle) + VY * cos(Angle)};
+
+        S = IsEnd ?
+          2 * Sweep * (R + D) + D * std::clamp(atan2(Tangent, Radial), 0.0, M_PI) :
+          2 * Sweep * (R + D) + M_PI * D + 2 * Sweep * Inner + D * std::clamp(atan2(-Tangent, -Radial), 0.0, M_PI);
+      }
+    }
+    break;
+  default:
+    S = atan2(DY, DX), Length = 2 * M_PI;
+    break;
+  }
+
+  const dbl Param {2 * M_PI * S / Length};
+
+  return Param - 2 * M_PI * floor(Param / (2 * M_PI));
+} /* End of 'prj::phys::SourceParam' function */
+
+/* Source discretization into equal point charges function.
+ * ARGUMENTS:
+ *   - Charge:
+ *       const charge &Elm;
+ *   - Samples count (point charge is always single sample, multipole is charges pair or triple on half size):
+ *       size_t Count;
+ *   - Point charges (out, appended):
+ *       std::vector<std::pair<coordd, dbl>> &Out;
+ */
+void prj::phys::SourcePoints( const charge &Elm, size_t Count, std::vector<std::pair<coordd, dbl>> &Out )
+{
+  const auto &Shape {Elm.Shape};
+  const coordd &C {Elm.Coord};
+
+  if (IsMultipole(Elm))
+  {
+    const dbl A {Elm.Size * 0.5}, UX {cos(Shape.Angle) * A}, UY {sin(Shape.Angle) * A};
+
+    if (Shape.Type == source_type::Dipole)
+    {
+      Out.push_back({{C.X + UX, C.Y + UY}, Elm.Charge / (2 * A)});
+      Out.push_back({{C.X - UX, C.Y - UY}, -Elm.Charge / (2 * A)});
+    }
+    else
+    {
+      const dbl Q {Elm.Charge / (2 * A * A)};
+
+      Out.push_back({{C.X + UX, C.Y + UY}, Q});
+      Out.push_back({C, -2 * Q});
+      Out.push_back({{C.X - UX, C.Y - UY}, Q});
+    }
+    return;
+  }
+
+  if (Shape.Type == source_type::Point || Count == 0)
+  {
+    Out.push_back({C, Elm.Charge});
+    return;
+  }
+
+  const dbl Q {Elm.Charge / Count};
+
+  for (size_t i = 0; i < Count; i++)
+  {
+    const dbl T {(i + 0.5) / Count};
+
+    switch (Shape.Type)
+    {
+    case source_type::Segment:
+      Out.push_back({{C.X + cos(Shape.Angle) * Shape.Extent * (2 * T - 1), C.Y + sin(Shape.Angle) * Shape.Extent * (2 * T - 1)}, Q});
+      break;
+    case source_type::Arc:
+      {
+        const dbl Angle {Shape.Angle + Shape.Sweep * (2 * T - 1)};
+
+        Out.push_back({{C.X + Shape.Extent * cos(Angle), C.Y + Shape.Extent * sin(Angle)}, Q});
+      }
+      break;
+    default:
+      {
+        /* Sunflower spiral gives equal area per sample */
+        const dbl Radius {Shape.Extent * sqrt(T)}, Angle {i * M_PI * (3 - sqrt(5.0))};
+
+        Out.push_back({{C.X + Radius * cos(Angle), C.Y + Radius * sin(Angle)}, Q});
+      }
+      break;
+    }
+  }
+} /* End of 'prj::phys::SourcePoints' function */
+
+/* Analytic sources versus discretized point charges benchmark function.
+ * ARGUMENTS:
+ *   - Point charges per source:
+ *       size_t Samples;
+ *   - Query points count:
+ *       size_t Count;
+ * RETURNS:
+ *   (std::string) Report.
+ */
+std::string prj::phys::BenchmarkSources( size_t Samples, size_t Count )
+{
+  const std::pair<const CHAR *, source_shape> Shapes[]
+  {
+    {"segment", {source_type::Segment, 4, 0.3, 0}},
+    {"arc", {source_type::Arc, 4, 0.3, M_PI / 2}},
+    {"disk", {source_type::Disk, 3, 0, 0}},
+    {"dipole", {source_type::Dipole, 0, 0.3, 0}},
+    {"quadrupole", {source_type::Quadrupole, 0, 0.3, 0}},
+  };
+
+  UINT64 Freq;
+  std::string Res {"Analytic sources benchmark (" + std::to_string(Samples) + " point charges per source, E + grad E + potential):\n"};
+
+  QueryPerformanceFrequency((LARGE_INTEGER *)&Freq);
+
+  for (const auto &[Name, Shape] : Shapes)
+  {
+    const charge_pool Analytic {{{0, 0}, 10, 0.25, Shape}};
+    std::vector<std::pair<coordd, dbl>> Points {};
+    charge_pool Discrete {};
+
+    SourcePoints(Analytic[0], Samples, Points);
+    for (const auto &[C, Q] : Points)
+      Discrete.Add({C, Q, 0.25});
+
+    /* Query points on grid out of discretization error neighbourhood */
+    const size_t Side {(size_t)ceil(sqrt((dbl)Count))};
+    std::vector<coordd> Query {};
+
+    for (size_t y = 0; y < Side; y++)
+      for (size_t x = 0; x < Side; x++)
+      {
+        const coordd P {-8 + 16 * (x + 0.5) / Side, -8 + 16 * (y + 0.5) / Side};
+
+        if (SourceDistance(Analytic[0], P) > 1)
+          Query.push_back(P);
+      }
+
+    std::vector<dbl> A(Query.size() * 6), B(Query.size() * 6);
+
+    auto Outputs = [&]( std::vector<dbl> &V ) -> field_out
+      {
+        const size_t N {Query.size()};
+
+        return {&V[0], &V[N], &V[N * 2], &V[N * 3], &V[N * 4], &V[N * 5]};
+      };
+
+    UINT64 Start, AnalyticTime, DiscreteTime;
+    const field_snapshot AnalyticSnapshot {Analytic}, DiscreteSnapshot {Discrete};
+
+    QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+    EvalField(AnalyticSnapshot, Query.data(), Query.size(), Outputs(A));
+    QueryPerformanceCounter((LARGE_INTEGER *)&AnalyticTime);
+    AnalyticTime -= Start;
+
+    QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+    EvalField(DiscreteSnapshot, Query.data(), Query.size(), Outputs(B));
+    QueryPerformanceCounter((LARGE_INTEGER *)&DiscreteTime);
+    DiscreteTime -= Start;
+
+    /* Field vector and potential relative difference */
+    const size_t N {Query.size()};
+    dbl MaxField {0}, MaxPotential {0};
+
+    for (size_t i = 0; i < N; i++)
+    {
+      MaxField = std::max(MaxField, hypot(A[i] - B[i], A[N + i] - B[N + i]) / std::max(hypot(B[i], B[N + i]), 1e-12));
+      MaxPotential = std::max(MaxPotential, abs(A[N * 5 + i] - B[N * 5 + i]) / std::max(abs(B[N * 5 + i]), 1e-12));
+    }
+
+    CHAR Buf[0x200];
+
+    sprintf(Buf,
+            "  - %s: analytic %.1f ns/point, point charges %.1f ns/point (%.1fx), max relative difference E %.2e, potential %.2e\n",
+            Name, AnalyticTime * 1e9 / Freq / std::max<size_t>(N, 1), DiscreteTime * 1e9 / Freq / std::max<size_t>(N, 1),
+            (dbl)DiscreteTime / std::max<UINT64>(AnalyticTime, 1), MaxField, MaxPotential);
+    Res += Buf;
+  }
+
+  return Res;
+} /* End of 'prj::phys::BenchmarkSources' function */
+
+/* END OF 'ef_sources.cpp' FILE */
@@ -0,0 +1,214 @@
+/* FILE NAME   : 'ef_sources.h'
+ * PURPOSE     : Physics module.
+ *               Extended (continuous) charge sources handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#ifndef __ef_sources_h__
+#define __ef_sources_h__
+
+#include "ef_boundary.h"
+
+/* Project namespace // Physics module */
+namespace prj::phys
+{
+  /* Uniformly charged segment analytic element */
+  struct source_segment
+  {
+    coordd Center;  /* Segment center */
+    coordd Dir;     /* Unit direction */
+    dbl HalfLength; /* Half length */
+    dbl Density;    /* Line charge density */
+  }; /* end of 'source_segment' structure */
+
+  /* Uniformly charged disk analytic element */
+  struct source_disk
+  {
+    coordd Center; /* Disk center */
+    dbl Radius;    /* Disk radius */
+    dbl Density;   /* Surface charge density */
+  }; /* end of 'source_disk' structure */
+
+  /* Ideal point multipole analytic element (dipole and linear quadrupole with common axis) */
+  struct source_multipole
+  {
+    coordd Center;   /* Multipole position */
+    coordd Dir;      /* Unit axis direction */
+    dbl Dipole;      /* Dipole moment along axis */
+    dbl Quadrupole;  /* Linear quadrupole moment */
+  }; /* end of 'source_multipole' structure */
+
+  /* Extended sources analytic elements set.
+   * Segment and disk have closed form fields (disk one is expressed by complete elliptic integrals).
+   * Arc field is not elementary, so arcs are split into chord segments with sagitta below 'ArcTolerance' of radius.
+   * Multipoles are point derivatives of charge field, so their boundary images are exact too.
+   */
+  class source_elements
+  {
+  public:
+    /* Analytic elements */
+    std::vector<source_segment> Segments {};
+    std::vector<source_disk> Disks {};
+    std::vector<source_multipole> Multipoles {};
+
+    /* Fixed point charges (grounded circle images of sources - they have no exact elements, so sources samples are imaged,
+     * multipoles images have exact charge part) */
+    std::vector<std::pair<coordd, dbl>> Points {};
+
+    /* Arc chord maximal sagitta (in arc radius) and maximal chords count */
+    static constexpr dbl ArcTolerance {1e-3};
+    static constexpr size_t MaxArcChords {64};
+
+    /* Samples per source for grounded circle images */
+    static constexpr size_t ImageSamples {64};
+
+    /* Default constructor */
+    source_elements( void ) = default;
+
+    /* Constructor from charges pool (point charges are skipped).
+     * ARGUMENTS:
+     *   - Charges pool:
+     *       const charge_pool &Charges;
+     *   - Grounded conductor boundary (default: none, screened sources are skipped):
+     *       const boundary &Boundary;
+     */
+    source_elements( const charge_pool &Charges, const boundary &Boundary = {} );
+
+    /* Elements absence check function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (bool) true if there are no elements.
+     */
+    bool IsEmpty( void ) const
+    {
+      return Segments.empty() && Disks.empty() && Multipoles.empty() && Points.empty();
+    } /* End of 'IsEmpty' function */
+
+    /* Field vector evaluation function.
+     * ARGUMENTS:
+     *   - Query point:
+     *       const coordd &P;
+     * RETURNS:
+     *   (coordd) Field vector.
+     */
+    coordd EvalField( const coordd &P ) const;
+
+    /* All field values accumulation function.
+     * ARGUMENTS:
+     *   - Query point:
+     *       const coordd &P;
+     *   - Field vector, gradient (dEx/dx, dEx/dy = dEy/dx, dEy/dy) and potential (values are added):
+     *       coordd &E;
+     *       dbl (&D)[3];
+     *       dbl &Phi;
+     */
+    void EvalSample( const coordd &P, coordd &E, dbl (&D)[3], dbl &Phi ) const;
+  }; /* end of 'source_elements' class */
+
+  /* Extended source check function.
+   * ARGUMENTS:
+   *   - Charge:
+   *       const charge &Elm;
+   * RETURNS:
+   *   (bool) true if charge is not point one.
+   */
+  inline bool IsExtended( const charge &Elm )
+  {
+    return Elm.Shape.Type != source_type::Point;
+  } /* End of 'IsExtended' function */
+
+  /* Point multipole check function.
+   * ARGUMENTS:
+   *   - Charge:
+   *       const charge &Elm;
+   * RETURNS:
+   *   (bool) true if charge is dipole or quadrupole.
+   */
+  inline bool IsMultipole( const charge &Elm )
+  {
+    return Elm.Shape.Type == source_type::Dipole || Elm.Shape.Type == source_type::Quadrupole;
+  } /* End of 'IsMultipole' function */
+
+  /* Source bounding radius (around charge coordinate, without thickness) getting function.
+   * ARGUMENTS:
+   *   - Source shape:
+   *       const source_shape &Shape;
+   * RETURNS:
+   *   (dbl) Radius (zero for point charge).
+   */
+  inline dbl SourceRadius( const source_shape &Shape )
+  {
+    return Shape.Type == source_type::Segment || Shape.Type == source_type::Arc || Shape.Type == source_type::Disk ? Shape.Extent : 0;
+  } /* End of 'SourceRadius' function */
+
+  /* Distance from point to source evaluation function.
+   * ARGUMENTS:
+   *   - Charge:
+   *       const charge &Elm;
+   *   - Point:
+   *       const coordd &P;
+   *   - Nearest source point (out, may be nullptr):
+   *       coordd *Nearest;
+   * RETURNS:
+   *   (dbl) Distance (zero inside disk).
+   */
+  dbl SourceDistance( const charge &Elm, const coordd &P, coordd *Nearest = nullptr );
+
+  /* Point on source contour (curve on fixed distance around source) evaluation function.
+   * Contour parameter is proportional to contour length, for point charge it is polar angle,
+   * so force lines seeds are contour points on distance of doubled charge size.
+   * ARGUMENTS:
+   *   - Charge:
+   *       const charge &Elm;
+   *   - Contour parameter (in [0; 2pi), wrapped):
+   *       dbl Param;
+   *   - Distance from source:
+   *       dbl Distance;
+   *   - Nearest source point (out, line start point):
+   *       coordd &Base;
+   * RETURNS:
+   *   (coordd) Contour point.
+   */
+  coordd SourceContour( const charge &Elm, dbl Param, dbl Distance, coordd &Base );
+
+  /* Contour parameter of nearest to point contour point evaluation function (inverse of 'SourceContour').
+   * ARGUMENTS:
+   *   - Charge:
+   *       const charge &Elm;
+   *   - Point near source:
+   *       const coordd &P;
+   *   - Contour distance from source:
+   *       dbl Distance;
+   * RETURNS:
+   *   (dbl) Contour parameter in [0; 2pi).
+   */
+  dbl SourceParam( const charge &Elm, const coordd &P, dbl Distance );
+
+  /* Source discretization into equal point charges function.
+   * ARGUMENTS:
+   *   - Charge:
+   *       const charge &Elm;
+   *   - Samples count (point charge is always single sample, multipole is charges pair or triple on half size):
+   *       size_t Count;
+   *   - Point charges (out, appended):
+   *       std::vector<std::pair<coordd, dbl>> &Out;
+   */
+  void SourcePoints( const charge &Elm, size_t Count, std::vector<std::pair<coordd, dbl>> &Out );
+
+  /* Analytic sources versus discretized point charges benchmark function.
+   * ARGUMENTS:
+   *   - Point charges per source:
+   *       size_t Samples;
+   *   - Query points count:
+   *       size_t Count;
+   * RETURNS:
+   *   (std::string) Report.
+   */
+  std::string BenchmarkSources( size_t Samples, size_t Count );
+} /* end of 'prj::phys' namespace */
+
+#endif /* __ef_sources_h__ */
+
+/* END OF 'ef_sources.h' FILE */
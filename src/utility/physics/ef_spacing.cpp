@@ -0,0 +1,304 @@
+/* FILE NAME   : 'ef_spacing.cpp'
+ * PURPOSE     : Physics module.
+ *               Evenly spaced force lines occupancy grid implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#include <pch.h>
+
+#include "ef_spacing.h"
+#include "ef_force_lines.h"
+#include "ef_nulls.h"
+
+using namespace prj::phys;
+
+/* Other lines in cell neighbourhood check function.
+ * ARGUMENTS:
+ *   - Cell indices:
+ *       INT CX, CY;
+ *   - Neighbourhood radius (in cells):
+ *       INT Radius;
+ *   - Line identifier (its own cells are skipped):
+ *       UINT32 Id;
+ *   - Exempt cells are treated as occupied flag:
+ *       bool IsExemptOccupied;
+ * RETURNS:
+ *   (bool) true if other line is near.
+ */
+bool line_spacing::IsOccupied( INT CX, INT CY, INT Radius, UINT32 Id, bool IsExemptOccupied ) const
+{
+  for (INT y = std::max(CY - Radius, 0); y <= std::min(CY + Radius, GridH - 1); y++)
+    for (INT x = std::max(CX - Radius, 0); x <= std::min(CX + Radius, GridW - 1); x++)
+    {
+      const UINT32 Value {Cells[(size_t)y * GridW + x].load(std::memory_order_relaxed)};
+
+      if (Value == Exempt ? IsExemptOccupied : Value != Empty && Value != Id)
+        return true;
+    }
+
+  return false;
+} /* End of 'line_spacing::IsOccupied' function */
+
+/* Grid resetting function.
+ * ARGUMENTS:
+ *   - Grid region corners:
+ *       const coordd &Min, &Max;
+ *   - Separation distance between lines:
+ *       dbl NewSeparation;
+ *   - Minimal cell size (lines with longer steps leave gaps in grid):
+ *       dbl MinCellSize;
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ */
+void line_spacing::Reset( const coordd &Min, const coordd &Max, dbl NewSeparation, dbl MinCellSize, const charge_pool &Charges )
+{
+  /* Neighbour cells are closer than 2/3 of separation, while seeds at separation distance are never neighbours */
+  const dbl CellSize {std::max({NewSeparation / 3, MinCellSize,
+                                (Max.X - Min.X) / MaxGridSize, (Max.Y - Min.Y) / MaxGridSize})};
+
+  Separation = NewSeparation;
+  MinX = Min.X, MinY = Min.Y;
+  RevCellSize = 1 / CellSize;
+  GridW = std::max((INT)ceil((Max.X - Min.X) * RevCellSize), 1);
+  GridH = std::max((INT)ceil((Max.Y - Min.Y) * RevCellSize), 1);
+  Cells = std::make_unique<std::atomic<UINT32>[]>((size_t)GridW * GridH);
+
+  /* All lines of charge converge near it, so its neighbourhood is not tested */
+  for (const auto &Elm : Charges)
+  {
+    const dbl
+      Radius {Elm.Size * 2 + Separation},
+      Bound {Radius + SourceRadius(Elm.Shape)};
+    INT X0, Y0, X1, Y1;
+
+    GetCell(Elm.Coord.X - Bound, Elm.Coord.Y - Bound, X0, Y0);
+    GetCell(Elm.Coord.X + Bound, Elm.Coord.Y + Bound, X1, Y1);
+
+    for (INT y = std::max(Y0, 0); y <= std::min(Y1, GridH - 1); y++)
+      for (INT x = std::max(X0, 0); x <= std::min(X1, GridW - 1); x++)
+        if (SourceDistance(Elm, {MinX + (x + 0.5) * CellSize, MinY + (y + 0.5) * CellSize}) < Radius)
+          Cells[(size_t)y * GridW + x].store(Exempt, std::memory_order_relaxed);
+  }
+
+  LastId = 0;
+  Stats = {};
+} /* End of 'line_spacing::Reset' function */
+
+/* Line point marking function (thread safe).
+ * ARGUMENTS:
+ *   - Point:
+ *       const coordf &Pt;
+ *   - Line identifier:
+ *       UINT32 Id;
+ * RETURNS:
+ *   (bool) false if point is too close to other line (line must be terminated).
+ */
+bool line_spacing::Mark( const coordf &Pt, UINT32 Id )
+{
+  INT CX, CY;
+
+  /* Lines are not limited out of grid */
+  if (!GetCell(Pt.X, Pt.Y, CX, CY))
+    return true;
+
+  auto &Cell {Cells[(size_t)CY * GridW + CX]};
+  UINT32 Value {Cell.load(std::memory_order_relaxed)};
+
+  if (Value == Exempt)
+    return true;
+
+  if (IsOccupied(CX, CY, 1, Id, false))
+    return false;
+
+  /* Line which lost cell race is terminated on its next point */
+  if (Value == Empty)
+    Cell.compare_exchange_strong(Value, Id, std::memory_order_relaxed);
+
+  return true;
+} /* End of 'line_spacing::Mark' function */
+
+/* Seeds aside line searching function (accepted seeds are marked with new line identifiers).
+ * ARGUMENTS:
+ *   - Line points:
+ *       const std::vector<coordf> &Line;
+ *   - Seeds with their lines identifiers (appended):
+ *       std::vector<std::pair<coordd, UINT32>> &Seeds;
+ * RETURNS:
+ *   (size_t) Found seeds count.
+ */
+size_t line_spacing::FindSeeds( const std::vector<coordf> &Line, std::vector<std::pair<coordd, UINT32>> &Seeds )
+{
+  size_t Found {0};
+  dbl Path {Separation};
+
+  /* Candidates are tested every half of separation on both sides of line */
+  for (size_t i = 1; i + 1 < Line.size(); i++)
+  {
+    Path += hypot(Line[i].X - Line[i - 1].X, Line[i].Y - Line[i - 1].Y);
+    if (Path < Separation * 0.5)
+      continue;
+
+    const dbl
+      DX {(dbl)Line[i + 1].X - Line[i - 1].X},
+      DY {(dbl)Line[i + 1].Y - Line[i - 1].Y},
+      Len {hypot(DX, DY)};
+
+    if (!(Len > 0))
+      continue;
+
+    /* Only source line may be at separation distance from seed */
+    INT PX, PY;
+    const UINT32 Parent {GetCell(Line[i].X, Line[i].Y, PX, PY) ? Cells[(size_t)PY * GridW + PX].load(std::memory_order_relaxed) : Empty};
+
+    Path = 0;
+    for (const dbl Side : {1.0, -1.0})
+    {
+      const coordd Seed {Line[i].X - DY / Len * Separation * Side, Line[i].Y + DX / Len * Separation * Side};
+      INT CX, CY;
+
+      Stats.Candidates++;
+      if (!GetCell(Seed.X, Seed.Y, CX, CY) || IsOccupied(CX, CY, 2, Parent == Exempt ? Empty : Parent, true))
+        continue;
+
+      /* Seed cell is taken immediately, so next candidates keep distance from it */
+      const UINT32 Id {NewLine()};
+
+      Cells[(size_t)CY * GridW + CX].store(Id, std::memory_order_relaxed);
+      Seeds.emplace_back(Seed, Id);
+      Found++;
+    }
+  }
+
+  Stats.Seeds += Found;
+  return Found;
+} /* End of 'line_spacing::FindSeeds' function */
+
+/* Uniform angular and evenly spaced lines seeding comparison benchmark function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Tracing region corners:
+ *       const coordd &Min, &Max;
+ *   - Lines per unit charge:
+ *       dbl LinesPerCharge;
+ *   - Line step:
+ *       dbl Step;
+ *   - Separation distance:
+ *       dbl Separation;
+ *   - Line points limit:
+ *       size_t MaxPoints;
+ * RETURNS:
+ *   (std::string) Report.
+ */
+std::string prj::phys::BenchmarkSpacing( const charge_pool &Charges, const coordd &Min, const coordd &Max,
+                                         dbl LinesPerCharge, dbl Step, dbl Separation, size_t MaxPoints )
+{
+  const std::vector<coordd> Nulls {FindNulls(Charges)};
+  const line_environment Env {Charges};
+  UINT64 Freq;
+
+  QueryPerformanceFrequency((LARGE_INTEGER *)&Freq);
+
+  /* Single line sequential tracing inside region (same steps as in evaluation threads) */
+  auto Trace = [&]( const coordd &Start, bool IsBackward, line_spacing *Spacing, UINT32 Id,
+                    std::vector<coordf> &Points ) -> size_t
+    {
+      ef_force_line Line {Start, Step, Charges, Env};
+
+      if (IsBackward)
+        Line.SetBackward();
+      Line.SetBounds(Min, Max);
+      Line.SetNulls(&Nulls, Step * 2);
+
+      Points.assign(1, coordf {(flt)Start.X, (flt)Start.Y});
+      while (Line.Continue && Points.size() < MaxPoints)
+      {
+        const coordf Pt {Points.emplace_back(Line.Next3())};
+
+        if (Pt.X < Min.X || Pt.Y < Min.Y || Pt.X > Max.X || Pt.Y > Max.Y)
+          break;
+        if (Spacing != nullptr && Line.Continue && !Spacing->Mark(Pt, Id))
+          break;
+      }
+
+      return Line.Steps;
+    };
+
+  /* Seeding strategy run */
+  struct result
+  {
+    size_t Lines {0}, Seeded {0}, Steps {0};
+    dbl Time {0};
+  }; /* end of 'result' structure */
+
+  auto Run = [&]( line_spacing *Spacing ) -> result
+    {
+      result Res {};
+      std::vector<std::vector<coordf>> Lines {};
+      UINT64 Start, End;
+
+      QueryPerformanceCounter((LARGE_INTEGER *)&Start);
+
+      if (Spacing != nullptr)
+        Spacing->Reset(Min, Max, Separation, Step * 0.5, Charges);
+
+      for (const auto &Elm : Charges)
+      {
+        if (Elm.Charge < 0)
+          continue;
+
+        const dbl CntF {round(LinesPerCharge * abs(Elm.Charge))};
+
+        for (size_t i = 0; i < (size_t)CntF; i++)
+        {
+          coordd Base;
+
+          Res.Steps += Trace(SourceContour(Elm, (M_PI * (i << 1)) / CntF, Elm.Size * 2, Base),
+                             false, Spacing, Spacing != nullptr ? Spacing->NewLine() : 0, Lines.emplace_back());
+        }
+      }
+
+      /* Seeding rounds from lines of previous round */
+      for (size_t From = 0; Spacing != nullptr && From < Lines.size();)
+      {
+        std::vector<std::pair<coordd, UINT32>> Seeds {};
+        const size_t To {Lines.size()};
+
+        for (size_t i = From; i < To; i++)
+          Spacing->FindSeeds(Lines[i], Seeds);
+
+        for (const auto &[Seed, Id] : Seeds)
+          for (const bool IsBackward : {false, true})
+            Res.Steps += Trace(Seed, IsBackward, Spacing, Id, Lines.emplace_back());
+
+        Res.Seeded += Seeds.size();
+        From = To;
+      }
+
+      QueryPerformanceCounter((LARGE_INTEGER *)&End);
+
+      Res.Lines = Lines.size() - Res.Seeded;
+      Res.Time = (End - Start) * 1000.0 / Freq;
+      return Res;
+    };
+
+  line_spacing Spacing {};
+  const result
+    Uniform {Run(nullptr)},
+    Even {Run(&Spacing)};
+  CHAR Buf[0x200];
+
+  sprintf(Buf,
+          "Force lines seeding (%zu charges, separation %.3f):\n"
+          "  - Uniform angular: %zu lines, %zu steps, %.2f ms\n"
+          "  - Evenly spaced: %zu lines (%zu seeded), %zu steps (%.0f%% of uniform), %.2f ms\n",
+          Charges.Size(), Separation,
+          Uniform.Lines, Uniform.Steps, Uniform.Time,
+          Even.Lines, Even.Seeded, Even.Steps, Uniform.Steps == 0 ? 0.0 : Even.Steps * 100.0 / Uniform.Steps, Even.Time);
+
+  return Buf;
+} /* End of 'prj::phys::BenchmarkSpacing' function */
+
+/* END OF 'ef_spacing.cpp' FILE */
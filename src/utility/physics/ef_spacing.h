@@ -0,0 +1,175 @@
+/* FILE NAME   : 'ef_spacing.h'
+ * PURPOSE     : Physics module.
+ *               Evenly spaced force lines occupancy grid handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#ifndef __ef_spacing_h__
+#define __ef_spacing_h__
+
+#include "ef_charges.h"
+
+/* Project namespace // Physics module */
+namespace prj::phys
+{
+  /* Evenly spaced force lines (Jobard-Lefer) occupancy grid.
+   * Grid cell is third of separation distance, every traced point marks its cell with line identifier
+   * and line is terminated when other line marks neighbour cell. Seeds are placed at separation distance
+   * aside existing lines where no other line is closer. Cells around charges are exempt, all lines converge there.
+   * Marking is lock-free, so lines are traced in parallel.
+   */
+  class line_spacing
+  {
+  public:
+    /* Seeding statistics structure */
+    struct stats
+    {
+      size_t
+        Candidates {0}, /* Tested seed positions */
+        Seeds {0};      /* Accepted seeds */
+    }; /* end of 'stats' structure */
+
+  private:
+    /* Empty and exempt (charge neighbourhood) cell values */
+    static constexpr UINT32 Empty {0}, Exempt {0xFFFFFFFF};
+
+    /* Maximal grid size along each axis */
+    static constexpr INT MaxGridSize {1024};
+
+    /* Grid origin, cell size inverse and separation distance */
+    dbl MinX {0}, MinY {0}, RevCellSize {1}, Separation {1};
+
+    /* Grid size and cells (line identifiers) */
+    INT GridW {0}, GridH {0};
+    std::unique_ptr<std::atomic<UINT32>[]> Cells {};
+
+    /* Last given line identifier */
+    UINT32 LastId {0};
+
+    /* Statistics */
+    stats Stats {};
+
+    /* Cell of point getting function.
+     * ARGUMENTS:
+     *   - Point:
+     *       dbl X, Y;
+     *   - Cell indices (out):
+     *       INT &CX, &CY;
+     * RETURNS:
+     *   (bool) true if point is inside grid.
+     */
+    bool GetCell( dbl X, dbl Y, INT &CX, INT &CY ) const
+    {
+      CX = (INT)floor((X - MinX) * RevCellSize), CY = (INT)floor((Y - MinY) * RevCellSize);
+
+      return CX >= 0 && CY >= 0 && CX < GridW && CY < GridH;
+    } /* End of 'GetCell' function */
+
+    /* Other lines in cell neighbourhood check function.
+     * ARGUMENTS:
+     *   - Cell indices:
+     *       INT CX, CY;
+     *   - Neighbourhood radius (in cells):
+     *       INT Radius;
+     *   - Line identifier (its own cells are skipped):
+     *       UINT32 Id;
+     *   - Exempt cells are treated as occupied flag:
+     *       bool IsExemptOccupied;
+     * RETURNS:
+     *   (bool) true if other line is near.
+     */
+    bool IsOccupied( INT CX, INT CY, INT Radius, UINT32 Id, bool IsExemptOccupied ) const;
+
+  public:
+    /* Grid resetting function.
+     * ARGUMENTS:
+     *   - Grid region corners:
+     *       const coordd &Min, &Max;
+     *   - Separation distance between lines:
+     *       dbl NewSeparation;
+     *   - Minimal cell size (lines with longer steps leave gaps in grid):
+     *       dbl MinCellSize;
+     *   - Charges pool:
+     *       const charge_pool &Charges;
+     */
+    void Reset( const coordd &Min, const coordd &Max, dbl NewSeparation, dbl MinCellSize, const charge_pool &Charges );
+
+    /* New line identifier getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT32) Identifier.
+     */
+    UINT32 NewLine( void )
+    {
+      return ++LastId;
+    } /* End of 'NewLine' function */
+
+    /* Line point marking function (thread safe).
+     * ARGUMENTS:
+     *   - Point:
+     *       const coordf &Pt;
+     *   - Line identifier:
+     *       UINT32 Id;
+     * RETURNS:
+     *   (bool) false if point is too close to other line (line must be terminated).
+     */
+    bool Mark( const coordf &Pt, UINT32 Id );
+
+    /* Seeds aside line searching function (accepted seeds are marked with new line identifiers).
+     * ARGUMENTS:
+     *   - Line points:
+     *       const std::vector<coordf> &Line;
+     *   - Seeds with their lines identifiers (appended):
+     *       std::vector<std::pair<coordd, UINT32>> &Seeds;
+     * RETURNS:
+     *   (size_t) Found seeds count.
+     */
+    size_t FindSeeds( const std::vector<coordf> &Line, std::vector<std::pair<coordd, UINT32>> &Seeds );
+
+    /* Separation distance getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (dbl) Distance.
+     */
+    dbl GetSeparation( void ) const
+    {
+      return Separation;
+    } /* End of 'GetSeparation' function */
+
+    /* Statistics getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const stats &) Statistics.
+     */
+    const stats &GetStats( void ) const
+    {
+      return Stats;
+    } /* End of 'GetStats' function */
+  }; /* end of 'line_spacing' class */
+
+  /* Uniform angular and evenly spaced lines seeding comparison benchmark function.
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Tracing region corners:
+   *       const coordd &Min, &Max;
+   *   - Lines per unit charge:
+   *       dbl LinesPerCharge;
+   *   - Line step:
+   *       dbl Step;
+   *   - Separation distance:
+   *       dbl Separation;
+   *   - Line points limit:
+   *       size_t MaxPoints;
+   * RETURNS:
+   *   (std::string) Report.
+   */
+  std::string BenchmarkSpacing( const charge_pool &Charges, const coordd &Min, const coordd &Max,
+                                dbl LinesPerCharge, dbl Step, dbl Separation, size_t MaxPoints );
+} /* end of 'prj::phys' namespace */
+
+#endif /* __ef_spacing_h__ */
+
+/* END OF 'ef_spacing.h' FILE */
@@ -0,0 +1,290 @@
+/* FILE NAME   : 'ef_symmetry.cpp'
+ * PURPOSE     : Physics module.
+ *               Charges set symmetry detection and lines replication implementation file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#include <pch.h>
+
+#include "ef_symmetry.h"
+#include "ef_seeding.h"
+
+using namespace prj::phys;
+
+/* Charges set exact symmetries (rotations and reflections mapping every charge to equal one) searching function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Position tolerance:
+ *       dbl Tolerance;
+ * RETURNS:
+ *   (symmetry) Symmetry group.
+ */
+symmetry prj::phys::FindSymmetry( const charge_pool &Charges, dbl Tolerance )
+{
+  /* Maximal tested rotational symmetry order */
+  constexpr INT MaxRotations {12};
+
+  symmetry Res {};
+  std::vector<const charge *> Pool {};
+
+  /* Extended sources images are not matched (their shapes break point charges symmetries) */
+  if (Charges.IsEmpty() || std::any_of(Charges.begin(), Charges.end(), IsExtended))
+    return Res;
+
+  /* Every symmetry keeps charges centroid */
+  Pool.reserve(Charges.Size());
+  for (const auto &Elm : Charges)
+  {
+    Pool.push_back(&Elm);
+    Res.Center.X += Elm.Coord.X, Res.Center.Y += Elm.Coord.Y;
+  }
+  Res.Center.X /= Pool.size(), Res.Center.Y /= Pool.size();
+
+  /* Charges sorted by X coordinate for image searching */
+  std::vector<size_t> Order(Pool.size());
+
+  std::iota(Order.begin(), Order.end(), 0);
+  std::sort(Order.begin(), Order.end(), [&]( size_t A, size_t B ){ return Pool[A]->Coord.X < Pool[B]->Coord.X; });
+
+  /* Transformation check: every charge image must be equal charge */
+  auto Match = [&]( const isometry &Elm, std::vector<size_t> &Images ) -> bool
+    {
+      Images.resize(Pool.size());
+      for (size_t i = 0; i < Pool.size(); i++)
+      {
+        const coordd P {Elm.Apply(Pool[i]->Coord, Res.Center)};
+        auto It {std::lower_bound(Order.begin(), Order.end(), P.X - Tolerance,
+                                  [&]( size_t A, dbl X ){ return Pool[A]->Coord.X < X; })};
+        bool IsFound {false};
+
+        for (; It != Order.end() && Pool[*It]->Coord.X <= P.X + Tolerance; It++)
+        {
+          const charge &Image {*Pool[*It]};
+
+          if (abs(Image.Coord.Y - P.Y) <= Tolerance && abs(Image.Size - Pool[i]->Size) <= Tolerance &&
+              abs(Image.Charge - Pool[i]->Charge) <= abs(Pool[i]->Charge) * 1e-6)
+          {
+            Images[i] = *It;
+            IsFound = true;
+            break;
+          }
+        }
+
+        if (!IsFound)
+          return false;
+      }
+
+      return true;
+    };
+
+  std::vector<size_t> Images {};
+
+  /* Rotations form cyclic group, so maximal order is searched */
+  for (INT n = MaxRotations; n > 1; n--)
+    if (Match(isometry {2 * M_PI / n}, Images))
+    {
+      Res.Rotations = n;
+      break;
+    }
+
+  /* Mirror axis candidates: axes mapping farthest charge to equal charge at same distance */
+  const charge *Far {Pool[0]};
+  dbl FarDist {0};
+
+  for (const auto *Elm : Pool)
+    if (const dbl Dist {hypot(Elm->Coord.X - Res.Center.X, Elm->Coord.Y - Res.Center.Y)}; Dist > FarDist)
+      Far = Elm, FarDist = Dist;
+
+  std::vector<dbl> Axes {};
+
+  if (FarDist <= Tolerance)
+    Axes.push_back(0);
+  else
+  {
+    const dbl FarAngle {atan2(Far->Coord.Y - Res.Center.Y, Far->Coord.X - Res.Center.X)};
+
+    for (const auto *Elm : Pool)
+      if (Elm->Charge == Far->Charge &&
+          abs(hypot(Elm->Coord.X - Res.Center.X, Elm->Coord.Y - Res.Center.Y) - FarDist) <= Tolerance)
+        Axes.push_back((FarAngle + atan2(Elm->Coord.Y - Res.Center.Y, Elm->Coord.X - Res.Center.X)) * 0.5);
+  }
+
+  dbl Axis {0};
+
+  for (const dbl Angle : Axes)
+    if (Match(isometry {Angle, true}, Images))
+    {
+      Res.HasReflections = true;
+      Axis = fmod(fmod(Angle, M_PI / Res.Rotations) + M_PI / Res.Rotations, M_PI / Res.Rotations);
+      break;
+    }
+
+  if (Res.Rotations == 1 && !Res.HasReflections)
+    return Res;
+
+  /* Group elements: rotations (identity first), then reflections */
+  for (INT k = 0; k < Res.Rotations; k++)
+    Res.Elements.push_back(isometry {2 * M_PI * k / Res.Rotations});
+  if (Res.HasReflections)
+    for (INT k = 0; k < Res.Rotations; k++)
+      Res.Elements.push_back(isometry {Axis + M_PI * k / Res.Rotations, true});
+
+  for (const auto &Elm : Res.Elements)
+    if (!Match(Elm, Res.Images.emplace_back()))
+    {
+      /* Tolerance accumulated over composed elements - group is dropped */
+      Res.Elements.clear(), Res.Images.clear();
+      Res.Rotations = 1, Res.HasReflections = false;
+      break;
+    }
+
+  return Res;
+} /* End of 'prj::phys::FindSymmetry' function */
+
+/* Symmetric scene seed angles placement function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Symmetry group:
+ *       const symmetry &Symmetry;
+ *   - Seeds count for every charge (in pool order):
+ *       std::span<const size_t> Counts;
+ *   - Flux weighted placement flag:
+ *       bool IsFluxWeighted;
+ * RETURNS:
+ *   (std::vector<std::vector<dbl>>) Seed angles to trace for every charge.
+ */
+std::vector<std::vector<dbl>> prj::phys::SymmetricSeedAngles( const charge_pool &Charges, const symmetry &Symmetry,
+                                                              std::span<const size_t> Counts, bool IsFluxWeighted )
+{
+  if (Symmetry.GetOrder() == 1)
+    return SeedAngles(Charges, Counts, IsFluxWeighted);
+
+  const size_t N {Charges.Size()};
+  std::vector<size_t> SymCounts(N, 0);
+  std::vector<dbl> Offsets(N, 0), Sectors(N, 0);
+  std::vector<bool> IsClosed(N, false);
+
+  for (size_t i = 0; i < N && i < Counts.size(); i++)
+  {
+    INT Rotations {0};
+    const isometry *Mirror {nullptr};
+    bool IsRepresentative {true};
+
+    /* Orbit is seeded on its first charge, stabilizer keeps charge in place */
+    for (size_t k = 0; k < Symmetry.Elements.size(); k++)
+    {
+      IsRepresentative &= Symmetry.Images[k][i] >= i;
+      if (Symmetry.Images[k][i] == i)
+      {
+        if (!Symmetry.Elements[k].IsReflection)
+          Rotations++;
+        else if (Mirror == nullptr)
+          Mirror = &Symmetry.Elements[k];
+      }
+    }
+
+    if (!IsRepresentative)
+      continue;
+
+    /* Seeds set is invariant if count is multiple of stabilizer rotations and starts on mirror axis */
+    SymCounts[i] = (Counts[i] + Rotations - 1) / Rotations * Rotations;
+    Offsets[i] = Mirror != nullptr ? Mirror->Angle : 0;
+    Sectors[i] = Mirror != nullptr ? M_PI / Rotations : 2 * M_PI / Rotations;
+    IsClosed[i] = Mirror != nullptr;
+  }
+
+  auto Angles {SeedAngles(Charges, SymCounts, IsFluxWeighted, Offsets)};
+
+  /* Only fundamental sector seeds are traced (seeds on mirror axes are traced too, their images coincide) */
+  constexpr dbl Threshold {1e-9};
+
+  for (size_t i = 0; i < N; i++)
+    std::erase_if(Angles[i], [&]( dbl Angle )
+      {
+        const dbl Local {fmod(fmod(Angle - Offsets[i], 2 * M_PI) + 2 * M_PI + Threshold, 2 * M_PI) - Threshold};
+
+        return IsClosed[i] ? Local > Sectors[i] + Threshold : Local > Sectors[i] - Threshold;
+      });
+
+  return Angles;
+} /* End of 'prj::phys::SymmetricSeedAngles' function */
+
+/* Traced fundamental domain lines replication to all charges function.
+ * ARGUMENTS:
+ *   - Charges pool:
+ *       const charge_pool &Charges;
+ *   - Charges lines (lines are appended):
+ *       charge_lines &Lines;
+ *   - Symmetry group:
+ *       const symmetry &Symmetry;
+ * RETURNS:
+ *   (size_t) Added lines count.
+ */
+size_t prj::phys::ReplicateLines( const charge_pool &Charges, charge_lines &Lines, const symmetry &Symmetry )
+{
+  /* Line images with closer seed angles are same line */
+  constexpr dbl AngleThreshold {1e-6};
+
+  if (Symmetry.GetOrder() == 1)
+    return 0;
+
+  std::vector<std::vector<std::vector<coordf>> *> Pool {};
+  std::vector<size_t> Traced {};
+
+  for (size_t i = 0; i < Charges.Size(); i++)
+  {
+    Pool.push_back(&Lines[Charges.Handle(i)]);
+    Traced.push_back(Pool.back()->size());
+  }
+
+  /* Seed angles of lines already stored for every charge */
+  std::vector<std::vector<dbl>> Present(Pool.size());
+  size_t Added {0};
+
+  for (size_t i = 0; i < Pool.size(); i++)
+    for (size_t l = 0; l < Traced[i]; l++)
+    {
+      /* Line starts with charge center and seed */
+      const std::vector<coordf> Line {(*Pool[i])[l]};
+
+      if (Line.size() < 2)
+        continue;
+
+      const dbl Angle {atan2(Line[1].Y - Charges[i].Coord.Y, Line[1].X - Charges[i].Coord.X)};
+
+      for (size_t k = 0; k < Symmetry.Elements.size(); k++)
+      {
+        const isometry &Elm {Symmetry.Elements[k]};
+        const size_t Target {Symmetry.Images[k][i]};
+        const dbl Image {Elm.ApplyAngle(Angle)};
+
+        if (std::any_of(Present[Target].begin(), Present[Target].end(),
+                        [&]( dbl A ){ return abs(remainder(A - Image, 2 * M_PI)) < AngleThreshold; }))
+          continue;
+        Present[Target].push_back(Image);
+
+        /* Identity image is traced line itself */
+        if (k == 0)
+          continue;
+
+        auto &Res {Pool[Target]->emplace_back()};
+
+        Res.reserve(Line.size());
+        for (const auto &Pt : Line)
+        {
+          const coordd P {Elm.Apply({Pt.X, Pt.Y}, Symmetry.Center)};
+
+          Res.push_back(coordf {(flt)P.X, (flt)P.Y});
+        }
+        Added++;
+      }
+    }
+
+  return Added;
+} /* End of 'prj::phys::ReplicateLines' function */
+
+/* END OF 'ef_symmetry.cpp' FILE */
@@ -0,0 +1,136 @@
+/* FILE NAME   : 'ef_symmetry.h'
+ * PURPOSE     : Physics module.
+ *               Charges set symmetry detection and lines replication handle file.
+ * PROGRAMMER  : Fedor Borodulin.
+ * LAST UPDATE : 19.10.2026.
+ * NOTE        : Module namespace 'prj::phys'.
+ */
+
+#ifndef __ef_symmetry_h__
+#define __ef_symmetry_h__
+
+#include "ef_charges.h"
+
+/* Project namespace // Physics module */
+namespace prj::phys
+{
+  /* Plane isometry around symmetry center (rotation or reflection) */
+  struct isometry
+  {
+    dbl Angle;          /* Rotation angle or reflection axis angle */
+    bool IsReflection;  /* Reflection flag */
+    dbl M[2][2];        /* Linear part */
+
+    /* Default constructor.
+     * ARGUMENTS:
+     *   - Rotation angle or reflection axis angle:
+     *       dbl NewAngle;
+     *   - Reflection flag:
+     *       bool NewIsReflection;
+     */
+    isometry( dbl NewAngle = 0, bool NewIsReflection = false ) :
+      Angle {NewAngle}, IsReflection {NewIsReflection}
+    {
+      const dbl
+        C {cos(IsReflection ? Angle * 2 : Angle)},
+        S {sin(IsReflection ? Angle * 2 : Angle)};
+
+      M[0][0] = C, M[0][1] = IsReflection ? S : -S;
+      M[1][0] = S, M[1][1] = IsReflection ? -C : C;
+    } /* End of constructor */
+
+    /* Point transformation function.
+     * ARGUMENTS:
+     *   - Point:
+     *       const coordd &P;
+     *   - Symmetry center:
+     *       const coordd &Center;
+     * RETURNS:
+     *   (coordd) Transformed point.
+     */
+    coordd Apply( const coordd &P, const coordd &Center ) const
+    {
+      const dbl X {P.X - Center.X}, Y {P.Y - Center.Y};
+
+      return {Center.X + M[0][0] * X + M[0][1] * Y, Center.Y + M[1][0] * X + M[1][1] * Y};
+    } /* End of 'Apply' function */
+
+    /* Direction angle transformation function.
+     * ARGUMENTS:
+     *   - Angle:
+     *       dbl Dir;
+     * RETURNS:
+     *   (dbl) Transformed angle.
+     */
+    dbl ApplyAngle( dbl Dir ) const
+    {
+      return IsReflection ? Angle * 2 - Dir : Angle + Dir;
+    } /* End of 'ApplyAngle' function */
+  }; /* end of 'isometry' structure */
+
+  /* Charges set symmetry group (cyclic or dihedral around charges centroid) */
+  struct symmetry
+  {
+    coordd Center {0, 0};                       /* Symmetry center */
+    INT Rotations {1};                          /* Rotational symmetry order */
+    bool HasReflections {false};                /* Mirror symmetry flag */
+    std::vector<isometry> Elements {};          /* Group elements (identity is first) */
+    std::vector<std::vector<size_t>> Images {}; /* Charge indices (in pool order) images by every element */
+
+    /* Group order getting function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (size_t) Elements count (1 for trivial group).
+     */
+    size_t GetOrder( void ) const
+    {
+      return std::max<size_t>(Elements.size(), 1);
+    } /* End of 'GetOrder' function */
+  }; /* end of 'symmetry' structure */
+
+  /* Charges set exact symmetries (rotations and reflections mapping every charge to equal one) searching function.
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Position tolerance:
+   *       dbl Tolerance;
+   * RETURNS:
+   *   (symmetry) Symmetry group.
+   */
+  symmetry FindSymmetry( const charge_pool &Charges, dbl Tolerance );
+
+  /* Symmetric scene seed angles placement function.
+   * Every charges orbit is seeded only on its first charge, only in fundamental sector of its stabilizer
+   * (seeds count is rounded up to be invariant under stabilizer rotations).
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Symmetry group:
+   *       const symmetry &Symmetry;
+   *   - Seeds count for every charge (in pool order):
+   *       std::span<const size_t> Counts;
+   *   - Flux weighted placement flag:
+   *       bool IsFluxWeighted;
+   * RETURNS:
+   *   (std::vector<std::vector<dbl>>) Seed angles to trace for every charge.
+   */
+  std::vector<std::vector<dbl>> SymmetricSeedAngles( const charge_pool &Charges, const symmetry &Symmetry,
+                                                     std::span<const size_t> Counts, bool IsFluxWeighted );
+
+  /* Traced fundamental domain lines replication to all charges function.
+   * ARGUMENTS:
+   *   - Charges pool:
+   *       const charge_pool &Charges;
+   *   - Charges lines (lines are appended):
+   *       charge_lines &Lines;
+   *   - Symmetry group:
+   *       const symmetry &Symmetry;
+   * RETURNS:
+   *   (size_t) Added lines count.
+   */
+  size_t ReplicateLines( const charge_pool &Charges, charge_lines &Lines, const symmetry &Symmetry );
+} /* end of 'prj::phys' namespace */
+
+#endif /* __ef_symmetry_h__ */
+
+/* END OF 'ef_symmetry.h' FILE */
@@ -2,7 +2,7 @@
  * PURPOSE     : Physics module.
  *               Basic definitions handle file.
  * PROGRAMMER  : Fedor Borodulin.
- * LAST UPDATE : 07.04.2023.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : Module namespace 'prj::phys'.
  */
 
@@ -14,12 +14,36 @@
 /* Project namespace // Physics module */
 namespace prj::phys
 {
-  /* Electric charge data structure */
+  /* Charge source shapes enum */
+  enum class source_type : UINT
+  {
+    Point,   /* Point charge */
+    Segment, /* Uniformly charged line segment (centered in charge coordinate) */
+    Arc,     /* Uniformly charged circle arc (circle is centered in charge coordinate) */
+    Disk,    /* Uniformly charged disk (centered in charge coordinate) */
+    Dipole,     /* Ideal point dipole (charge is dipole moment along angle direction) */
+    Quadrupole, /* Ideal linear quadrupole (+q, -2q, +q along angle direction, charge is moment 2qd^2) */
+  }; /* end of 'source_type' enum */
+
+  /* Continuous charge source shape (see 'ef_sources.h') */
+  struct source_shape
+  {
+    source_type Type {source_type::Point};
+    dbl Extent {0}; /* Segment half length, arc or disk radius */
+    dbl Angle {0};  /* Segment, arc middle or multipole axis direction angle */
+    dbl Sweep {0};  /* Arc half angle */
+
+    /* Shapes comparison function */
+    bool operator==( const source_shape &Other ) const = default;
+  }; /* end of 'source_shape' structure */
+
+  /* Electric charge data structure (extended sources have total charge and size is their half thickness,
+   * multipoles have moment and size is their drawn radius) */
   struct charge
   {
     coordd Coord;
     dbl Charge, Size;
-    std::vector<std::vector<coordf>> Lines {};
+    source_shape Shape {};
   }; /* end of 'charge' structure */
 } /* end of 'prj::phys' namespace */
 
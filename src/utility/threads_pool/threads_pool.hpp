@@ -1,7 +1,7 @@
 /* FILE NAME   : 'threads_pool.hpp'
  * PURPOSE     : Threads pool control class implementation file.
  * PROGRAMMER  : Fedor Borodulin.
- * LAST UPDATE : 07.04.2023.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : Module namespace 'prj'.
  */
 
@@ -20,14 +20,27 @@ namespace prj::util
       static_assert(task_batch > 0, "Cannot use batch size less or equal zero!");
 
     private:
+      /* Task storage structure */
+      struct task
+      {
+        task_data Data;
+        flt Priority {0};
+        std::atomic_bool Done {false};
+
+        /* Constructor from task data constructor arguments */
+        template<typename ...args>
+          task( args &&...Args ) : Data {std::forward<args>(Args)...}
+          { }
+      }; /* end of 'task' structure */
+
       /* Storage of tasks data */
-      std::list<task_data> TaskPool {};
+      std::list<task> TaskPool {};
 
       /* Thread storage structure */
       struct thread
       {
         std::thread ThreadHandle;
-        std::list<task_data *> Tasks;
+        std::list<task *> Tasks;
         bool RunFlag = true;
       }; /* end of 'thread' structure */
 
@@ -37,6 +50,12 @@ namespace prj::util
       /* Pause flag */
       bool PauseFlag = true;
 
+      /* Count of threads which still have unfinished tasks */
+      std::atomic_size_t WorkingThreads {0};
+
+      /* Last run threads count (0 <=> auto) */
+      size_t RunThreads {0};
+
       /* Task function */
       std::function<bool( task_data * )> ThreadFunction {};
 
@@ -65,7 +84,9 @@ namespace prj::util
         ThreadFunction = ThreadFunc;
       } /* End of 'SetFunction' function */
 
-      /* Task running function
+      /* Task running function.
+       * Unfinished tasks are distributed in priority order, every thread
+       * processes only its highest priority tasks until they are finished.
        * ARGUMENTS:
        *    - Avalible threads count (default: 0 <=> auto):
        *        size_t Threads;
@@ -79,6 +100,8 @@ namespace prj::util
         /* Pause all previous */
         Pause();
 
+        RunThreads = Threads;
+
         /* Auto evaluation */
         if (Threads == 0)
           Threads = std::max<long long>((long long)(std::thread::hardware_concurrency() >> 1),
@@ -86,47 +109,60 @@ namespace prj::util
         else
           Threads = std::clamp<size_t>(Threads, 1, std::thread::hardware_concurrency() << 1);
 
+        /* Unfinished tasks in priority order (insertion order for equal priorities) */
+        std::vector<task *> Order {};
+
+        for (auto &Elm : TaskPool)
+          if (!Elm.Done)
+            Order.push_back(&Elm);
+
+        std::stable_sort(Order.begin(), Order.end(), []( const task *A, const task *B ) -> bool
+          {
+            return A->Priority > B->Priority;
+          });
+
         /* Auxilary checks */
-        if (TaskPool.empty())
+        if (Order.empty())
+        {
+          WorkingThreads.store(0);
+          PauseFlag = false;
           return;
+        }
 
-        Threads = std::min(Threads, TaskPool.size());
+        Threads = std::min(Threads, Order.size());
 
         /* Run threads */
         {
-          const size_t
-            TasksPerThread {TaskPool.size() / Threads},
-            TasksPerThreadOverhead {TaskPool.size() % Threads};
-
-          auto TaskIt {TaskPool.begin()};
-
           /* Thread function temporary copy */
           const auto ThreadFunction {this->ThreadFunction};
+          auto *WorkingThreads {&this->WorkingThreads};
 
-          for (size_t i {0}, made_tasks {0}; i < Threads; i++)
-          {
-            const size_t Tasks {TasksPerThread + (size_t)(i < TasksPerThreadOverhead)};
+          WorkingThreads->store(Threads);
 
+          for (size_t i {0}; i < Threads; i++)
+          {
             auto *ThreadData {&ThreadsPool.emplace_back()};
 
-            for (size_t j {0}; j < Tasks; j++, ++TaskIt)
-              ThreadData->Tasks.push_back(&TaskIt._Ptr->_Myval);
+            /* Tasks are dealt round-robin, so every thread gets equal part of each priority */
+            for (size_t j {i}; j < Order.size(); j += Threads)
+              ThreadData->Tasks.push_back(Order[j]);
 
-            ThreadData->ThreadHandle = std::move(std::thread {[ThreadData, ThreadFunction]( void ) -> int
+            ThreadData->ThreadHandle = std::move(std::thread {[ThreadData, ThreadFunction, WorkingThreads]( void ) -> int
             {
               /* Tasks mainloop */
               while (ThreadData->RunFlag &&
                      !ThreadData->Tasks.empty())
               {
                 for (auto Task {ThreadData->Tasks.begin()};
-                     Task != ThreadData->Tasks.end();)
+                     Task != ThreadData->Tasks.end() &&
+                     (*Task)->Priority >= ThreadData->Tasks.front()->Priority;)
                 {
                   size_t Cnt {task_batch - 1};
                   bool EndTask {false};
 
                   do
                   {
-                    bool FinishedTask = ThreadFunction(*Task);
+                    bool FinishedTask = ThreadFunction(&(*Task)->Data);
 
                     if (FinishedTask)
                     {
@@ -139,6 +175,8 @@ namespace prj::util
                   {
                     auto Old {Task};
 
+                    (*Task)->Done = true;
+
                     ++Task;
                     ThreadData->Tasks.erase(Old);
                   }
@@ -149,6 +187,10 @@ namespace prj::util
                 Sleep(0);
               }
 
+              /* Report all thread tasks are done */
+              if (ThreadData->Tasks.empty())
+                WorkingThreads->fetch_sub(1);
+
               return 0;
             }});
           }
@@ -171,13 +213,66 @@ namespace prj::util
           {
             auto &Elm {ThreadsPool.front()};
 
-            Elm.ThreadHandle.join();
+            if (Elm.ThreadHandle.joinable())
+              Elm.ThreadHandle.join();
 
             ThreadsPool.pop_front();
           }
         }
       } /* End of 'Pause' function */
 
+      /* Tasks finishing check function.
+       * RETURNS:
+       *   (bool) true if pool was run and all its tasks are finished.
+       */
+      bool IsDone( void ) const
+      {
+        return !PauseFlag && WorkingThreads.load() == 0;
+      } /* End of 'IsDone' function */
+
+      /* All running tasks finishing waiting function */
+      void Wait( void )
+      {
+        for (auto &Elm : ThreadsPool)
+          if (Elm.ThreadHandle.joinable())
+            Elm.ThreadHandle.join();
+      } /* End of 'Wait' function */
+
+      /* Tasks priorities updating function.
+       * Running pool is restarted with new tasks order only if some unfinished task priority changed.
+       * ARGUMENTS:
+       *   - Task priority evaluation function (greater are processed first):
+       *       const std::function<flt( const task_data & )> &Priority;
+       * RETURNS:
+       *   (bool) true if priorities were changed.
+       */
+      bool SetPriorities( const std::function<flt( const task_data & )> &Priority )
+      {
+        bool IsChanged {false};
+
+        for (auto &Elm : TaskPool)
+          if (!Elm.Done && Elm.Priority != Priority(Elm.Data))
+          {
+            IsChanged = true;
+            break;
+          }
+
+        if (!IsChanged)
+          return false;
+
+        const bool IsRunning {!PauseFlag};
+
+        Pause();
+
+        for (auto &Elm : TaskPool)
+          Elm.Priority = Priority(Elm.Data);
+
+        if (IsRunning)
+          Run(RunThreads);
+
+        return true;
+      } /* End of 'SetPriorities' function */
+
       /* Task termination funciton */
       void Terminate( void )
       {
@@ -2,7 +2,7 @@
  * PURPOSE     : WINAPI module.
  *               Module handle file.
  * PROGRAMMER  : Fedor Borodulin.
- * LAST UPDATE : 10.04.2023.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : Module namespace 'win'.
  */
 
@@ -202,6 +202,29 @@ namespace win
      */
     virtual VOID Idle( VOID ) {}
 
+    /* Idle waiting timeout getting callback.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (DWORD) Milliseconds to wait for messages before next 'Idle' call
+     *           (0 - do not wait, INFINITE - wait for message or wake event).
+     */
+    virtual DWORD IdleTimeout( VOID ) { return 0; }
+
+    /* Idle waiting wake event getting callback.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (HANDLE) Event object which interrupts waiting or NULL.
+     */
+    virtual HANDLE IdleWakeEvent( VOID ) { return NULL; }
+
+    /* Idle waiting finish callback.
+     * ARGUMENTS:
+     *   - Waiting result (WAIT_OBJECT_0 - wake event, WAIT_OBJECT_0 + 1 - message, WAIT_TIMEOUT):
+     *       DWORD WaitResult;
+     * RETURNS: None.
+     */
+    virtual VOID Wakeup( DWORD WaitResult ) {}
+
     /* Background erasion callback.
      * ARGUMENTS:
      *   - Draw context:
@@ -2,7 +2,7 @@
  * PURPOSE     : WINAPI module.
  *               Message crackers realization file.
  * PROGRAMMER  : Fedor Borodulin.
- * LAST UPDATE : 10.04.2023.
+ * LAST UPDATE : 19.10.2026.
  * NOTE        : Module namespace 'win'.
  */
 
@@ -23,24 +23,45 @@ namespace win
 
     while (TRUE)
     {
-      /* Check message at window message queue */
-      if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+      /* Process all messages at window message queue */
+      while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+      {
         if (msg.message == WM_QUIT)
-          break;
-        else
+          return;
+
+        /* Check accelerator translation */
+        if (!TranslateAcceleratorA(msg.hwnd, hMainMenuAccel, &msg))
         {
-          /* Check accelerator translation */
-          if (!TranslateAcceleratorA(msg.hwnd, hMainMenuAccel, &msg))
-          {
-            /* Displatch message to window */
-            TranslateMessage(&msg);
-            DispatchMessage(&msg);
-          }
+          /* Displatch message to window */
+          TranslateMessage(&msg);
+          DispatchMessage(&msg);
         }
-      else
-        Idle();
+
+        /* Input state is polled, so every button press and release must be seen */
+        if ((msg.message >= WM_KEYFIRST && msg.message <= WM_KEYLAST) ||
+            (msg.message >= WM_MOUSEFIRST && msg.message <= WM_MOUSELAST && msg.message != WM_MOUSEMOVE))
+          Idle();
+      }
+
+      Idle();
+
+      /* Sleep until message, wake event or timeout */
+      const HANDLE hWakeEvent {IdleWakeEvent()};
+      const DWORD Timeout {IdleTimeout()};
+
+      if (Timeout != 0)
+      {
+        DWORD WaitResult {MsgWaitForMultipleObjectsEx(hWakeEvent != NULL, &hWakeEvent, Timeout,
+                                                      QS_ALLINPUT, MWMO_INPUTAVAILABLE)};
+
+        /* Without wake event message arrival is reported as first object */
+        if (hWakeEvent == NULL && WaitResult == WAIT_OBJECT_0)
+          WaitResult = WAIT_OBJECT_0 + 1;
+
+        Wakeup(WaitResult);
+      }
     }
-  }
+  } /* End of 'win::Run' function */
 
   /* WM_CREATE window message handle function.
    * ARGUMENTS:
@@ -134,8 +155,8 @@ namespace win
   {
     if (!IsInit)
     {
+      /* Initialization timer is single-shot, all next frames are scheduled by 'IdleTimeout' */
       KillTimer(hWnd, Id);
-      SetTimer(hWnd, 47, 1, nullptr);
 
       IsInit = TRUE;
 